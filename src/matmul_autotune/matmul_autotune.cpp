@@ -0,0 +1,174 @@
+#include <tt-metalium/host_api.hpp>
+#include <tt-metalium/constants.hpp>
+#include <tt-metalium/bfloat16.hpp>
+#include <tt-metalium/tilize_utils.hpp>
+#include <tt-metalium/device.hpp>
+#include <tt-metalium/tt_metal.hpp>
+#include <tt-metalium/tensor_accessor_args.hpp>
+#include <tt-metalium/distributed.hpp>
+#include <bmm_op.hpp>
+#include <bmm_autotune.hpp>
+#include <fmt/core.h>
+
+using namespace tt::constants;
+using namespace std;
+using namespace tt;
+using namespace tt::tt_metal;
+
+void golden_matmul(
+    std::vector<bfloat16>& a, std::vector<bfloat16>& b, std::vector<bfloat16>& output, uint32_t M, uint32_t N, uint32_t K) {
+    for (uint32_t i = 0; i < M; i++) {
+        for (uint32_t j = 0; j < N; j++) {
+            float c_f = 0;
+            for (uint32_t k = 0; k < K; k++) {
+                c_f += static_cast<float>(a[i * K + k]) * static_cast<float>(b[k * N + j]);
+            }
+            output.at(i * N + j) = bfloat16(c_f);
+        }
+    }
+}
+
+/*
+    matmul block 분할 autotune 예제.
+
+    정사각형이 아닌 shape 하나에 대해 (1) 기존 heuristic (get_large_matmul_params) 분할과
+    (2) autotuner가 찾은 분할의 launch 시간을 비교하고, tune 된 분할로 결과를 검증한다.
+    tune 결과는 cache 파일 (첫 번째 인자, 기본값 matmul_autotune_cache.txt) 에 저장되므로
+    두 번째 실행부터는 benchmark 없이 cache에서 바로 읽는다.
+*/
+int main(int argc, char** argv) {
+    bool pass = true;
+
+    constexpr int device_id = 0;
+    std::shared_ptr<distributed::MeshDevice> mesh_device = distributed::MeshDevice::create_unit_mesh(device_id);
+    distributed::MeshCommandQueue& cq = mesh_device->mesh_command_queue();
+
+    std::string cache_path = argc > 1 ? argv[1] : "matmul_autotune_cache.txt";
+    bmm_op_utils::MatmulTuneCache cache(cache_path);
+    fmt::print(" -- tune cache {}: {} entries --\n", cache.path(), cache.size());
+
+    // 정사각형이 아닌 shape (user-defined)
+    constexpr uint32_t M = 256;
+    constexpr uint32_t N = 2048;
+    constexpr uint32_t K = 512;
+
+    uint32_t Mt = M / TILE_HEIGHT;
+    uint32_t Kt = K / TILE_WIDTH;
+    uint32_t Nt = N / TILE_WIDTH;
+
+    tt::DataFormat data_format = tt::DataFormat::Float16_b;
+    MathFidelity math_fidelity = MathFidelity::HiFi4;
+    uint32_t single_tile_size = tt::tile_size(data_format);
+    auto grid = mesh_device->compute_with_storage_grid_size();
+
+    distributed::DeviceLocalBufferConfig dram_config{
+        .page_size = single_tile_size, .buffer_type = tt_metal::BufferType::DRAM};
+    distributed::ReplicatedBufferConfig buffer_config_A{.size = single_tile_size * Mt * Kt};
+    distributed::ReplicatedBufferConfig buffer_config_B{.size = single_tile_size * Nt * Kt};
+    distributed::ReplicatedBufferConfig buffer_config_C{.size = single_tile_size * Mt * Nt};
+
+    auto src0_dram_buffer = distributed::MeshBuffer::create(buffer_config_A, dram_config, mesh_device.get());
+    auto src1_dram_buffer = distributed::MeshBuffer::create(buffer_config_B, dram_config, mesh_device.get());
+    auto dst_dram_buffer = distributed::MeshBuffer::create(buffer_config_C, dram_config, mesh_device.get());
+
+    std::vector<bfloat16> src0_vec = create_random_vector_of_bfloat16_native(M * K * sizeof(bfloat16), 1, 123, -0.4);
+    std::vector<bfloat16> src1_vec = create_random_vector_of_bfloat16_native(K * N * sizeof(bfloat16), 1, 12522, -0.3);
+
+    std::vector<bfloat16> golden_vec(M * N, 0);
+    golden_matmul(src0_vec, src1_vec, golden_vec, M, N, K);
+
+    distributed::EnqueueWriteMeshBuffer(cq, src0_dram_buffer, tilize_nfaces(src0_vec, M, K), false);
+    distributed::EnqueueWriteMeshBuffer(cq, src1_dram_buffer, tilize_nfaces(src1_vec, K, N), false);
+
+    auto l1_budget = get_matmul_l1_budget(mesh_device.get(), data_format, data_format, data_format, data_format);
+
+    // (1) 기존 heuristic
+    uint32_t in0_block_w = Kt % 2 == 0 ? 2 : 1;
+    auto heuristic_params =
+        bmm_op_utils::get_large_matmul_params(Mt, Nt, grid.y, grid.x, in0_block_w, 8, l1_budget);
+    bmm_op_utils::MatmulBlockConfig heuristic{
+        std::get<0>(heuristic_params),
+        std::get<1>(heuristic_params),
+        in0_block_w,
+        std::get<2>(heuristic_params),
+        std::get<3>(heuristic_params)};
+    double heuristic_us = 0.0;
+    if (heuristic.per_core_M != 0) {
+        heuristic_us = bmm_op_utils::benchmark_matmul_block_config(
+            mesh_device,
+            src0_dram_buffer,
+            src1_dram_buffer,
+            dst_dram_buffer,
+            Mt,
+            Nt,
+            Kt,
+            heuristic,
+            data_format,
+            math_fidelity,
+            1,
+            10);
+    }
+
+    // (2) autotune (cache에 있으면 benchmark 하지 않음)
+    auto tuned = bmm_op_utils::autotune_matmul_block_params(
+        mesh_device, src0_dram_buffer, src1_dram_buffer, dst_dram_buffer, Mt, Nt, Kt, data_format, math_fidelity, cache);
+
+    // 실제 호출 경로는 cache lookup만 한다.
+    auto config = bmm_op_utils::get_tuned_matmul_params(cache, Mt, Nt, Kt, data_format, math_fidelity, grid, l1_budget);
+    TT_FATAL(config == tuned.config, "Tune cache lookup does not match the autotune result");
+
+    fmt::print(
+        " -- heuristic: per_core_M= {} per_core_N= {} in0_block_w= {} subblock= {}x{} -- {:.1f} us --\n",
+        heuristic.per_core_M,
+        heuristic.per_core_N,
+        heuristic.in0_block_w,
+        heuristic.out_subblock_h,
+        heuristic.out_subblock_w,
+        heuristic_us);
+    fmt::print(
+        " -- tuned:     per_core_M= {} per_core_N= {} in0_block_w= {} subblock= {}x{} -- {:.1f} us --\n",
+        config.per_core_M,
+        config.per_core_N,
+        config.in0_block_w,
+        config.out_subblock_h,
+        config.out_subblock_w,
+        tuned.time_us);
+
+    // tune 된 분할로 한 번 더 돌려서 결과를 확인한다.
+    distributed::MeshWorkload workload;
+    distributed::MeshCoordinateRange device_range = distributed::MeshCoordinateRange(mesh_device->shape());
+    workload.add_program(
+        device_range,
+        bmm_op_utils::create_matmul_multicore_reuse_program(
+            src0_dram_buffer,
+            src1_dram_buffer,
+            dst_dram_buffer,
+            Mt,
+            Nt,
+            Kt,
+            1,
+            false,
+            config,
+            data_format,
+            math_fidelity,
+            grid));
+    distributed::EnqueueMeshWorkload(cq, workload, false);
+
+    std::vector<bfloat16> result_vec(M * N);
+    distributed::EnqueueReadMeshBuffer(cq, result_vec, dst_dram_buffer, true);
+    result_vec = untilize_nfaces(result_vec, M, N);
+
+    float pearson = check_bfloat16_vector_pcc(golden_vec, result_vec);
+    fmt::print("Metalium vs Golden -- PCC = {}\n", pearson);
+    TT_FATAL(pearson > 0.99, "PCC not high enough. Result PCC: {}, Expected PCC: 0.99", pearson);
+
+    pass &= mesh_device->close();
+
+    if (pass) {
+        fmt::print("Test Passed!!! - matmul autotune\n");
+    } else {
+        TT_THROW("Test Failed");
+    }
+
+    return 0;
+}
@@ -0,0 +1,170 @@
+#include <chrono>
+#include <tt-metalium/host_api.hpp>
+#include <tt-metalium/constants.hpp>
+#include <tt-metalium/bfloat16.hpp>
+#include <tt-metalium/tilize_utils.hpp>
+#include <tt-metalium/device.hpp>
+#include <tt-metalium/tt_metal.hpp>
+#include <tt-metalium/distributed.hpp>
+#include <bmm_op.hpp>
+#include <bmm_reuse_program.hpp>
+#include <fmt/core.h>
+
+using namespace tt::constants;
+using namespace std;
+using namespace tt;
+using namespace tt::tt_metal;
+
+// batch b: C[b] = A[b] * B[bcast_batch ? 0 : b]
+void golden_batched_matmul(
+    std::vector<bfloat16>& a,
+    std::vector<bfloat16>& b,
+    std::vector<bfloat16>& output,
+    uint32_t batch,
+    bool bcast_batch,
+    uint32_t M,
+    uint32_t N,
+    uint32_t K) {
+    for (uint32_t nb = 0; nb < batch; nb++) {
+        size_t a_offset = (size_t)nb * M * K;
+        size_t b_offset = bcast_batch ? 0 : (size_t)nb * K * N;
+        size_t c_offset = (size_t)nb * M * N;
+        for (uint32_t i = 0; i < M; i++) {
+            for (uint32_t j = 0; j < N; j++) {
+                float c_f = 0;
+                for (uint32_t k = 0; k < K; k++) {
+                    c_f += static_cast<float>(a[a_offset + i * K + k]) * static_cast<float>(b[b_offset + k * N + j]);
+                }
+                output.at(c_offset + i * N + j) = bfloat16(c_f);
+            }
+        }
+    }
+}
+
+/*
+    batched matmul 예제. (attention head 별 Q * K^T)
+
+    matmul_multicore_reuse 는 Mt, Nt 로만 grid를 나누고 batch는 모든 core가 안에서 돈다.
+    head 하나의 행렬이 작으면 (여기서는 4x4 tiles) output block 이 몇 개 안 되어 대부분의 core가 논다.
+    batch_per_core 로 (batch group, output block) 을 core에 나누면 같은 일을 더 많은 core가 나눠서 한다.
+    bcast_batch (모든 head가 같은 B, multi-query attention의 K) 도 같이 확인한다.
+*/
+int main() {
+    bool pass = true;
+
+    constexpr int device_id = 0;
+    std::shared_ptr<distributed::MeshDevice> mesh_device = distributed::MeshDevice::create_unit_mesh(device_id);
+    distributed::MeshCommandQueue& cq = mesh_device->mesh_command_queue();
+
+    constexpr uint32_t B = 32;   // user-defined (heads)
+    constexpr uint32_t M = 128;  // user-defined (sequence)
+    constexpr uint32_t N = 128;  // user-defined (sequence)
+    constexpr uint32_t K = 64;   // user-defined (head dim)
+
+    uint32_t Mt = M / TILE_HEIGHT;
+    uint32_t Kt = K / TILE_WIDTH;
+    uint32_t Nt = N / TILE_WIDTH;
+
+    tt::DataFormat cb_data_format = tt::DataFormat::Float16_b;
+    uint32_t single_tile_size = tt::tile_size(cb_data_format);
+    auto grid = mesh_device->compute_with_storage_grid_size();
+
+    uint32_t in0_block_w = 2;
+    auto matmul_params = bmm_op_utils::get_large_matmul_params(Mt, Nt, grid.y, grid.x, in0_block_w);
+    bmm_op_utils::MatmulBlockConfig config{
+        std::get<0>(matmul_params),
+        std::get<1>(matmul_params),
+        in0_block_w,
+        std::get<2>(matmul_params),
+        std::get<3>(matmul_params)};
+    TT_FATAL(config.per_core_M != 0, "No valid core sizing for Mt = {}, Nt = {}", Mt, Nt);
+
+    uint32_t num_blocks_total = (Mt / config.per_core_M) * (Nt / config.per_core_N);
+    uint32_t batch_per_core = bmm_op_utils::get_matmul_batch_per_core(B, num_blocks_total, grid);
+    fmt::print(
+        " -- {} output blocks per batch, batch_per_core = {} ({} cores) --\n",
+        num_blocks_total,
+        batch_per_core,
+        num_blocks_total * (B / batch_per_core));
+
+    distributed::DeviceLocalBufferConfig dram_config{
+        .page_size = single_tile_size, .buffer_type = tt_metal::BufferType::DRAM};
+    distributed::ReplicatedBufferConfig buffer_config_A{.size = single_tile_size * B * Mt * Kt};
+    distributed::ReplicatedBufferConfig buffer_config_B{.size = single_tile_size * B * Nt * Kt};
+    distributed::ReplicatedBufferConfig buffer_config_C{.size = single_tile_size * B * Mt * Nt};
+
+    auto src0_dram_buffer = distributed::MeshBuffer::create(buffer_config_A, dram_config, mesh_device.get());
+    auto src1_dram_buffer = distributed::MeshBuffer::create(buffer_config_B, dram_config, mesh_device.get());
+    auto dst_dram_buffer = distributed::MeshBuffer::create(buffer_config_C, dram_config, mesh_device.get());
+
+    std::vector<bfloat16> src0_vec =
+        create_random_vector_of_bfloat16_native(B * M * K * sizeof(bfloat16), 1, 123, -0.5);
+    std::vector<bfloat16> src1_vec =
+        create_random_vector_of_bfloat16_native(B * K * N * sizeof(bfloat16), 1, 12522, -0.5);
+    distributed::EnqueueWriteMeshBuffer(cq, src0_dram_buffer, tilize_nfaces(src0_vec, B * M, K), false);
+    // batch 별 B (K x N) 를 이어 붙였으므로 B * K row 로 tilize 해도 batch 경계가 tile 경계와 맞는다.
+    distributed::EnqueueWriteMeshBuffer(cq, src1_dram_buffer, tilize_nfaces(src1_vec, B * K, N), false);
+
+    distributed::MeshCoordinateRange device_range = distributed::MeshCoordinateRange(mesh_device->shape());
+    auto run_case = [&](bool bcast_batch, uint32_t case_batch_per_core, const char* name) {
+        distributed::MeshWorkload workload;
+        workload.add_program(
+            device_range,
+            bmm_op_utils::create_matmul_multicore_reuse_program(
+                src0_dram_buffer,
+                src1_dram_buffer,
+                dst_dram_buffer,
+                Mt,
+                Nt,
+                Kt,
+                B,
+                bcast_batch,
+                config,
+                cb_data_format,
+                MathFidelity::HiFi4,
+                grid,
+                {.batch_per_core = case_batch_per_core}));
+
+        // 첫 launch는 kernel compile 시간이 들어가므로 한 번 돌린 뒤에 잰다.
+        distributed::EnqueueMeshWorkload(cq, workload, false);
+        distributed::Finish(cq);
+        constexpr uint32_t num_iterations = 10;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (uint32_t i = 0; i < num_iterations; i++) {
+            distributed::EnqueueMeshWorkload(cq, workload, false);
+        }
+        distributed::Finish(cq);
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::vector<bfloat16> result_vec(B * M * N);
+        distributed::EnqueueReadMeshBuffer(cq, result_vec, dst_dram_buffer, true);
+        result_vec = untilize_nfaces(result_vec, B * M, N);
+
+        std::vector<bfloat16> golden_vec(B * M * N, 0);
+        golden_batched_matmul(src0_vec, src1_vec, golden_vec, B, bcast_batch, M, N, K);
+        float pearson = check_bfloat16_vector_pcc(golden_vec, result_vec);
+        fmt::print(
+            " -- {}: {:.1f} us per launch, PCC = {} --\n",
+            name,
+            std::chrono::duration<double, std::micro>(end - start).count() / num_iterations,
+            pearson);
+        if (pearson < 0.99f) {
+            fmt::print("PCC not high enough for {}. Result PCC: {}, Expected PCC: 0.99\n", name, pearson);
+            pass = false;
+        }
+    };
+
+    run_case(false, B, "batch looped per core");
+    run_case(false, batch_per_core, "batch spread across cores");
+    run_case(true, batch_per_core, "batch spread across cores, bcast B");
+
+    pass &= mesh_device->close();
+
+    if (pass) {
+        fmt::print("Test Passed!!! - matmul batched\n");
+    } else {
+        TT_THROW("Test Failed");
+    }
+
+    return 0;
+}
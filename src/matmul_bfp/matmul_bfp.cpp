@@ -0,0 +1,173 @@
+#include <random>
+#include <tt-metalium/host_api.hpp>
+#include <tt-metalium/constants.hpp>
+#include <tt-metalium/bfloat16.hpp>
+#include <tt-metalium/tilize_utils.hpp>
+#include <tt-metalium/device.hpp>
+#include <tt-metalium/tt_metal.hpp>
+#include <tt-metalium/distributed.hpp>
+#include <bmm_op.hpp>
+#include <bmm_reuse_program.hpp>
+#include <bmm_autotune.hpp>
+#include <fmt/core.h>
+
+using namespace tt::constants;
+using namespace std;
+using namespace tt;
+using namespace tt::tt_metal;
+
+void golden_matmul(
+    const std::vector<float>& a,
+    const std::vector<float>& b,
+    std::vector<bfloat16>& output,
+    uint32_t M,
+    uint32_t N,
+    uint32_t K) {
+    for (uint32_t i = 0; i < M; i++) {
+        for (uint32_t j = 0; j < N; j++) {
+            float c_f = 0;
+            for (uint32_t k = 0; k < K; k++) {
+                c_f += a[i * K + k] * b[k * N + j];
+            }
+            output.at(i * N + j) = bfloat16(c_f);
+        }
+    }
+}
+
+/*
+    block floating point operand matmul 예제.
+
+    같은 float 입력을 in0 / in1 형식만 Float16_b, Bfp8_b, Bfp4_b 로 바꿔서 matmul_multicore_reuse program으로 계산하고
+    operand bytes, block 분할, 시간, float golden 대비 PCC를 출력한다. output은 모두 Float16_b 이다.
+    tile이 작아지는 만큼 DRAM / NoC에서 옮기는 양이 줄고, 같은 L1에 더 큰 in0_block_w가 들어간다.
+*/
+struct BfpCase {
+    tt::DataFormat data_format;
+    const char* name;
+    float min_pcc;  // Bfp4_b는 mantissa가 3 bit라 기준을 낮춘다.
+};
+
+int main() {
+    bool pass = true;
+
+    constexpr int device_id = 0;
+    std::shared_ptr<distributed::MeshDevice> mesh_device = distributed::MeshDevice::create_unit_mesh(device_id);
+    distributed::MeshCommandQueue& cq = mesh_device->mesh_command_queue();
+
+    constexpr uint32_t M = 640;  // user-defined
+    constexpr uint32_t N = 640;  // user-defined
+    constexpr uint32_t K = 640;  // user-defined
+
+    uint32_t Mt = M / TILE_HEIGHT;
+    uint32_t Kt = K / TILE_WIDTH;
+    uint32_t Nt = N / TILE_WIDTH;
+
+    constexpr tt::DataFormat out_data_format = tt::DataFormat::Float16_b;
+    uint32_t out_single_tile_size = tt::tile_size(out_data_format);
+    auto grid = mesh_device->compute_with_storage_grid_size();
+
+    std::mt19937 rng(123);
+    std::uniform_real_distribution<float> dist(-0.5f, 0.5f);
+    std::vector<float> src0_vec(M * K);
+    std::vector<float> src1_vec(K * N);
+    for (float& v : src0_vec) {
+        v = dist(rng);
+    }
+    for (float& v : src1_vec) {
+        v = dist(rng);
+    }
+
+    std::vector<bfloat16> golden_vec(M * N, 0);
+    golden_matmul(src0_vec, src1_vec, golden_vec, M, N, K);
+
+    std::vector<float> src0_tiles = tilize_nfaces(src0_vec, M, K);
+    std::vector<float> src1_tiles = tilize_nfaces(src1_vec, K, N);
+
+    distributed::DeviceLocalBufferConfig dst_dram_config{
+        .page_size = out_single_tile_size, .buffer_type = tt_metal::BufferType::DRAM};
+    distributed::ReplicatedBufferConfig buffer_config_C{.size = out_single_tile_size * Mt * Nt};
+    auto dst_dram_buffer = distributed::MeshBuffer::create(buffer_config_C, dst_dram_config, mesh_device.get());
+
+    const std::vector<BfpCase> cases = {
+        {tt::DataFormat::Float16_b, "Float16_b", 0.99f},
+        {tt::DataFormat::Bfp8_b, "Bfp8_b", 0.99f},
+        {tt::DataFormat::Bfp4_b, "Bfp4_b", 0.95f},
+    };
+
+    for (const auto& [data_format, name, min_pcc] : cases) {
+        uint32_t single_tile_size = tt::tile_size(data_format);
+        bmm_op_utils::MatmulDataFormats data_formats(data_format, data_format, out_data_format);
+
+        // 작은 tile일수록 L1에 더 큰 K block이 들어간다. Kt를 나누는 가장 큰 in0_block_w를 고른다.
+        auto l1_budget = get_matmul_l1_budget(
+            mesh_device.get(), data_format, data_format, out_data_format, out_data_format);
+        bmm_op_utils::MatmulBlockConfig config;
+        for (uint32_t in0_block_w : {8u, 4u, 2u, 1u}) {
+            if (Kt % in0_block_w != 0) {
+                continue;
+            }
+            auto params = bmm_op_utils::get_large_matmul_params(Mt, Nt, grid.y, grid.x, in0_block_w, 8, l1_budget);
+            if (std::get<0>(params) != 0) {
+                config = {
+                    std::get<0>(params), std::get<1>(params), in0_block_w, std::get<2>(params), std::get<3>(params)};
+                break;
+            }
+        }
+        TT_FATAL(config.per_core_M != 0, "No valid core sizing for Mt = {}, Nt = {} in {}", Mt, Nt, name);
+
+        distributed::DeviceLocalBufferConfig dram_config{
+            .page_size = single_tile_size, .buffer_type = tt_metal::BufferType::DRAM};
+        distributed::ReplicatedBufferConfig buffer_config_A{.size = single_tile_size * Mt * Kt};
+        distributed::ReplicatedBufferConfig buffer_config_B{.size = single_tile_size * Nt * Kt};
+        auto src0_dram_buffer = distributed::MeshBuffer::create(buffer_config_A, dram_config, mesh_device.get());
+        auto src1_dram_buffer = distributed::MeshBuffer::create(buffer_config_B, dram_config, mesh_device.get());
+
+        distributed::EnqueueWriteMeshBuffer(
+            cq, src0_dram_buffer, bmm_op_utils::pack_matmul_operand_tiles(src0_tiles, data_format), false);
+        distributed::EnqueueWriteMeshBuffer(
+            cq, src1_dram_buffer, bmm_op_utils::pack_matmul_operand_tiles(src1_tiles, data_format), false);
+
+        double time_us = bmm_op_utils::benchmark_matmul_block_config(
+            mesh_device,
+            src0_dram_buffer,
+            src1_dram_buffer,
+            dst_dram_buffer,
+            Mt,
+            Nt,
+            Kt,
+            config,
+            data_formats,
+            MathFidelity::HiFi4,
+            1,
+            10);
+
+        std::vector<bfloat16> result_vec(M * N);
+        distributed::EnqueueReadMeshBuffer(cq, result_vec, dst_dram_buffer, true);
+        result_vec = untilize_nfaces(result_vec, M, N);
+
+        float pearson = check_bfloat16_vector_pcc(golden_vec, result_vec);
+        fmt::print(
+            "{}: operand bytes = {}, block = {}x{}x{}, time = {:.1f} us, PCC = {}\n",
+            name,
+            (uint64_t)single_tile_size * (Mt * Kt + Kt * Nt),
+            config.per_core_M,
+            config.per_core_N,
+            config.in0_block_w,
+            time_us,
+            pearson);
+        if (pearson < min_pcc) {
+            fmt::print("PCC not high enough for {}. Result PCC: {}, Expected PCC: {}\n", name, pearson, min_pcc);
+            pass = false;
+        }
+    }
+
+    pass &= mesh_device->close();
+
+    if (pass) {
+        fmt::print("Test Passed!!! - matmul bfp\n");
+    } else {
+        TT_THROW("Test Failed");
+    }
+
+    return 0;
+}
@@ -0,0 +1,150 @@
+#include <chrono>
+#include <tt-metalium/host_api.hpp>
+#include <tt-metalium/constants.hpp>
+#include <tt-metalium/bfloat16.hpp>
+#include <tt-metalium/tilize_utils.hpp>
+#include <tt-metalium/device.hpp>
+#include <tt-metalium/tt_metal.hpp>
+#include <tt-metalium/distributed.hpp>
+#include <bmm_op.hpp>
+#include <bmm_reuse_program.hpp>
+#include <fmt/core.h>
+
+using namespace tt::constants;
+using namespace std;
+using namespace tt;
+using namespace tt::tt_metal;
+
+void golden_matmul(
+    std::vector<bfloat16>& a, std::vector<bfloat16>& b, std::vector<bfloat16>& output, uint32_t M, uint32_t N, uint32_t K) {
+    for (uint32_t i = 0; i < M; i++) {
+        for (uint32_t j = 0; j < N; j++) {
+            float c_f = 0;
+            for (uint32_t k = 0; k < K; k++) {
+                c_f += static_cast<float>(a[i * K + k]) * static_cast<float>(b[k * N + j]);
+            }
+            output.at(i * N + j) = bfloat16(c_f);
+        }
+    }
+}
+
+/*
+    output block 배치 / K block 순서 (MatmulBlockSchedule) 비교 예제.
+
+    matmul_multicore_reuse 처럼 output block i 를 core i 에 row-major로 두면 같은 core row의 core들이 같은 A tile을
+    같은 때에 읽어서 DRAM bank 몇 개와 그 NoC link에 요청이 몰린다. 같은 matmul을
+        - row-major (기존)
+        - rasterized     : block row raster_group_h 개씩 column 방향으로 core에 둔다.
+        - K rotation     : core마다 다른 K block부터 읽는다. (BANK_ROTATE)
+        - rasterized + K rotation
+    으로 돌려 launch 당 시간을 비교하고 결과를 golden과 비교한다.
+*/
+int main() {
+    bool pass = true;
+
+    constexpr int device_id = 0;
+    std::shared_ptr<distributed::MeshDevice> mesh_device = distributed::MeshDevice::create_unit_mesh(device_id);
+    distributed::MeshCommandQueue& cq = mesh_device->mesh_command_queue();
+
+    constexpr uint32_t M = 1024;  // user-defined
+    constexpr uint32_t N = 1024;  // user-defined
+    constexpr uint32_t K = 1024;  // user-defined
+    constexpr uint32_t num_iterations = 20;
+
+    uint32_t Mt = M / TILE_HEIGHT;
+    uint32_t Kt = K / TILE_WIDTH;
+    uint32_t Nt = N / TILE_WIDTH;
+
+    tt::DataFormat cb_data_format = tt::DataFormat::Float16_b;
+    uint32_t single_tile_size = tt::tile_size(cb_data_format);
+    auto grid = mesh_device->compute_with_storage_grid_size();
+
+    uint32_t in0_block_w = 2;
+    auto matmul_params = bmm_op_utils::get_large_matmul_params(Mt, Nt, grid.y, grid.x, in0_block_w);
+    bmm_op_utils::MatmulBlockConfig config{
+        std::get<0>(matmul_params),
+        std::get<1>(matmul_params),
+        in0_block_w,
+        std::get<2>(matmul_params),
+        std::get<3>(matmul_params)};
+    TT_FATAL(config.per_core_M != 0, "No valid core sizing for Mt = {}, Nt = {}", Mt, Nt);
+
+    // core row 하나에 block row 4개가 섞이도록 묶는다.
+    uint32_t raster_group_h = std::min<uint32_t>(4, Mt / config.per_core_M);
+
+    distributed::DeviceLocalBufferConfig dram_config{
+        .page_size = single_tile_size, .buffer_type = tt_metal::BufferType::DRAM};
+    distributed::ReplicatedBufferConfig buffer_config_A{.size = single_tile_size * Mt * Kt};
+    distributed::ReplicatedBufferConfig buffer_config_B{.size = single_tile_size * Nt * Kt};
+    distributed::ReplicatedBufferConfig buffer_config_C{.size = single_tile_size * Mt * Nt};
+    auto src0_dram_buffer = distributed::MeshBuffer::create(buffer_config_A, dram_config, mesh_device.get());
+    auto src1_dram_buffer = distributed::MeshBuffer::create(buffer_config_B, dram_config, mesh_device.get());
+    auto dst_dram_buffer = distributed::MeshBuffer::create(buffer_config_C, dram_config, mesh_device.get());
+
+    std::vector<bfloat16> src0_vec = create_random_vector_of_bfloat16_native(M * K * sizeof(bfloat16), 1, 123, -0.5);
+    std::vector<bfloat16> src1_vec = create_random_vector_of_bfloat16_native(K * N * sizeof(bfloat16), 1, 12522, -0.5);
+    std::vector<bfloat16> golden_vec(M * N, 0);
+    golden_matmul(src0_vec, src1_vec, golden_vec, M, N, K);
+
+    distributed::EnqueueWriteMeshBuffer(cq, src0_dram_buffer, tilize_nfaces(src0_vec, M, K), false);
+    distributed::EnqueueWriteMeshBuffer(cq, src1_dram_buffer, tilize_nfaces(src1_vec, K, N), false);
+
+    std::vector<std::pair<bmm_op_utils::MatmulBlockSchedule, const char*>> schedules = {
+        {{0, false}, "row-major"},
+        {{raster_group_h, false}, "rasterized"},
+        {{0, true}, "K rotation"},
+        {{raster_group_h, true}, "rasterized + K rotation"},
+    };
+
+    distributed::MeshCoordinateRange device_range = distributed::MeshCoordinateRange(mesh_device->shape());
+    for (const auto& [schedule, name] : schedules) {
+        distributed::MeshWorkload workload;
+        workload.add_program(
+            device_range,
+            bmm_op_utils::create_matmul_multicore_reuse_program(
+                src0_dram_buffer,
+                src1_dram_buffer,
+                dst_dram_buffer,
+                Mt,
+                Nt,
+                Kt,
+                1,
+                false,
+                config,
+                cb_data_format,
+                MathFidelity::HiFi4,
+                grid,
+                {.schedule = schedule}));
+
+        // 첫 launch는 kernel compile 시간이 들어가므로 한 번 먼저 돌린다.
+        distributed::EnqueueMeshWorkload(cq, workload, false);
+        distributed::Finish(cq);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (uint32_t i = 0; i < num_iterations; i++) {
+            distributed::EnqueueMeshWorkload(cq, workload, false);
+        }
+        distributed::Finish(cq);
+        auto end = std::chrono::high_resolution_clock::now();
+        double elapsed_us = std::chrono::duration<double, std::micro>(end - start).count() / num_iterations;
+
+        std::vector<bfloat16> result_vec(M * N);
+        distributed::EnqueueReadMeshBuffer(cq, result_vec, dst_dram_buffer, true);
+        float pearson = check_bfloat16_vector_pcc(golden_vec, untilize_nfaces(result_vec, M, N));
+        fmt::print(" -- {}: {:.1f} us per launch, PCC = {} --\n", name, elapsed_us, pearson);
+        if (pearson < 0.99f) {
+            fmt::print("PCC not high enough for {}. Result PCC: {}, Expected PCC: 0.99\n", name, pearson);
+            pass = false;
+        }
+    }
+
+    pass &= mesh_device->close();
+
+    if (pass) {
+        fmt::print("Test Passed!!! - matmul block schedule\n");
+    } else {
+        TT_THROW("Test Failed");
+    }
+
+    return 0;
+}
@@ -0,0 +1,552 @@
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <tuple>
+
+#include <fmt/core.h>
+
+#include "bmm_reuse_program.hpp"
+
+namespace bmm_op_utils {
+
+/*
+    matmul block 분할 autotuner.
+
+    get_large_matmul_params는 prime factor heuristic과 고정 in0_block_w = 2 로 분할을 하나만 고르는데,
+    정사각형이 아닌 shape에서는 최적과 거리가 먼 경우가 많다. autotuner는 grid와 L1에 들어가는
+    (per_core_M, per_core_N, in0_block_w, out_subblock_h, out_subblock_w) 후보를 모두 device에서 돌려 보고
+    가장 빠른 것을 파일 cache에 저장한다. 실제 호출 (get_tuned_matmul_params) 은 cache만 찾아보고,
+    없으면 기존 heuristic을 쓴다.
+*/
+
+/*
+    autotune / fidelity 선택 결과를 저장하는 on-disk key / value cache. 한 줄에 한 항목이며 text 형식이다.
+        <Key 의 column들> <Value 의 column들>
+    Key / Value 는 COLUMNS (파일 첫 줄의 설명), write(std::ostream&), read(std::istream&) 를 가져야 하고
+    Key는 std::map key로 쓰므로 operator< 도 필요하다.
+    생성할 때 파일을 읽고, store() 할 때마다 파일 전체를 다시 쓴다.
+*/
+template <typename Key, typename Value>
+class MatmulTextCache {
+public:
+    explicit MatmulTextCache(std::string path) : path_(std::move(path)) { load(); }
+
+    std::optional<Value> find(const Key& key) const {
+        auto it = entries_.find(key);
+        if (it == entries_.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    void store(const Key& key, const Value& value) {
+        entries_[key] = value;
+        save();
+    }
+
+    size_t size() const { return entries_.size(); }
+    const std::string& path() const { return path_; }
+
+private:
+    void load() {
+        std::ifstream in(path_);
+        if (!in) {
+            return;  // 아직 cache 파일이 없음
+        }
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            std::istringstream ss(line);
+            Key key;
+            Value value;
+            key.read(ss);
+            value.read(ss);
+            if (ss.fail()) {
+                fmt::print("matmul cache: skipping malformed line in {}: '{}'\n", path_, line);
+                continue;
+            }
+            entries_[key] = value;
+        }
+    }
+
+    void save() const {
+        std::ofstream out(path_, std::ios::trunc);
+        TT_FATAL(out.good(), "Cannot write matmul cache {}", path_);
+        out << "# " << Key::COLUMNS << ' ' << Value::COLUMNS << '\n';
+        for (const auto& [key, value] : entries_) {
+            key.write(out);
+            out << ' ';
+            value.write(out);
+            out << '\n';
+        }
+    }
+
+    std::string path_;
+    std::map<Key, Value> entries_;
+};
+
+// cache key: shape (tile 단위), data format, math fidelity (FPU pass 수가 달라 시간이 다르다), compute grid
+struct MatmulTuneKey {
+    uint32_t Mt = 0;
+    uint32_t Nt = 0;
+    uint32_t Kt = 0;
+    tt::DataFormat data_format = tt::DataFormat::Float16_b;
+    MathFidelity math_fidelity = MathFidelity::HiFi4;
+    uint32_t grid_x = 0;
+    uint32_t grid_y = 0;
+
+    static constexpr const char* COLUMNS = "Mt Nt Kt data_format math_fidelity grid_x grid_y";
+
+    bool operator<(const MatmulTuneKey& other) const {
+        return std::tie(Mt, Nt, Kt, data_format, math_fidelity, grid_x, grid_y) <
+               std::tie(
+                   other.Mt, other.Nt, other.Kt, other.data_format, other.math_fidelity, other.grid_x, other.grid_y);
+    }
+
+    void write(std::ostream& out) const {
+        out << Mt << ' ' << Nt << ' ' << Kt << ' ' << static_cast<uint32_t>(data_format) << ' '
+            << static_cast<uint32_t>(math_fidelity) << ' ' << grid_x << ' ' << grid_y;
+    }
+
+    void read(std::istream& in) {
+        uint32_t format = 0;
+        uint32_t fidelity = 0;
+        in >> Mt >> Nt >> Kt >> format >> fidelity >> grid_x >> grid_y;
+        data_format = static_cast<tt::DataFormat>(format);
+        math_fidelity = static_cast<MathFidelity>(fidelity);
+    }
+};
+
+struct MatmulTuneResult {
+    MatmulBlockConfig config;
+    double time_us = 0.0;  // launch 한 번의 평균 시간
+
+    static constexpr const char* COLUMNS = "per_core_M per_core_N in0_block_w out_subblock_h out_subblock_w time_us";
+
+    void write(std::ostream& out) const {
+        out << config.per_core_M << ' ' << config.per_core_N << ' ' << config.in0_block_w << ' '
+            << config.out_subblock_h << ' ' << config.out_subblock_w << ' ' << time_us;
+    }
+
+    void read(std::istream& in) {
+        in >> config.per_core_M >> config.per_core_N >> config.in0_block_w >> config.out_subblock_h >>
+            config.out_subblock_w >> time_us;
+    }
+};
+
+// autotune 결과 cache (autotune_matmul_block_params / get_tuned_matmul_params)
+using MatmulTuneCache = MatmulTextCache<MatmulTuneKey, MatmulTuneResult>;
+
+/*
+    grid와 L1에 들어가는 후보 분할을 모두 만든다.
+    - per_core_M / per_core_N 은 Mt / Nt 의 약수이고 block 수가 grid 안에 들어가야 한다.
+    - in0_block_w 는 Kt 의 약수 중 max_in0_block_w 이하.
+    - L1 제한은 l1_budget (MatmulL1Budget) 으로 확인한다.
+    - sub-block은 dst에 들어가는 (max_subblock_num_tiles 이하) 것 중 tile 수가 가장 많은 것만 넣는다.
+      sub-block이 작으면 항상 느리므로 후보 수만 늘어난다.
+*/
+inline std::vector<MatmulBlockConfig> get_matmul_block_candidates(
+    uint32_t Mt,
+    uint32_t Nt,
+    uint32_t Kt,
+    uint32_t num_cores_y,
+    uint32_t num_cores_x,
+    const MatmulL1Budget& l1_budget,
+    uint32_t max_in0_block_w = 8,
+    uint32_t max_subblock_num_tiles = 8) {
+    auto divisors = [](uint32_t n) {
+        std::vector<uint32_t> result;
+        for (uint32_t d = 1; d <= n; d++) {
+            if (n % d == 0) {
+                result.push_back(d);
+            }
+        }
+        return result;
+    };
+
+    std::vector<MatmulBlockConfig> candidates;
+    for (uint32_t Mpc : divisors(Mt)) {
+        for (uint32_t Npc : divisors(Nt)) {
+            if ((Mt / Mpc) * (Nt / Npc) > num_cores_y * num_cores_x) {
+                continue;
+            }
+            for (uint32_t in0_block_w : divisors(Kt)) {
+                if (in0_block_w > max_in0_block_w || !l1_budget.fits(Mpc, Npc, in0_block_w)) {
+                    continue;
+                }
+
+                uint32_t best_subblock_num_tiles = 0;
+                for (auto& subblock_hw : SUBBLOCK_HW_CHOICES) {
+                    auto subblock_h = std::get<0>(subblock_hw);
+                    auto subblock_w = std::get<1>(subblock_hw);
+                    if (subblock_h * subblock_w <= max_subblock_num_tiles && Mpc % subblock_h == 0 &&
+                        Npc % subblock_w == 0) {
+                        best_subblock_num_tiles = std::max(best_subblock_num_tiles, subblock_h * subblock_w);
+                    }
+                }
+                for (auto& subblock_hw : SUBBLOCK_HW_CHOICES) {
+                    auto subblock_h = std::get<0>(subblock_hw);
+                    auto subblock_w = std::get<1>(subblock_hw);
+                    if (subblock_h * subblock_w == best_subblock_num_tiles && Mpc % subblock_h == 0 &&
+                        Npc % subblock_w == 0) {
+                        candidates.push_back({Mpc, Npc, in0_block_w, subblock_h, subblock_w});
+                    }
+                }
+            }
+        }
+    }
+    return candidates;
+}
+
+// 하나의 분할로 program을 만들어 warmup 후 num_iterations 번 돌린 평균 시간 (us)
+inline double benchmark_matmul_block_config(
+    const std::shared_ptr<tt::tt_metal::distributed::MeshDevice>& mesh_device,
+    const std::shared_ptr<tt::tt_metal::distributed::MeshBuffer>& src0_dram_buffer,
+    const std::shared_ptr<tt::tt_metal::distributed::MeshBuffer>& src1_dram_buffer,
+    const std::shared_ptr<tt::tt_metal::distributed::MeshBuffer>& dst_dram_buffer,
+    uint32_t Mt,
+    uint32_t Nt,
+    uint32_t Kt,
+    const MatmulBlockConfig& config,
+    const MatmulDataFormats& data_formats,
+    MathFidelity math_fidelity,
+    uint32_t num_warmup,
+    uint32_t num_iterations) {
+    using namespace tt::tt_metal;
+
+    distributed::MeshCommandQueue& cq = mesh_device->mesh_command_queue();
+    distributed::MeshWorkload workload;
+    distributed::MeshCoordinateRange device_range = distributed::MeshCoordinateRange(mesh_device->shape());
+    workload.add_program(
+        device_range,
+        create_matmul_multicore_reuse_program(
+            src0_dram_buffer,
+            src1_dram_buffer,
+            dst_dram_buffer,
+            Mt,
+            Nt,
+            Kt,
+            1,
+            false,
+            config,
+            data_formats,
+            math_fidelity,
+            mesh_device->compute_with_storage_grid_size()));
+
+    // 첫 launch는 kernel compile 시간이 들어가므로 warmup으로 뺀다.
+    for (uint32_t i = 0; i < num_warmup; i++) {
+        distributed::EnqueueMeshWorkload(cq, workload, false);
+    }
+    distributed::Finish(cq);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        distributed::EnqueueMeshWorkload(cq, workload, false);
+    }
+    distributed::Finish(cq);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    return std::chrono::duration<double, std::micro>(end - start).count() / num_iterations;
+}
+
+/*
+    cache에 있으면 그대로 돌려주고, 없으면 후보를 모두 benchmark 해서 가장 빠른 분할을 cache에 저장한다.
+    src0 / src1 / dst buffer는 (Mt x Kt), (Kt x Nt), (Mt x Nt) tile 크기여야 하며 dst의 내용은 덮어쓴다.
+*/
+inline MatmulTuneResult autotune_matmul_block_params(
+    const std::shared_ptr<tt::tt_metal::distributed::MeshDevice>& mesh_device,
+    const std::shared_ptr<tt::tt_metal::distributed::MeshBuffer>& src0_dram_buffer,
+    const std::shared_ptr<tt::tt_metal::distributed::MeshBuffer>& src1_dram_buffer,
+    const std::shared_ptr<tt::tt_metal::distributed::MeshBuffer>& dst_dram_buffer,
+    uint32_t Mt,
+    uint32_t Nt,
+    uint32_t Kt,
+    tt::DataFormat data_format,
+    MathFidelity math_fidelity,
+    MatmulTuneCache& cache,
+    uint32_t num_warmup = 1,
+    uint32_t num_iterations = 10) {
+    auto grid = mesh_device->compute_with_storage_grid_size();
+    MatmulTuneKey key{Mt, Nt, Kt, data_format, math_fidelity, (uint32_t)grid.x, (uint32_t)grid.y};
+    if (auto cached = cache.find(key)) {
+        return *cached;
+    }
+
+    auto l1_budget = get_matmul_l1_budget(mesh_device.get(), data_format, data_format, data_format, data_format);
+    auto candidates = get_matmul_block_candidates(Mt, Nt, Kt, grid.y, grid.x, l1_budget);
+    TT_FATAL(
+        !candidates.empty(),
+        "No matmul block config fits Mt={}, Nt={}, Kt={} on a {}x{} grid",
+        Mt,
+        Nt,
+        Kt,
+        grid.x,
+        grid.y);
+
+    fmt::print(" -- autotune: {} candidates for Mt={} Nt={} Kt={} --\n", candidates.size(), Mt, Nt, Kt);
+
+    MatmulTuneResult best;
+    best.time_us = std::numeric_limits<double>::max();
+    for (const auto& config : candidates) {
+        double time_us = benchmark_matmul_block_config(
+            mesh_device,
+            src0_dram_buffer,
+            src1_dram_buffer,
+            dst_dram_buffer,
+            Mt,
+            Nt,
+            Kt,
+            config,
+            data_format,
+            math_fidelity,
+            num_warmup,
+            num_iterations);
+        if (time_us < best.time_us) {
+            best = {config, time_us};
+        }
+    }
+
+    cache.store(key, best);
+    return best;
+}
+
+/*
+    실제 matmul 호출에서 쓰는 lookup. tune 된 분할이 cache에 있으면 그것을, 없으면
+    get_large_matmul_params 의 결과를 돌려준다. in0_block_w 는 Kt를 나누는 2 이하의 가장 큰 값 (Kt가 홀수면 1) 이다.
+    heuristic도 실패하면 모든 값이 0이다. l1_budget 은 get_matmul_l1_budget 으로 device에 맞춰 만든다.
+    cache 파일은 다른 device (L1 크기가 다른) 에서 만들어졌을 수 있으므로 cache의 분할도 shape를 나누고
+    l1_budget 에 들어가는지 다시 확인하고, 아니면 heuristic을 쓴다.
+*/
+inline MatmulBlockConfig get_tuned_matmul_params(
+    const MatmulTuneCache& cache,
+    uint32_t Mt,
+    uint32_t Nt,
+    uint32_t Kt,
+    tt::DataFormat data_format,
+    MathFidelity math_fidelity,
+    CoreCoord compute_with_storage_grid_size,
+    const MatmulL1Budget& l1_budget) {
+    MatmulTuneKey key{
+        Mt,
+        Nt,
+        Kt,
+        data_format,
+        math_fidelity,
+        (uint32_t)compute_with_storage_grid_size.x,
+        (uint32_t)compute_with_storage_grid_size.y};
+    if (auto cached = cache.find(key)) {
+        const auto& config = cached->config;
+        bool valid = config.per_core_M != 0 && config.per_core_N != 0 && config.in0_block_w != 0 &&
+                     config.out_subblock_h != 0 && config.out_subblock_w != 0 && Mt % config.per_core_M == 0 &&
+                     Nt % config.per_core_N == 0 && Kt % config.in0_block_w == 0 &&
+                     config.per_core_M % config.out_subblock_h == 0 &&
+                     config.per_core_N % config.out_subblock_w == 0 &&
+                     l1_budget.fits(config.per_core_M, config.per_core_N, config.in0_block_w);
+        if (valid) {
+            return config;
+        }
+        fmt::print(
+            " -- cached block config {}x{} (in0_block_w = {}) does not fit, using the heuristic --\n",
+            config.per_core_M,
+            config.per_core_N,
+            config.in0_block_w);
+    }
+
+    uint32_t in0_block_w = Kt % 2 == 0 ? 2 : 1;
+    auto params = get_large_matmul_params(
+        Mt, Nt, compute_with_storage_grid_size.y, compute_with_storage_grid_size.x, in0_block_w, 8, l1_budget);
+    if (std::get<0>(params) == 0) {
+        return {};
+    }
+    return {std::get<0>(params), std::get<1>(params), in0_block_w, std::get<2>(params), std::get<3>(params)};
+}
+
+/*
+    math fidelity 선택.
+
+    HiFi4는 tile 하나를 곱할 때 FPU pass를 4번 돈다. (LoFi 1번, HiFi2 2번, HiFi3 3번) 입력 분포에 따라서는 낮은
+    fidelity로도 충분히 정확하므로, shape와 입력 분포 (input_tag) 마다 fidelity를 모두 돌려 보고 golden 대비 PCC가
+    min_pcc 이상인 것 중 가장 빠른 것을 고른다. 결과는 block 분할 cache와 같은 방식의 text cache에 저장한다.
+*/
+inline const char* math_fidelity_name(MathFidelity math_fidelity) {
+    switch (math_fidelity) {
+        case MathFidelity::LoFi: return "LoFi";
+        case MathFidelity::HiFi2: return "HiFi2";
+        case MathFidelity::HiFi3: return "HiFi3";
+        case MathFidelity::HiFi4: return "HiFi4";
+        default: return "Invalid";
+    }
+}
+
+/*
+    fidelity cache key: shape (tile 단위), operand / interm / output data format, 입력 분포 이름 (공백 없이),
+    정확도 기준. 같은 in0 형식이라도 in1 (bfp8 weight 등) 이나 interm / out 형식이 다르면 PCC가 달라진다.
+    min_pcc 는 text로 쓰고 다시 읽어도 같은 key가 되도록 1e-4 단위 정수 (min_pcc_e4) 로 두고 소수점 4자리로 쓴다.
+*/
+struct MatmulFidelityKey {
+    uint32_t Mt = 0;
+    uint32_t Nt = 0;
+    uint32_t Kt = 0;
+    tt::DataFormat in0_format = tt::DataFormat::Float16_b;
+    tt::DataFormat in1_format = tt::DataFormat::Float16_b;
+    tt::DataFormat out_format = tt::DataFormat::Float16_b;
+    tt::DataFormat interm_format = tt::DataFormat::Float16_b;
+    std::string input_tag;
+    uint32_t min_pcc_e4 = 0;  // min_pcc * 10000
+
+    static constexpr const char* COLUMNS =
+        "Mt Nt Kt in0_format in1_format out_format interm_format input_tag min_pcc";
+
+    MatmulFidelityKey() = default;
+    MatmulFidelityKey(
+        uint32_t Mt,
+        uint32_t Nt,
+        uint32_t Kt,
+        const MatmulDataFormats& data_formats,
+        std::string input_tag,
+        float min_pcc) :
+        Mt(Mt),
+        Nt(Nt),
+        Kt(Kt),
+        in0_format(data_formats.in0),
+        in1_format(data_formats.in1),
+        out_format(data_formats.out),
+        interm_format(data_formats.interm),
+        input_tag(std::move(input_tag)),
+        min_pcc_e4(std::lround(min_pcc * 10000.0)) {}
+
+    bool operator<(const MatmulFidelityKey& other) const {
+        return std::tie(Mt, Nt, Kt, in0_format, in1_format, out_format, interm_format, input_tag, min_pcc_e4) <
+               std::tie(
+                   other.Mt,
+                   other.Nt,
+                   other.Kt,
+                   other.in0_format,
+                   other.in1_format,
+                   other.out_format,
+                   other.interm_format,
+                   other.input_tag,
+                   other.min_pcc_e4);
+    }
+
+    void write(std::ostream& out) const {
+        out << Mt << ' ' << Nt << ' ' << Kt << ' ' << static_cast<uint32_t>(in0_format) << ' '
+            << static_cast<uint32_t>(in1_format) << ' ' << static_cast<uint32_t>(out_format) << ' '
+            << static_cast<uint32_t>(interm_format) << ' ' << input_tag << ' '
+            << fmt::format("{:.4f}", min_pcc_e4 / 10000.0);
+    }
+
+    void read(std::istream& in) {
+        uint32_t formats[4] = {0, 0, 0, 0};
+        double min_pcc = 0.0;
+        in >> Mt >> Nt >> Kt >> formats[0] >> formats[1] >> formats[2] >> formats[3] >> input_tag >> min_pcc;
+        in0_format = static_cast<tt::DataFormat>(formats[0]);
+        in1_format = static_cast<tt::DataFormat>(formats[1]);
+        out_format = static_cast<tt::DataFormat>(formats[2]);
+        interm_format = static_cast<tt::DataFormat>(formats[3]);
+        min_pcc_e4 = std::lround(min_pcc * 10000.0);
+    }
+};
+
+struct MatmulFidelityResult {
+    MathFidelity math_fidelity = MathFidelity::HiFi4;
+    double time_us = 0.0;
+    float pcc = 0.0f;
+
+    static constexpr const char* COLUMNS = "math_fidelity time_us pcc";
+
+    void write(std::ostream& out) const {
+        out << static_cast<uint32_t>(math_fidelity) << ' ' << time_us << ' ' << pcc;
+    }
+
+    void read(std::istream& in) {
+        uint32_t fidelity = 0;
+        in >> fidelity >> time_us >> pcc;
+        math_fidelity = static_cast<MathFidelity>(fidelity);
+    }
+};
+
+// fidelity 선택 결과 cache (select_matmul_fidelity)
+using MatmulFidelityCache = MatmulTextCache<MatmulFidelityKey, MatmulFidelityResult>;
+
+/*
+    cache에 있으면 그대로 돌려주고, 없으면 LoFi, HiFi2, HiFi3, HiFi4 를 모두 benchmark 하고 결과를 golden
+    (row-major, Mt*32 x Nt*32, untilize 된 bf16) 과 비교해서 min_pcc 이상인 것 중 가장 빠른 fidelity를 고른다.
+    output은 data_formats.out 형식으로 읽는다. (read_matmul_output_tiles)
+    어느 것도 기준을 넘지 못하면 HiFi4를 쓴다. dst의 내용은 덮어쓴다.
+*/
+inline MatmulFidelityResult select_matmul_fidelity(
+    const std::shared_ptr<tt::tt_metal::distributed::MeshDevice>& mesh_device,
+    const std::shared_ptr<tt::tt_metal::distributed::MeshBuffer>& src0_dram_buffer,
+    const std::shared_ptr<tt::tt_metal::distributed::MeshBuffer>& src1_dram_buffer,
+    const std::shared_ptr<tt::tt_metal::distributed::MeshBuffer>& dst_dram_buffer,
+    uint32_t Mt,
+    uint32_t Nt,
+    uint32_t Kt,
+    const MatmulBlockConfig& config,
+    const MatmulDataFormats& data_formats,
+    const std::vector<bfloat16>& golden,
+    const std::string& input_tag,
+    float min_pcc,
+    MatmulFidelityCache& cache,
+    uint32_t num_warmup = 1,
+    uint32_t num_iterations = 10) {
+    using namespace tt::tt_metal;
+
+    MatmulFidelityKey key(Mt, Nt, Kt, data_formats, input_tag, min_pcc);
+    if (auto cached = cache.find(key)) {
+        return *cached;
+    }
+
+    distributed::MeshCommandQueue& cq = mesh_device->mesh_command_queue();
+
+    std::optional<MatmulFidelityResult> best;
+    for (MathFidelity math_fidelity :
+         {MathFidelity::LoFi, MathFidelity::HiFi2, MathFidelity::HiFi3, MathFidelity::HiFi4}) {
+        double time_us = benchmark_matmul_block_config(
+            mesh_device,
+            src0_dram_buffer,
+            src1_dram_buffer,
+            dst_dram_buffer,
+            Mt,
+            Nt,
+            Kt,
+            config,
+            data_formats,
+            math_fidelity,
+            num_warmup,
+            num_iterations);
+
+        // output 형식 (data_formats.out) 그대로 읽어서 bf16 으로 바꾼 뒤 비교한다.
+        auto result = read_matmul_output_tiles(cq, dst_dram_buffer, Mt, Nt, data_formats.out);
+        float pcc = check_bfloat16_vector_pcc(golden, result);
+
+        fmt::print(
+            " -- fidelity {}: {:.1f} us, PCC = {} {}--\n",
+            math_fidelity_name(math_fidelity),
+            time_us,
+            pcc,
+            pcc >= min_pcc ? "" : "(below threshold) ");
+        if (pcc >= min_pcc && (!best || time_us < best->time_us)) {
+            best = MatmulFidelityResult{math_fidelity, time_us, pcc};
+        }
+        if (math_fidelity == MathFidelity::HiFi4 && !best) {
+            fmt::print(" -- no fidelity reaches PCC {}, falling back to HiFi4 --\n", min_pcc);
+            best = MatmulFidelityResult{math_fidelity, time_us, pcc};
+        }
+    }
+
+    cache.store(key, *best);
+    return *best;
+}
+
+}  // namespace bmm_op_utils
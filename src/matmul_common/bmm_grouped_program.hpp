@@ -0,0 +1,308 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "bmm_reuse_program.hpp"
+
+namespace bmm_op_utils {
+
+/*
+    grouped matmul: shape과 operand가 다른 matmul 여러 개 (MoE의 expert 별 GEMM) 를 launch 하나로 돌린다.
+
+    expert 마다 EnqueueMeshWorkload 를 따로 하면 dispatch 시간이 대부분이고, token이 적은 expert는 grid의
+    일부만 쓴다. 여기서는 모든 group의 output block을 모아 (LPT) core에 고르게 나누고, group의 shape과 주소는
+    DRAM의 descriptor table (MatmulGroupDesc) 에 두어 reader / writer가 읽는다.
+    - block 분할 (per_core_M, per_core_N, in0_block_w, sub-block) 은 모든 group이 같다. group 행렬이 block의
+      배수가 아니면 reader_bmm_tile_layout_padded 처럼 0으로 채우고 writer가 버린다.
+    - compute는 bmm_large_block_zm 을 GROUPED_WORK_ITEMS 로 쓴다. (item 수와 item 별 K block 수가 runtime arg)
+    - 모든 operand는 같은 data format의 interleaved DRAM buffer여야 한다.
+*/
+struct MatmulGroup {
+    uint32_t Mt = 0;
+    uint32_t Nt = 0;
+    uint32_t Kt = 0;
+    std::shared_ptr<tt::tt_metal::distributed::MeshBuffer> in0;
+    std::shared_ptr<tt::tt_metal::distributed::MeshBuffer> in1;
+    std::shared_ptr<tt::tt_metal::distributed::MeshBuffer> out;
+};
+
+// descriptor table entry. kernels/bmm_dataflow_utils.h 의 matmul_group_desc_t 와 같은 배치여야 한다.
+struct MatmulGroupDesc {
+    uint32_t Mt = 0;
+    uint32_t Nt = 0;
+    uint32_t Kt = 0;
+    uint32_t in0_addr = 0;
+    uint32_t in1_addr = 0;
+    uint32_t out_addr = 0;
+    uint32_t reserved[2] = {0, 0};
+};
+static_assert(sizeof(MatmulGroupDesc) == 32, "MatmulGroupDesc must match matmul_group_desc_t");
+
+// output block 하나 = work item 하나. k_blocks (K block 수) 가 그 item의 비용이다.
+struct MatmulGroupWorkItem {
+    uint32_t group = 0;
+    uint32_t block_y = 0;
+    uint32_t block_x = 0;
+    uint32_t k_blocks = 0;
+};
+
+// core 하나가 받을 수 있는 work item 수. reader runtime args (6 + 3 * items) 가 runtime arg 한도 안에 들어가야 한다.
+constexpr uint32_t MAX_GROUPED_MATMUL_ITEMS_PER_CORE = 100;
+
+/*
+    group 들의 descriptor table을 DRAM buffer (page 하나) 로 만들어 쓴다. group buffer 주소가 바뀌지 않는 한
+    program과 같이 재사용한다.
+*/
+inline std::shared_ptr<tt::tt_metal::distributed::MeshBuffer> create_matmul_group_table(
+    tt::tt_metal::distributed::MeshDevice* mesh_device,
+    tt::tt_metal::distributed::MeshCommandQueue& cq,
+    const std::vector<MatmulGroup>& groups) {
+    using namespace tt::tt_metal;
+
+    TT_FATAL(!groups.empty(), "Grouped matmul needs at least one group");
+    std::vector<uint32_t> table;
+    for (const auto& group : groups) {
+        MatmulGroupDesc desc{
+            .Mt = group.Mt,
+            .Nt = group.Nt,
+            .Kt = group.Kt,
+            .in0_addr = (uint32_t)group.in0->address(),
+            .in1_addr = (uint32_t)group.in1->address(),
+            .out_addr = (uint32_t)group.out->address()};
+        const auto* words = reinterpret_cast<const uint32_t*>(&desc);
+        table.insert(table.end(), words, words + sizeof(MatmulGroupDesc) / sizeof(uint32_t));
+    }
+
+    uint32_t table_bytes = table.size() * sizeof(uint32_t);
+    distributed::DeviceLocalBufferConfig dram_config{.page_size = table_bytes, .buffer_type = BufferType::DRAM};
+    distributed::ReplicatedBufferConfig buffer_config{.size = table_bytes};
+    auto table_buffer = distributed::MeshBuffer::create(buffer_config, dram_config, mesh_device);
+    distributed::EnqueueWriteMeshBuffer(cq, table_buffer, table, false);
+    return table_buffer;
+}
+
+/*
+    모든 group의 output block을 num_cores 개의 core에 나눈다. (LPT: 비용이 큰 item부터 지금까지 가장 적게
+    받은 core에 준다.) block 크기가 모두 같으므로 비용은 K block 수이다. core 수보다 item이 적으면 item 수만큼의
+    core만 쓴다.
+*/
+inline std::vector<std::vector<MatmulGroupWorkItem>> balance_matmul_group_work(
+    const std::vector<MatmulGroup>& groups, const MatmulBlockConfig& config, uint32_t num_cores) {
+    std::vector<MatmulGroupWorkItem> items;
+    for (uint32_t g = 0; g < groups.size(); g++) {
+        uint32_t num_blocks_y = (groups[g].Mt + config.per_core_M - 1) / config.per_core_M;
+        uint32_t num_blocks_x = (groups[g].Nt + config.per_core_N - 1) / config.per_core_N;
+        uint32_t k_blocks = (groups[g].Kt + config.in0_block_w - 1) / config.in0_block_w;
+        for (uint32_t by = 0; by < num_blocks_y; by++) {
+            for (uint32_t bx = 0; bx < num_blocks_x; bx++) {
+                items.push_back({g, by, bx, k_blocks});
+            }
+        }
+    }
+    std::stable_sort(items.begin(), items.end(), [](const auto& a, const auto& b) { return a.k_blocks > b.k_blocks; });
+
+    uint32_t num_cores_used = std::min<uint32_t>(num_cores, items.size());
+    std::vector<std::vector<MatmulGroupWorkItem>> core_items(num_cores_used);
+    // (지금까지 받은 비용, core index) min-heap. 비용이 같으면 index가 작은 core가 먼저 받는다.
+    using CoreLoad = std::pair<uint64_t, uint32_t>;
+    std::priority_queue<CoreLoad, std::vector<CoreLoad>, std::greater<CoreLoad>> loads;
+    for (uint32_t core = 0; core < num_cores_used; core++) {
+        loads.push({0, core});
+    }
+    for (const auto& item : items) {
+        auto [load, core] = loads.top();
+        loads.pop();
+        core_items[core].push_back(item);
+        loads.push({load + item.k_blocks, core});
+    }
+    return core_items;
+}
+
+/*
+    grouped matmul program. reader_bmm_grouped / bmm_large_block_zm (GROUPED_WORK_ITEMS) / writer_bmm_grouped 을
+    balance_matmul_group_work 가 나눈 core 에 만든다. table_buffer 는 create_matmul_group_table 로 만든 것이다.
+    descriptor table은 reader가 core 마다 c_3 으로 한 번 읽고 writer가 같이 본다.
+*/
+inline tt::tt_metal::Program create_grouped_matmul_program(
+    const std::vector<MatmulGroup>& groups,
+    const std::shared_ptr<tt::tt_metal::distributed::MeshBuffer>& table_buffer,
+    const MatmulBlockConfig& config,
+    tt::DataFormat data_format,
+    MathFidelity math_fidelity,
+    CoreCoord compute_with_storage_grid_size) {
+    using namespace tt::tt_metal;
+
+    Program program{};
+
+    uint32_t single_tile_size = tt::tile_size(data_format);
+    uint32_t num_cores_x = compute_with_storage_grid_size.x;
+
+    uint32_t per_core_M = config.per_core_M;
+    uint32_t per_core_N = config.per_core_N;
+    uint32_t in0_block_w = config.in0_block_w;
+    uint32_t out_subblock_h = config.out_subblock_h;
+    uint32_t out_subblock_w = config.out_subblock_w;
+
+    TT_FATAL(
+        per_core_M % out_subblock_h == 0 && per_core_N % out_subblock_w == 0,
+        "Sub-block {}x{} does not divide block {}x{}",
+        out_subblock_h,
+        out_subblock_w,
+        per_core_M,
+        per_core_N);
+    TT_FATAL(
+        out_subblock_h * out_subblock_w <= 8, "Sub-block {}x{} does not fit in dst", out_subblock_h, out_subblock_w);
+    for (const auto& group : groups) {
+        TT_FATAL(
+            group.in0->size() == (uint64_t)group.Mt * group.Kt * single_tile_size &&
+                group.in1->size() == (uint64_t)group.Kt * group.Nt * single_tile_size &&
+                group.out->size() == (uint64_t)group.Mt * group.Nt * single_tile_size,
+            "Group buffers do not match its {}x{}x{} tile shape",
+            group.Mt,
+            group.Nt,
+            group.Kt);
+    }
+
+    auto core_items = balance_matmul_group_work(
+        groups, config, compute_with_storage_grid_size.x * compute_with_storage_grid_size.y);
+    uint32_t num_cores = core_items.size();
+    for (const auto& items : core_items) {
+        TT_FATAL(
+            items.size() <= MAX_GROUPED_MATMUL_ITEMS_PER_CORE,
+            "{} work items on one core exceed the runtime arg limit ({} items)",
+            items.size(),
+            MAX_GROUPED_MATMUL_ITEMS_PER_CORE);
+    }
+    CoreRangeSet all_cores(num_cores_to_corerangeset(num_cores, compute_with_storage_grid_size, true));
+
+    uint32_t in0_num_subblocks = per_core_M / out_subblock_h;
+    uint32_t in0_block_num_tiles = per_core_M * in0_block_w;
+    uint32_t in0_subblock_num_tiles = out_subblock_h * in0_block_w;
+    uint32_t in1_num_subblocks = per_core_N / out_subblock_w;
+    uint32_t in1_block_num_tiles = per_core_N * in0_block_w;
+    uint32_t out_subblock_num_tiles = out_subblock_h * out_subblock_w;
+
+    // num_blocks 와 batch 는 GROUPED_WORK_ITEMS 에서 runtime arg로 바뀐다.
+    std::vector<uint32_t> compute_kernel_args = {
+        in0_block_w,             // in0_block_w
+        in0_num_subblocks,       // in0_num_subblocks
+        in0_block_num_tiles,     // in0_block_num_tiles
+        in0_subblock_num_tiles,  // in0_subblock_num_tiles
+
+        in1_num_subblocks,    // in1_num_subblocks
+        in1_block_num_tiles,  // in1_block_num_tiles
+        per_core_N,           // in1_per_core_w
+
+        0,  // num_blocks (item 별 runtime arg)
+
+        out_subblock_h,          // out_subblock_h
+        out_subblock_w,          // out_subblock_w
+        out_subblock_num_tiles,  // out_subblock_num_tiles
+        0                        // batch (core 별 item 수, runtime arg)
+    };
+
+    CreateCircularBuffer(
+        program,
+        all_cores,
+        CircularBufferConfig(in0_block_num_tiles * 2 * single_tile_size, {{tt::CBIndex::c_0, data_format}})
+            .set_page_size(tt::CBIndex::c_0, single_tile_size));  // double buffer
+    CreateCircularBuffer(
+        program,
+        all_cores,
+        CircularBufferConfig(in1_block_num_tiles * 2 * single_tile_size, {{tt::CBIndex::c_1, data_format}})
+            .set_page_size(tt::CBIndex::c_1, single_tile_size));  // double buffer
+    uint32_t table_bytes = table_buffer->size();
+    CreateCircularBuffer(
+        program,
+        all_cores,
+        CircularBufferConfig(table_bytes, {{tt::CBIndex::c_3, tt::DataFormat::UInt32}})
+            .set_page_size(tt::CBIndex::c_3, table_bytes));
+    uint32_t output_cb_index = tt::CBIndex::c_16;
+    uint32_t interm0_cb_index = 24;
+    std::map<uint8_t, tt::DataFormat> output_cb_data_format_spec{
+        {output_cb_index, data_format}, {interm0_cb_index, data_format}};
+    CreateCircularBuffer(
+        program,
+        all_cores,
+        CircularBufferConfig(per_core_M * per_core_N * single_tile_size, output_cb_data_format_spec)
+            .set_page_size(output_cb_index, single_tile_size)
+            .set_page_size(interm0_cb_index, single_tile_size));
+
+    // 모든 group의 buffer가 같은 종류이므로 첫 group의 buffer로 accessor compile time args를 만든다.
+    std::vector<uint32_t> reader_compile_time_args;
+    TensorAccessorArgs(*groups[0].in0).append_to(reader_compile_time_args);
+    TensorAccessorArgs(*groups[0].in1).append_to(reader_compile_time_args);
+    TensorAccessorArgs(*table_buffer).append_to(reader_compile_time_args);
+
+    std::vector<uint32_t> writer_compile_time_args;
+    TensorAccessorArgs(*groups[0].out).append_to(writer_compile_time_args);
+
+    auto reader_id = CreateKernel(
+        program,
+        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/matmul_common/kernels/reader_bmm_grouped.cpp",
+        all_cores,
+        DataMovementConfig{
+            .processor = DataMovementProcessor::RISCV_1,
+            .noc = NOC::RISCV_1_default,
+            .compile_args = reader_compile_time_args});
+
+    auto writer_id = CreateKernel(
+        program,
+        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/matmul_common/kernels/writer_bmm_grouped.cpp",
+        all_cores,
+        DataMovementConfig{
+            .processor = DataMovementProcessor::RISCV_0,
+            .noc = NOC::RISCV_0_default,
+            .compile_args = writer_compile_time_args});
+
+    auto compute_id = CreateKernel(
+        program,
+        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/matmul_common/kernels/bmm_large_block_zm.cpp",
+        all_cores,
+        ComputeConfig{
+            .math_fidelity = math_fidelity,
+            .compile_args = compute_kernel_args,
+            .defines = {{"GROUPED_WORK_ITEMS", "1"}}});
+
+    for (uint32_t i = 0; i < num_cores; i++) {
+        CoreCoord core = {i % num_cores_x, i / num_cores_x};
+        const auto& items = core_items[i];
+
+        std::vector<uint32_t> reader_args = {
+            (std::uint32_t)table_buffer->address(),  // table_addr
+            table_bytes,                             // table_bytes
+            per_core_M,                              // per_core_M
+            per_core_N,                              // per_core_N
+            in0_block_w,                             // in0_block_w
+            (std::uint32_t)items.size()              // num_items
+        };
+        std::vector<uint32_t> writer_args = {
+            per_core_M,                  // per_core_M
+            per_core_N,                  // per_core_N
+            out_subblock_h,              // out_subblock_h
+            out_subblock_w,              // out_subblock_w
+            (std::uint32_t)items.size()  // num_items
+        };
+        std::vector<uint32_t> compute_args = {(std::uint32_t)items.size()};
+        for (const auto& item : items) {
+            for (auto* args : {&reader_args, &writer_args}) {
+                args->push_back(item.group);
+                args->push_back(item.block_y);
+                args->push_back(item.block_x);
+            }
+            compute_args.push_back(item.k_blocks);
+        }
+
+        SetRuntimeArgs(program, reader_id, core, reader_args);
+        SetRuntimeArgs(program, writer_id, core, writer_args);
+        SetRuntimeArgs(program, compute_id, core, compute_args);
+    }
+
+    return program;
+}
+
+}  // namespace bmm_op_utils
@@ -6,6 +6,8 @@
 #include <tt-metalium/host_api.hpp>
 #include <tt-metalium/constants.hpp>
 #include <tt-metalium/bfloat16.hpp>
+#include <tt-metalium/device.hpp>
+#include <tt-metalium/allocator.hpp>
 
 #include <umd/device/types/xy_pair.hpp>
 
@@ -60,12 +62,89 @@ std::vector<uint32_t> get_possible_products(const std::vector<uint32_t>& factors
     return products;
 }
 
-uint32_t get_maximum_block_dim(int32_t block_dim, int32_t in0_block_w) {
-    int32_t other_dim = (400 - 2 * in0_block_w * block_dim) / (2 * in0_block_w + block_dim);
-    if (other_dim > 0) {
-        return other_dim;
+/*
+    matmul block 하나가 L1에서 쓰는 양 (byte 단위) 모델.
+
+        in0 (c_0)     : in_buffering * per_core_M * in0_block_w tiles
+        in1 (c_1)     : in_buffering * in0_block_w * per_core_N tiles
+        out (c_16)    : out_buffering * per_core_M * per_core_N tiles
+        interm (c_24) : per_core_M * per_core_N tiles
+
+    c_16과 c_24가 CB config 하나를 같이 쓰면 (matmul_multicore_reuse) 같은 L1을 쓰므로 둘 중 큰 tile 크기만 세고,
+    따로 만들면 (output double buffering, SEPARATE_INTERM_CB) 둘 다 센다.
+    기본값은 예전 get_maximum_block_dim의 고정값 (bf16 tile 400개) 과 같다.
+    실제 device에 맞춘 값은 get_matmul_l1_budget 으로 만든다.
+*/
+struct MatmulL1Budget {
+    uint32_t l1_size_bytes = 400 * 2048;
+    uint32_t in0_tile_size = 2048;
+    uint32_t in1_tile_size = 2048;
+    uint32_t out_tile_size = 2048;     // c_16
+    uint32_t interm_tile_size = 2048;  // c_24
+    bool interm_shares_output = true;
+    uint32_t in_buffering = 2;
+    uint32_t out_buffering = 1;
+
+    // output block의 tile 하나당 c_16 + c_24 가 쓰는 bytes
+    uint32_t out_block_tile_size() const {
+        return interm_shares_output ? out_buffering * std::max(out_tile_size, interm_tile_size)
+                                    : out_buffering * out_tile_size + interm_tile_size;
+    }
+
+    uint64_t block_bytes(uint32_t per_core_M, uint32_t per_core_N, uint32_t in0_block_w) const {
+        return (uint64_t)in_buffering * in0_block_w * (per_core_M * in0_tile_size + per_core_N * in1_tile_size) +
+               (uint64_t)per_core_M * per_core_N * out_block_tile_size();
+    }
+
+    bool fits(uint32_t per_core_M, uint32_t per_core_N, uint32_t in0_block_w) const {
+        return block_bytes(per_core_M, per_core_N, in0_block_w) <= l1_size_bytes;
+    }
+
+    // per_core_M 이 정해졌을 때 L1에 들어가는 가장 큰 per_core_N
+    uint32_t max_block_n(uint32_t per_core_M, uint32_t in0_block_w) const {
+        int64_t remaining = (int64_t)l1_size_bytes - (int64_t)in_buffering * in0_block_w * per_core_M * in0_tile_size;
+        int64_t per_col =
+            (int64_t)in_buffering * in0_block_w * in1_tile_size + (int64_t)per_core_M * out_block_tile_size();
+        return remaining > 0 ? remaining / per_col : 0;
+    }
+
+    // per_core_N 이 정해졌을 때 L1에 들어가는 가장 큰 per_core_M
+    uint32_t max_block_m(uint32_t per_core_N, uint32_t in0_block_w) const {
+        int64_t remaining = (int64_t)l1_size_bytes - (int64_t)in_buffering * in0_block_w * per_core_N * in1_tile_size;
+        int64_t per_row =
+            (int64_t)in_buffering * in0_block_w * in0_tile_size + (int64_t)per_core_N * out_block_tile_size();
+        return remaining > 0 ? remaining / per_row : 0;
     }
-    return 0;
+};
+
+/*
+    device의 L1 중 allocator가 쓸 수 있는 부분 (firmware 등 예약 영역 제외) 과
+    각 CB의 data format별 tile 크기로 budget을 만든다.
+    bf16 tile은 2KB, bfp8은 1088B, fp32/uint32는 4KB, uint8은 1KB 이므로 tile 개수 고정값은
+    format에 따라 L1을 남기거나 넘친다.
+*/
+inline MatmulL1Budget get_matmul_l1_budget(
+    tt::tt_metal::IDevice* device,
+    tt::DataFormat in0_data_format,
+    tt::DataFormat in1_data_format,
+    tt::DataFormat out_data_format,
+    tt::DataFormat interm_data_format,
+    bool interm_shares_output = true,
+    uint32_t out_buffering = 1) {
+    MatmulL1Budget budget;
+    uint32_t l1_base = device->allocator()->get_base_allocator_addr(tt::tt_metal::HalMemType::L1);
+    budget.l1_size_bytes = device->l1_size_per_core() - l1_base;
+    budget.in0_tile_size = tt::tile_size(in0_data_format);
+    budget.in1_tile_size = tt::tile_size(in1_data_format);
+    budget.out_tile_size = tt::tile_size(out_data_format);
+    budget.interm_tile_size = tt::tile_size(interm_data_format);
+    budget.interm_shares_output = interm_shares_output;
+    budget.out_buffering = out_buffering;
+    return budget;
+}
+
+uint32_t get_maximum_block_dim(int32_t block_dim, int32_t in0_block_w) {
+    return MatmulL1Budget{}.max_block_n(block_dim, in0_block_w);
 }
 
 inline float check_bfloat16_vector_pcc(const std::vector<bfloat16>& vec_a, const std::vector<bfloat16>& vec_b) {
@@ -111,8 +190,16 @@ constexpr std::array<std::tuple<uint32_t, uint32_t>, 20> SUBBLOCK_HW_CHOICES = {
     {5, 1}, {1, 5}, {2, 2}, {4, 1}, {1, 4}, {3, 1}, {1, 3}, {2, 1}, {1, 2}, {1, 1},
 }};
 
+// max_subblock_num_tiles: dst register에 한 번에 올릴 수 있는 output tile 수.
+// 16-bit dst는 8 tile, 32-bit dst (fp32_dest_acc_en, integer matmul)는 4 tile 이다.
 std::tuple<uint32_t, uint32_t, uint32_t, uint32_t> get_large_matmul_params(
-    uint32_t Mt, uint32_t Nt, uint32_t num_cores_y, uint32_t num_cores_x, uint32_t in0_block_w) {
+    uint32_t Mt,
+    uint32_t Nt,
+    uint32_t num_cores_y,
+    uint32_t num_cores_x,
+    uint32_t in0_block_w,
+    uint32_t max_subblock_num_tiles = 8,
+    const MatmulL1Budget& l1_budget = MatmulL1Budget{}) {
     auto Nt_fac = get_prime_factors(Nt);
     auto Mt_fac = get_prime_factors(Mt);
     uint32_t Npc_min = 1;
@@ -135,7 +222,7 @@ std::tuple<uint32_t, uint32_t, uint32_t, uint32_t> get_large_matmul_params(
         }
     }
 
-    if (Npc_min > get_maximum_block_dim(Mpc_min, in0_block_w)) {
+    if (Npc_min > l1_budget.max_block_n(Mpc_min, in0_block_w)) {
         return {0, 0, 0, 0};
     }
 
@@ -143,7 +230,7 @@ std::tuple<uint32_t, uint32_t, uint32_t, uint32_t> get_large_matmul_params(
     uint32_t Npc = Npc_min;
     if (Mpc_min > 1) {
         auto Npc_choices = get_possible_products(Nt_fac);
-        auto Npc_max = get_maximum_block_dim(Mpc_min, in0_block_w);
+        auto Npc_max = l1_budget.max_block_n(Mpc_min, in0_block_w);
         for (auto& ele : Npc_choices) {
             if (ele * Npc_min <= Npc_max) {
                 Npc = ele * Npc_min;
@@ -159,6 +246,9 @@ std::tuple<uint32_t, uint32_t, uint32_t, uint32_t> get_large_matmul_params(
         for (auto& subblock_hw : SUBBLOCK_HW_CHOICES) {
             auto subblock_h = std::get<0>(subblock_hw);
             auto subblock_w = std::get<1>(subblock_hw);
+            if (subblock_h * subblock_w > max_subblock_num_tiles) {
+                continue;
+            }
             if (Mpc % subblock_h == 0 and Npc % subblock_w == 0) {
                 return {Mpc, Npc, subblock_h, subblock_w};
             }
@@ -167,7 +257,7 @@ std::tuple<uint32_t, uint32_t, uint32_t, uint32_t> get_large_matmul_params(
 
     else if (Npc_min > 1) {
         auto Mpc_choices = get_possible_products(Mt_fac);
-        auto Mpc_max = get_maximum_block_dim(Npc_min, in0_block_w);
+        auto Mpc_max = l1_budget.max_block_m(Npc_min, in0_block_w);
         for (auto& ele : Mpc_choices) {
             if (ele * Mpc_min <= Mpc_max) {
                 Mpc = ele * Mpc_min;
@@ -183,6 +273,9 @@ std::tuple<uint32_t, uint32_t, uint32_t, uint32_t> get_large_matmul_params(
         for (auto& subblock_hw : SUBBLOCK_HW_CHOICES) {
             auto subblock_h = std::get<0>(subblock_hw);
             auto subblock_w = std::get<1>(subblock_hw);
+            if (subblock_h * subblock_w > max_subblock_num_tiles) {
+                continue;
+            }
             if (Mpc % subblock_h == 0 and Npc % subblock_w == 0) {
                 return {Mpc, Npc, subblock_h, subblock_w};
             }
@@ -193,7 +286,7 @@ std::tuple<uint32_t, uint32_t, uint32_t, uint32_t> get_large_matmul_params(
         auto Mpc_choices = get_possible_products(Mt_fac);
         auto Npc_choices = get_possible_products(Nt_fac);
         for (auto& Npc : Npc_choices) {
-            auto Mpc_max = get_maximum_block_dim(Npc, in0_block_w);
+            auto Mpc_max = l1_budget.max_block_m(Npc, in0_block_w);
             for (auto& ele : Mpc_choices) {
                 if (ele <= Mpc_max) {
                     Mpc = ele;
@@ -207,6 +300,9 @@ std::tuple<uint32_t, uint32_t, uint32_t, uint32_t> get_large_matmul_params(
             for (auto& subblock_hw : SUBBLOCK_HW_CHOICES) {
                 auto subblock_h = std::get<0>(subblock_hw);
                 auto subblock_w = std::get<1>(subblock_hw);
+                if (subblock_h * subblock_w > max_subblock_num_tiles) {
+                    continue;
+                }
                 if (Mpc % subblock_h == 0 and Npc % subblock_w == 0) {
                     return {Mpc, Npc, subblock_h, subblock_w};
                 }
@@ -217,6 +313,56 @@ std::tuple<uint32_t, uint32_t, uint32_t, uint32_t> get_large_matmul_params(
     return {0, 0, 0, 0};
 }
 
+/*
+    임의 크기 matmul 용 block 크기.
+
+    get_large_matmul_params가 Mt, Nt를 나누어 떨어지게 하는 분할을 찾으면 그대로 쓰고,
+    찾지 못하면 ({0, 0, 0, 0}) grid에 고르게 나눈 올림 크기를 쓴다. 이때 마지막 row / column의 block은
+    행렬 밖으로 나가며, compute는 유효한 tile을 덮는 sub-block만 계산한다. (create_matmul_padded_program 참고)
+    L1에 들어가지 않으면 block을 줄이고 core 하나가 block을 여러 개 처리한다.
+    1 x 1 tile block도 L1에 들어가지 않으면 {0, 0, 0, 0} 을 돌려준다.
+*/
+std::tuple<uint32_t, uint32_t, uint32_t, uint32_t> get_padded_matmul_params(
+    uint32_t Mt,
+    uint32_t Nt,
+    uint32_t num_cores_y,
+    uint32_t num_cores_x,
+    uint32_t in0_block_w,
+    uint32_t max_subblock_num_tiles = 8,
+    const MatmulL1Budget& l1_budget = MatmulL1Budget{}) {
+    auto params = get_large_matmul_params(
+        Mt, Nt, num_cores_y, num_cores_x, in0_block_w, max_subblock_num_tiles, l1_budget);
+    if (std::get<0>(params) != 0) {
+        return params;
+    }
+
+    uint32_t Mpc = (Mt + num_cores_y - 1) / num_cores_y;
+    uint32_t Npc = (Nt + num_cores_x - 1) / num_cores_x;
+    while (!l1_budget.fits(Mpc, Npc, in0_block_w)) {
+        if (Mpc == 1 && Npc == 1) {
+            return {0, 0, 0, 0};
+        }
+        if (Mpc >= Npc) {
+            Mpc = (Mpc + 1) / 2;
+        } else {
+            Npc = (Npc + 1) / 2;
+        }
+    }
+
+    for (auto& subblock_hw : SUBBLOCK_HW_CHOICES) {
+        auto subblock_h = std::get<0>(subblock_hw);
+        auto subblock_w = std::get<1>(subblock_hw);
+        if (subblock_h * subblock_w > max_subblock_num_tiles) {
+            continue;
+        }
+        if (Mpc % subblock_h == 0 and Npc % subblock_w == 0) {
+            return {Mpc, Npc, subblock_h, subblock_w};
+        }
+    }
+
+    return {Mpc, Npc, 1, 1};
+}
+
 CoreCoord get_core_range(
     uint32_t num_blocks_rows, uint32_t num_blocks_cols, uint32_t max_num_rows, uint32_t max_num_cols) {
     CoreCoord core_range(0, 0);
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <tt-metalium/work_split.hpp>
+
+#include <utility>
+#include <vector>
+
+#include "bmm_reuse_program.hpp"
+
+namespace bmm_op_utils {
+
+/*
+    임의 크기 matmul program. reader_bmm_tile_layout_padded / bmm_large_block_zm (RAGGED_BLOCKS) /
+    writer_bmm_tile_layout_padded 를 만든다. config 는 get_padded_matmul_params 로 고른다.
+
+    - Mt, Nt, Kt가 block 크기의 배수일 필요가 없다. 마지막 row / column block은 행렬 밖으로 나가고,
+      compute는 그 block에서 유효한 tile을 덮는 sub-block만 계산한다. sub-block 안의 모자란 tile과 K 방향의
+      모자란 tile은 reader가 DRAM에서 읽는 대신 0으로 채우고, writer는 행렬 밖의 output tile을 쓰지 않는다.
+      (tile 안쪽, 즉 32의 배수가 아닌 M / N / K 의 padding은 host가 tilize 할 때 한다.)
+    - B 개의 batch의 output block을 모두 모아 split_work_to_cores로 나눈다. core 하나가 block을 여러 개 처리할 수
+      있고, bmm_large_block_zm의 batch (compile time arg 11)를 core가 처리할 block 수로 쓰기 때문에 block 수가 다른
+      두 core group에 compute kernel을 따로 만든다. bcast_batch 이면 모든 batch가 같은 B (Kt x Nt) 를 쓴다.
+    - edge block이 c_24에 push 하는 양이 block마다 달라서 c_24를 c_16과 따로 만든다. (SEPARATE_INTERM_CB)
+      L1 사용량은 get_matmul_l1_budget(..., interm_shares_output = false) 로 확인한다.
+    - 모든 operand는 같은 data format의 interleaved DRAM buffer여야 한다.
+*/
+inline tt::tt_metal::Program create_matmul_padded_program(
+    const std::shared_ptr<tt::tt_metal::distributed::MeshBuffer>& src0_dram_buffer,
+    const std::shared_ptr<tt::tt_metal::distributed::MeshBuffer>& src1_dram_buffer,
+    const std::shared_ptr<tt::tt_metal::distributed::MeshBuffer>& dst_dram_buffer,
+    uint32_t Mt,
+    uint32_t Nt,
+    uint32_t Kt,
+    uint32_t B,
+    bool bcast_batch,
+    const MatmulBlockConfig& config,
+    tt::DataFormat data_format,
+    MathFidelity math_fidelity,
+    CoreCoord compute_with_storage_grid_size) {
+    using namespace tt::tt_metal;
+
+    Program program{};
+
+    uint32_t single_tile_size = tt::tile_size(data_format);
+
+    uint32_t per_core_M = config.per_core_M;
+    uint32_t per_core_N = config.per_core_N;
+    uint32_t in0_block_w = config.in0_block_w;
+    uint32_t out_subblock_h = config.out_subblock_h;
+    uint32_t out_subblock_w = config.out_subblock_w;
+
+    TT_FATAL(
+        per_core_M != 0 && per_core_N != 0 && in0_block_w != 0,
+        "No matmul block fits in L1 for Mt={}, Nt={}, Kt={}",
+        Mt,
+        Nt,
+        Kt);
+    TT_FATAL(
+        per_core_M % out_subblock_h == 0 && per_core_N % out_subblock_w == 0,
+        "Sub-block {}x{} does not divide block {}x{}",
+        out_subblock_h,
+        out_subblock_w,
+        per_core_M,
+        per_core_N);
+    TT_FATAL(
+        out_subblock_h * out_subblock_w <= 8, "Sub-block {}x{} does not fit in dst", out_subblock_h, out_subblock_w);
+
+    uint32_t num_blocks_y = (Mt + per_core_M - 1) / per_core_M;
+    uint32_t num_blocks_x = (Nt + per_core_N - 1) / per_core_N;
+    uint32_t num_k_blocks = (Kt + in0_block_w - 1) / in0_block_w;
+    uint32_t blocks_per_batch = num_blocks_y * num_blocks_x;
+
+    auto [num_cores, all_cores, core_group_1, core_group_2, blocks_per_core_1, blocks_per_core_2] =
+        split_work_to_cores(compute_with_storage_grid_size, B * blocks_per_batch);
+
+    uint32_t in0_num_subblocks = per_core_M / out_subblock_h;
+    uint32_t in0_block_num_tiles = per_core_M * in0_block_w;
+    uint32_t in0_subblock_num_tiles = out_subblock_h * in0_block_w;
+    uint32_t in1_num_subblocks = per_core_N / out_subblock_w;
+    uint32_t in1_block_num_tiles = per_core_N * in0_block_w;
+    uint32_t out_subblock_num_tiles = out_subblock_h * out_subblock_w;
+    uint32_t out_block_num_tiles = per_core_M * per_core_N;
+
+    auto compute_kernel_args = [&](uint32_t blocks_per_core) {
+        return std::vector<uint32_t>{
+            in0_block_w,             // in0_block_w
+            in0_num_subblocks,       // in0_num_subblocks
+            in0_block_num_tiles,     // in0_block_num_tiles
+            in0_subblock_num_tiles,  // in0_subblock_num_tiles
+
+            in1_num_subblocks,    // in1_num_subblocks
+            in1_block_num_tiles,  // in1_block_num_tiles
+            per_core_N,           // in1_per_core_w
+
+            num_k_blocks,  // num_blocks
+
+            out_subblock_h,          // out_subblock_h
+            out_subblock_w,          // out_subblock_w
+            out_subblock_num_tiles,  // out_subblock_num_tiles
+            blocks_per_core          // batch := 이 core가 처리할 output block 수
+        };
+    };
+
+    CreateCircularBuffer(
+        program,
+        all_cores,
+        CircularBufferConfig(in0_block_num_tiles * 2 * single_tile_size, {{tt::CBIndex::c_0, data_format}})
+            .set_page_size(tt::CBIndex::c_0, single_tile_size));  // double buffer
+    CreateCircularBuffer(
+        program,
+        all_cores,
+        CircularBufferConfig(in1_block_num_tiles * 2 * single_tile_size, {{tt::CBIndex::c_1, data_format}})
+            .set_page_size(tt::CBIndex::c_1, single_tile_size));  // double buffer
+    CreateCircularBuffer(
+        program,
+        all_cores,
+        CircularBufferConfig(out_block_num_tiles * single_tile_size, {{tt::CBIndex::c_16, data_format}})
+            .set_page_size(tt::CBIndex::c_16, single_tile_size));
+    CreateCircularBuffer(
+        program,
+        all_cores,
+        CircularBufferConfig(out_block_num_tiles * single_tile_size, {{tt::CBIndex::c_24, data_format}})
+            .set_page_size(tt::CBIndex::c_24, single_tile_size));
+
+    std::vector<uint32_t> reader_compile_time_args;
+    TensorAccessorArgs(*src0_dram_buffer).append_to(reader_compile_time_args);
+    TensorAccessorArgs(*src1_dram_buffer).append_to(reader_compile_time_args);
+
+    std::vector<uint32_t> writer_compile_time_args;
+    TensorAccessorArgs(*dst_dram_buffer).append_to(writer_compile_time_args);
+
+    auto reader_id = CreateKernel(
+        program,
+        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/matmul_common/kernels/reader_bmm_tile_layout_padded.cpp",
+        all_cores,
+        DataMovementConfig{
+            .processor = DataMovementProcessor::RISCV_1,
+            .noc = NOC::RISCV_1_default,
+            .compile_args = reader_compile_time_args});
+
+    auto writer_id = CreateKernel(
+        program,
+        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/matmul_common/kernels/writer_bmm_tile_layout_padded.cpp",
+        all_cores,
+        DataMovementConfig{
+            .processor = DataMovementProcessor::RISCV_0,
+            .noc = NOC::RISCV_0_default,
+            .compile_args = writer_compile_time_args});
+
+    auto work_groups = {
+        std::make_pair(core_group_1, blocks_per_core_1), std::make_pair(core_group_2, blocks_per_core_2)};
+    std::vector<KernelHandle> compute_ids;
+    for (const auto& [ranges, blocks_per_core] : work_groups) {
+        if (ranges.num_cores() == 0) {
+            compute_ids.push_back(0);
+            continue;
+        }
+        compute_ids.push_back(CreateKernel(
+            program,
+            OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/matmul_common/kernels/bmm_large_block_zm.cpp",
+            ranges,
+            ComputeConfig{
+                .math_fidelity = math_fidelity,
+                .compile_args = compute_kernel_args(blocks_per_core),
+                .defines = {{"RAGGED_BLOCKS", "1"}, {"SEPARATE_INTERM_CB", "1"}}}));
+    }
+
+    uint32_t block_offset = 0;
+    uint32_t group = 0;
+    for (const auto& [ranges, blocks_per_core] : work_groups) {
+        for (const auto& range : ranges.ranges()) {
+            for (const auto& core : range) {
+                SetRuntimeArgs(
+                    program,
+                    reader_id,
+                    core,
+                    {(std::uint32_t)src0_dram_buffer->address(),
+                     (std::uint32_t)src1_dram_buffer->address(),
+                     Mt,
+                     Kt,
+                     Nt,
+                     per_core_M,
+                     per_core_N,
+                     in0_block_w,
+                     num_k_blocks,
+                     num_blocks_x,
+                     block_offset,
+                     blocks_per_core,
+                     blocks_per_batch,
+                     bcast_batch ? 0 : Kt * Nt});
+                SetRuntimeArgs(
+                    program,
+                    writer_id,
+                    core,
+                    {(std::uint32_t)dst_dram_buffer->address(),
+                     Mt,
+                     Nt,
+                     per_core_M,
+                     per_core_N,
+                     out_subblock_h,
+                     out_subblock_w,
+                     num_blocks_x,
+                     block_offset,
+                     blocks_per_core,
+                     blocks_per_batch});
+                SetRuntimeArgs(
+                    program, compute_ids[group], core, {Mt, Nt, num_blocks_x, blocks_per_batch, block_offset});
+                block_offset += blocks_per_core;
+            }
+        }
+        group++;
+    }
+
+    return program;
+}
+
+}  // namespace bmm_op_utils
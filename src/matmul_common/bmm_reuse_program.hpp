@@ -0,0 +1,977 @@
+#pragma once
+
+#include <tt-metalium/host_api.hpp>
+#include <tt-metalium/constants.hpp>
+#include <tt-metalium/tt_metal.hpp>
+#include <tt-metalium/tensor_accessor_args.hpp>
+#include <tt-metalium/distributed.hpp>
+#include <tt-metalium/hal.hpp>
+#include <tt-metalium/bfloat16.hpp>
+#include <tt-metalium/tilize_utils.hpp>
+#include <tt-metalium/bfloat8.hpp>
+#include <tt-metalium/bfloat4.hpp>
+#include <tt_stl/span.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <map>
+#include <string>
+
+#include <fmt/core.h>
+
+#include "bmm_op.hpp"
+
+#ifndef OVERRIDE_KERNEL_PREFIX
+#define OVERRIDE_KERNEL_PREFIX ""
+#endif
+
+namespace bmm_op_utils {
+
+// matmul_multicore_reuse 의 block 분할 한 벌. get_large_matmul_params는 in0_block_w를 고정으로 두지만
+// autotuner는 in0_block_w도 같이 고른다.
+struct MatmulBlockConfig {
+    uint32_t per_core_M = 0;
+    uint32_t per_core_N = 0;
+    uint32_t in0_block_w = 0;
+    uint32_t out_subblock_h = 0;
+    uint32_t out_subblock_w = 0;
+};
+
+inline bool operator==(const MatmulBlockConfig& a, const MatmulBlockConfig& b) {
+    return a.per_core_M == b.per_core_M && a.per_core_N == b.per_core_N && a.in0_block_w == b.in0_block_w &&
+           a.out_subblock_h == b.out_subblock_h && a.out_subblock_w == b.out_subblock_w;
+}
+
+/*
+    operand 별 data format. in0 / in1 은 Bfp8_b, Bfp4_b 처럼 block floating point로 두어 DRAM / NoC / L1 bytes를
+    줄이고, output (c_16) 은 out 형식으로 둔다. tt::DataFormat 하나만 주면 모두 같은 형식이다.
+    interm (c_24, K block 사이의 partial) 은 기본으로 out과 같고, Float32로 두면 fp32_dest_acc_en 으로 돌린다.
+    integer matmul (UInt8 / Int8 입력) 은 interm 을 UInt32 / Int32 로 두고 같은 32-bit dst를 쓴다.
+    이때 dst는 32-bit tile을 절반 (4개) 만 담으므로 sub-block은 4 tile 이하여야 한다. (MatmulDataFormats::max_subblock_num_tiles)
+*/
+struct MatmulDataFormats {
+    tt::DataFormat in0 = tt::DataFormat::Float16_b;
+    tt::DataFormat in1 = tt::DataFormat::Float16_b;
+    tt::DataFormat out = tt::DataFormat::Float16_b;
+    tt::DataFormat interm = tt::DataFormat::Float16_b;
+
+    MatmulDataFormats(tt::DataFormat data_format) :
+        in0(data_format), in1(data_format), out(data_format), interm(data_format) {}
+    MatmulDataFormats(tt::DataFormat in0, tt::DataFormat in1, tt::DataFormat out) :
+        in0(in0), in1(in1), out(out), interm(out) {}
+    MatmulDataFormats(tt::DataFormat in0, tt::DataFormat in1, tt::DataFormat out, tt::DataFormat interm) :
+        in0(in0), in1(in1), out(out), interm(interm) {}
+
+    bool fp32_dest_acc_en() const {
+        return interm == tt::DataFormat::Float32 || interm == tt::DataFormat::UInt32 || interm == tt::DataFormat::Int32;
+    }
+    uint32_t max_subblock_num_tiles() const { return fp32_dest_acc_en() ? 4 : 8; }
+};
+
+// bmm_large_block_zm의 FUSE_ACTIVATION 값
+enum class MatmulActivation : uint32_t { NONE = 0, RELU = 1, GELU = 2, SILU = 3 };
+
+// integer matmul 결과를 pack 하기 전에 dst에서 mod q로 reduce 한다. (MOD_EPILOGUE, mod_op_utils::get_barrett_params)
+struct MatmulModReduce {
+    uint32_t q = 0;  // 0 이면 끈다.
+    uint32_t q_bits = 0;
+    uint32_t mu = 0;
+};
+
+// out = activation(scale * (A * B) + bias). pack 하기 전 dst에서 계산한다. (bmm_large_block_zm.cpp 참고)
+struct MatmulEpilogue {
+    bool fuse_bias = false;
+    MatmulActivation activation = MatmulActivation::NONE;
+    float scale = 1.0f;
+    MatmulModReduce mod{};
+
+    bool enabled() const { return fuse_bias || activation != MatmulActivation::NONE || scale != 1.0f || mod.q != 0; }
+};
+
+inline std::map<std::string, std::string> get_matmul_epilogue_defines(const MatmulEpilogue& epilogue) {
+    std::map<std::string, std::string> defines;
+    if (epilogue.scale != 1.0f) {
+        defines["FUSE_SCALE"] = fmt::format("0x{:08x}u", std::bit_cast<uint32_t>(epilogue.scale));
+    }
+    if (epilogue.fuse_bias) {
+        defines["FUSE_BIAS"] = "1";
+    }
+    if (epilogue.activation != MatmulActivation::NONE) {
+        defines["FUSE_ACTIVATION"] = std::to_string(static_cast<uint32_t>(epilogue.activation));
+    }
+    if (epilogue.mod.q != 0) {
+        defines["MOD_EPILOGUE"] = "1";
+    }
+    return defines;
+}
+
+/*
+    길이 N 의 bias를 fused epilogue가 쓰는 tile 형태로 만든다. bias row를 32번 반복한 32 x N 행렬을 tilize 하므로
+    tile (0, j) 의 모든 row가 bias[32j .. 32j + 31] 이다. dst에 그대로 더하면 row broadcast가 된다.
+*/
+inline std::vector<bfloat16> make_matmul_bias_tiles(const std::vector<bfloat16>& bias, uint32_t N) {
+    std::vector<bfloat16> rows(tt::constants::TILE_HEIGHT * N);
+    for (uint32_t r = 0; r < tt::constants::TILE_HEIGHT; r++) {
+        std::copy(bias.begin(), bias.begin() + N, rows.begin() + r * N);
+    }
+    return tilize_nfaces(rows, tt::constants::TILE_HEIGHT, N);
+}
+
+/*
+    tilize_nfaces 로 tile 순서가 된 operand (float 또는 bfloat16) 를 data_format의 DRAM tile로 pack 한다.
+    Bfp8_b / Bfp4_b 는 16개 값이 exponent 하나를 같이 쓰는 block floating point이므로 host에서 미리 만들어야 한다.
+    tile 크기: Float16_b 2048B, Bfp8_b 1088B, Bfp4_b 576B.
+*/
+template <typename T>
+inline std::vector<uint32_t> pack_matmul_operand_tiles(const std::vector<T>& tiles, tt::DataFormat data_format) {
+    tt::stl::Span<const T> span(tiles.data(), tiles.size());
+    switch (data_format) {
+        case tt::DataFormat::Float16_b: {
+            std::vector<bfloat16> bf16_tiles(tiles.begin(), tiles.end());
+            return pack_bfloat16_vec_into_uint32_vec(bf16_tiles);
+        }
+        case tt::DataFormat::Bfp8_b: return pack_as_bfp8_tiles(span, /*row_major_input=*/false, /*is_exp_a=*/false);
+        case tt::DataFormat::Bfp4_b: return pack_as_bfp4_tiles(span, /*row_major_input=*/false, /*is_exp_a=*/false);
+        default: TT_THROW("Unsupported matmul operand data format {}", static_cast<int>(data_format));
+    }
+}
+
+/*
+    pack_matmul_operand_tiles 의 반대. data_format (Float16_b / Float32 / Bfp8_b / Bfp4_b) 의 Mt x Nt tile output을
+    읽어서 row-major bfloat16 (untilize 된 Mt*32 x Nt*32) 으로 돌려준다. PCC를 output 형식과 상관없이 비교할 때 쓴다.
+*/
+inline std::vector<bfloat16> read_matmul_output_tiles(
+    tt::tt_metal::distributed::MeshCommandQueue& cq,
+    const std::shared_ptr<tt::tt_metal::distributed::MeshBuffer>& buffer,
+    uint32_t Mt,
+    uint32_t Nt,
+    tt::DataFormat data_format) {
+    using namespace tt::tt_metal;
+    uint32_t M = Mt * tt::constants::TILE_HEIGHT;
+    uint32_t N = Nt * tt::constants::TILE_WIDTH;
+    std::vector<float> tiles;
+    switch (data_format) {
+        case tt::DataFormat::Float16_b: {
+            std::vector<bfloat16> bf16_tiles(M * N);
+            distributed::EnqueueReadMeshBuffer(cq, bf16_tiles, buffer, true);
+            return untilize_nfaces(bf16_tiles, M, N);
+        }
+        case tt::DataFormat::Float32: {
+            tiles.resize(M * N);
+            distributed::EnqueueReadMeshBuffer(cq, tiles, buffer, true);
+            break;
+        }
+        case tt::DataFormat::Bfp8_b:
+        case tt::DataFormat::Bfp4_b: {
+            std::vector<uint32_t> packed(Mt * Nt * tt::tile_size(data_format) / sizeof(uint32_t));
+            distributed::EnqueueReadMeshBuffer(cq, packed, buffer, true);
+            tt::stl::Span<const uint32_t> span(packed.data(), packed.size());
+            tiles = data_format == tt::DataFormat::Bfp8_b
+                        ? unpack_bfp8_tiles_into_float_vec(span, /*row_major_output=*/false, /*is_exp_a=*/false)
+                        : unpack_bfp4_tiles_into_float_vec(span, /*row_major_output=*/false, /*is_exp_a=*/false);
+            break;
+        }
+        default: TT_THROW("Unsupported matmul output data format {}", static_cast<int>(data_format));
+    }
+    tiles = untilize_nfaces(tiles, M, N);
+    return std::vector<bfloat16>(tiles.begin(), tiles.end());
+}
+
+/*
+    weight-stationary matmul 용 B 배치.
+
+    create_matmul_multicore_reuse_program 은 i 번째 output block (row-major, (output_idx_y, output_idx_x)) 을
+    core (i % grid.x, i / grid.x) 에 둔다. core i 는 B 의 column block output_idx_x (Kt x per_core_N tiles) 만 쓰므로
+    그 slice를 core i 의 L1에 한 번 올려 두면 이후 launch 에서는 A만 DRAM에서 읽으면 된다.
+    같은 column의 core들은 같은 slice를 각자 가진다.
+
+    make_matmul_resident_in1_tiles: tilize 된 B (Kt x Nt tiles) 를 core 순서대로 slice를 이어 붙인 형태로 바꾼다.
+    slice 안은 reader_bmm_tile_layout 이 c_1에 쓰는 순서 (K block 순서, block 안은 row-major) 와 같으므로
+    K 방향으로 row-major 인 Kt x per_core_N tile 이다.
+    create_matmul_resident_in1_buffer: core 하나당 shard 하나 (Kt * per_core_N tiles) 인 height-sharded L1 buffer.
+*/
+template <typename T>
+inline std::vector<T> make_matmul_resident_in1_tiles(
+    const std::vector<T>& in1_tiles, uint32_t Mt, uint32_t Nt, uint32_t Kt, const MatmulBlockConfig& config) {
+    constexpr uint32_t tile_elems = tt::constants::TILE_HW;
+    uint32_t num_blocks_y = Mt / config.per_core_M;
+    uint32_t num_blocks_x = Nt / config.per_core_N;
+
+    std::vector<T> resident;
+    resident.reserve((size_t)num_blocks_y * num_blocks_x * Kt * config.per_core_N * tile_elems);
+    for (uint32_t block = 0; block < num_blocks_y * num_blocks_x; block++) {
+        uint32_t output_idx_x = block % num_blocks_x;
+        for (uint32_t k = 0; k < Kt; k++) {
+            for (uint32_t w = 0; w < config.per_core_N; w++) {
+                size_t tile_id = (size_t)k * Nt + output_idx_x * config.per_core_N + w;
+                resident.insert(
+                    resident.end(),
+                    in1_tiles.begin() + tile_id * tile_elems,
+                    in1_tiles.begin() + (tile_id + 1) * tile_elems);
+            }
+        }
+    }
+    return resident;
+}
+
+inline std::shared_ptr<tt::tt_metal::distributed::MeshBuffer> create_matmul_resident_in1_buffer(
+    tt::tt_metal::distributed::MeshDevice* mesh_device,
+    uint32_t Mt,
+    uint32_t Nt,
+    uint32_t Kt,
+    const MatmulBlockConfig& config,
+    tt::DataFormat in1_data_format,
+    CoreCoord compute_with_storage_grid_size) {
+    using namespace tt::tt_metal;
+
+    uint32_t num_blocks_total = (Mt / config.per_core_M) * (Nt / config.per_core_N);
+    uint32_t shard_tiles = Kt * config.per_core_N;
+    uint32_t single_tile_size = tt::tile_size(in1_data_format);
+    CoreRangeSet all_cores(num_cores_to_corerangeset(num_blocks_total, compute_with_storage_grid_size, true));
+
+    // shard 하나 = tile column 하나 (shard_tiles x 1 tiles). ROW_MAJOR 이므로 shard i 가 core i 에 간다.
+    ShardSpecBuffer shard_spec(
+        all_cores,
+        {shard_tiles * tt::constants::TILE_HEIGHT, tt::constants::TILE_WIDTH},
+        ShardOrientation::ROW_MAJOR,
+        {tt::constants::TILE_HEIGHT, tt::constants::TILE_WIDTH},
+        {num_blocks_total * shard_tiles, 1});
+    distributed::DeviceLocalBufferConfig l1_config{
+        .page_size = single_tile_size,
+        .buffer_type = BufferType::L1,
+        .sharding_args = BufferShardingArgs(shard_spec, TensorMemoryLayout::HEIGHT_SHARDED)};
+    distributed::ReplicatedBufferConfig buffer_config{
+        .size = (uint64_t)single_tile_size * num_blocks_total * shard_tiles};
+    return distributed::MeshBuffer::create(buffer_config, l1_config, mesh_device);
+}
+
+/*
+    ROW_MAJOR_IO 용 DRAM buffer. tilize 하지 않은 rows x cols bfloat16 행렬을 그대로 담고 page 하나가 행렬 row 하나이다.
+    rows, cols는 32의 배수여야 한다. reader / writer는 block 폭 (tile 수 x 64B) 의 row 조각을 NoC transaction
+    하나로 옮기므로 DRAM alignment가 64B 이하이면 된다. (Wormhole 32B, Blackhole 64B)
+*/
+inline std::shared_ptr<tt::tt_metal::distributed::MeshBuffer> create_matmul_row_major_buffer(
+    tt::tt_metal::distributed::MeshDevice* mesh_device, uint32_t rows, uint32_t cols) {
+    using namespace tt::tt_metal;
+
+    TT_FATAL(
+        rows % tt::constants::TILE_HEIGHT == 0 && cols % tt::constants::TILE_WIDTH == 0,
+        "Row-major matmul operand {}x{} is not a multiple of the tile size",
+        rows,
+        cols);
+    uint32_t row_bytes = cols * sizeof(bfloat16);
+    distributed::DeviceLocalBufferConfig dram_config{.page_size = row_bytes, .buffer_type = BufferType::DRAM};
+    distributed::ReplicatedBufferConfig buffer_config{.size = (uint64_t)rows * row_bytes};
+    return distributed::MeshBuffer::create(buffer_config, dram_config, mesh_device);
+}
+
+/*
+    L1 sharded matmul operand. 앞 matmul의 output을 DRAM에 쓰지 않고 shard로 L1에 둔 채 다음 matmul의 input으로 쓴다.
+    block_grid 는 이 operand를 쓰는 matmul의 output block grid (Nt / per_core_N, Mt / per_core_M) 이고 shard는
+    그 core들에 나뉜다. rows_tiles x cols_tiles 는 operand의 크기 (in0: Mt x Kt, in1: Kt x Nt, out: Mt x Nt) 이다.
+    - HEIGHT_SHARDED : core i 가 row 방향 i 번째 shard (rows / num_cores x cols)
+    - WIDTH_SHARDED  : core i 가 column 방향 i 번째 shard (rows x cols / num_cores)
+    - BLOCK_SHARDED  : core (x, y) 가 shard (y, x) (rows / block_grid.y x cols / block_grid.x)
+    core i 는 create_matmul_multicore_reuse_program 이 output block i 를 두는 core (i % grid.x, i / grid.x) 이고,
+    BLOCK_SHARDED 를 쓰면 program도 output block (y, x) 를 core (x, y) 에 둔다. page는 tile이고 host data는
+    tilize_nfaces 순서 그대로 쓰고 읽는다.
+*/
+inline std::shared_ptr<tt::tt_metal::distributed::MeshBuffer> create_matmul_sharded_buffer(
+    tt::tt_metal::distributed::MeshDevice* mesh_device,
+    tt::tt_metal::TensorMemoryLayout layout,
+    uint32_t rows_tiles,
+    uint32_t cols_tiles,
+    CoreCoord block_grid,
+    tt::DataFormat data_format,
+    CoreCoord compute_with_storage_grid_size) {
+    using namespace tt::tt_metal;
+
+    // operand를 row / column 방향으로 몇 개의 shard로 나누는지
+    uint32_t num_cores = block_grid.x * block_grid.y;
+    uint32_t num_shards_h = 1;
+    uint32_t num_shards_w = 1;
+    CoreRangeSet cores;
+    switch (layout) {
+        case TensorMemoryLayout::HEIGHT_SHARDED:
+            num_shards_h = num_cores;
+            cores = num_cores_to_corerangeset(num_cores, compute_with_storage_grid_size, true);
+            break;
+        case TensorMemoryLayout::WIDTH_SHARDED:
+            num_shards_w = num_cores;
+            cores = num_cores_to_corerangeset(num_cores, compute_with_storage_grid_size, true);
+            break;
+        case TensorMemoryLayout::BLOCK_SHARDED:
+            num_shards_h = block_grid.y;
+            num_shards_w = block_grid.x;
+            cores = CoreRangeSet(CoreRange({0, 0}, {block_grid.x - 1, block_grid.y - 1}));
+            break;
+        default: TT_THROW("Unsupported matmul shard layout {}", static_cast<int>(layout));
+    }
+    TT_FATAL(
+        rows_tiles % num_shards_h == 0 && cols_tiles % num_shards_w == 0,
+        "{}x{} tiles do not split into {}x{} shards",
+        rows_tiles,
+        cols_tiles,
+        num_shards_h,
+        num_shards_w);
+    uint32_t shard_rows = rows_tiles / num_shards_h;
+    uint32_t shard_cols = cols_tiles / num_shards_w;
+
+    uint32_t single_tile_size = tt::tile_size(data_format);
+    ShardSpecBuffer shard_spec(
+        cores,
+        {shard_rows * tt::constants::TILE_HEIGHT, shard_cols * tt::constants::TILE_WIDTH},
+        ShardOrientation::ROW_MAJOR,
+        {tt::constants::TILE_HEIGHT, tt::constants::TILE_WIDTH},
+        {rows_tiles, cols_tiles});
+    distributed::DeviceLocalBufferConfig l1_config{
+        .page_size = single_tile_size,
+        .buffer_type = BufferType::L1,
+        .sharding_args = BufferShardingArgs(shard_spec, layout)};
+    distributed::ReplicatedBufferConfig buffer_config{.size = (uint64_t)single_tile_size * rows_tiles * cols_tiles};
+    return distributed::MeshBuffer::create(buffer_config, l1_config, mesh_device);
+}
+
+// L1에 shard 된 operand이면 그 layout, DRAM 이나 interleaved 이면 INTERLEAVED.
+inline tt::tt_metal::TensorMemoryLayout get_matmul_operand_layout(
+    const std::shared_ptr<tt::tt_metal::distributed::MeshBuffer>& buffer) {
+    using namespace tt::tt_metal;
+    if (!buffer) {
+        return TensorMemoryLayout::INTERLEAVED;
+    }
+    const Buffer& reference = *buffer->get_reference_buffer();
+    return reference.buffer_type() == BufferType::L1 ? reference.buffer_layout() : TensorMemoryLayout::INTERLEAVED;
+}
+
+/*
+    c_0 / c_1 을 operand의 shard 위에 만들 때 (IN0_SHARDED, sharded in1) 쓰는 확인. core i 의 shard가 core i 의
+    output block이 쓰는 block 전체 (shard_rows_tiles x shard_cols_tiles) 여야 하므로 shard shape, core grid와
+    orientation (ROW_MAJOR) 이 cores (output block i 를 두는 core들) 와 같아야 한다.
+*/
+inline void validate_matmul_block_shard(
+    const std::shared_ptr<tt::tt_metal::distributed::MeshBuffer>& buffer,
+    uint32_t shard_rows_tiles,
+    uint32_t shard_cols_tiles,
+    const CoreRangeSet& cores,
+    const char* operand) {
+    using namespace tt::tt_metal;
+    const auto shard_spec = buffer->get_reference_buffer()->shard_spec();
+    auto shape = shard_spec.shape();
+    TT_FATAL(
+        shape[0] == shard_rows_tiles * tt::constants::TILE_HEIGHT &&
+            shape[1] == shard_cols_tiles * tt::constants::TILE_WIDTH,
+        "{} shard is {}x{}, expected {}x{} to cover one output block",
+        operand,
+        shape[0],
+        shape[1],
+        shard_rows_tiles * tt::constants::TILE_HEIGHT,
+        shard_cols_tiles * tt::constants::TILE_WIDTH);
+    TT_FATAL(
+        shard_spec.grid() == cores && shard_spec.orientation() == ShardOrientation::ROW_MAJOR,
+        "{} shards must sit row-major on the cores that run the output blocks ({})",
+        operand,
+        cores.str());
+}
+
+/*
+    output block을 core에 두는 순서와 core 별 K block 순서.
+    interleaved DRAM buffer의 tile t 는 bank (t mod bank 수) 에 있다. 기본 순서 (output block i 를 core i 에 row-major
+    로 두고 모든 core가 K block 0 부터 읽음) 에서는 같은 block row의 core들이 같은 A tile을, 같은 block column의
+    core들이 같은 B tile을 같은 때에 읽는다. 동시에 나가는 요청이 몇 개의 bank와 그 bank로 가는 NoC link에 몰린다.
+    - raster_group_h  : block row raster_group_h 개를 한 묶음으로 하고, 묶음 안에서는 column 방향으로 block을
+                        core에 둔다. core row 하나 (같은 NoC row link를 쓰는 core들) 에 여러 block row가 섞인다.
+                        0 이면 row-major. (get_matmul_block_order)
+    - rotate_k_blocks : core i 는 K block (i mod num_blocks) 부터 돌아서 읽는다. 같은 때에 core마다 다른 K block,
+                        즉 다른 bank의 tile을 읽는다. 누적 순서만 바뀐다. (BANK_ROTATE)
+*/
+struct MatmulBlockSchedule {
+    uint32_t raster_group_h = 0;
+    bool rotate_k_blocks = false;
+};
+
+// core i 가 맡는 output block (output_idx_y, output_idx_x). MatmulBlockSchedule::raster_group_h 참고.
+inline std::vector<std::pair<uint32_t, uint32_t>> get_matmul_block_order(
+    uint32_t num_blocks_y, uint32_t num_blocks_x, uint32_t raster_group_h) {
+    std::vector<std::pair<uint32_t, uint32_t>> order;
+    order.reserve(num_blocks_y * num_blocks_x);
+    if (raster_group_h == 0) {
+        raster_group_h = 1;  // 묶음 하나가 block row 하나이면 row-major 순서이다.
+    }
+    for (uint32_t group_start = 0; group_start < num_blocks_y; group_start += raster_group_h) {
+        uint32_t group_end = std::min(group_start + raster_group_h, num_blocks_y);
+        for (uint32_t x = 0; x < num_blocks_x; x++) {
+            for (uint32_t y = group_start; y < group_end; y++) {
+                order.push_back({y, x});
+            }
+        }
+    }
+    return order;
+}
+
+/*
+    batch를 core에 나눌 때 core 하나가 맡는 batch 수. B * num_blocks_total 이 core 수 이하이면 1 (batch 하나 당
+    core 하나) 이고, 아니면 (B / batch_per_core) * num_blocks_total 이 core 수 이하가 되는 가장 작은 B의 약수이다.
+    compute kernel은 batch 수를 compile time arg로 받으므로 모든 core가 같은 수를 맡도록 약수만 쓴다.
+*/
+inline uint32_t get_matmul_batch_per_core(
+    uint32_t B, uint32_t num_blocks_total, CoreCoord compute_with_storage_grid_size) {
+    uint32_t num_cores = compute_with_storage_grid_size.x * compute_with_storage_grid_size.y;
+    for (uint32_t batch_per_core = 1; batch_per_core < B; batch_per_core++) {
+        if (B % batch_per_core == 0 && (B / batch_per_core) * num_blocks_total <= num_cores) {
+            return batch_per_core;
+        }
+    }
+    return B;
+}
+
+/*
+    create_matmul_multicore_reuse_program 의 선택 사항. 기본값이면 matmul_multicore_reuse 와 같은 program 이다.
+    designated initializer로 필요한 것만 준다. 예) {.double_buffer_output = true, .transpose_in1 = true}
+*/
+struct MatmulProgramOptions {
+    // pack 하기 전 dst에서 계산하는 epilogue (FUSE_* / MOD_EPILOGUE)
+    MatmulEpilogue epilogue{};
+    // epilogue.fuse_bias 일 때 make_matmul_bias_tiles 로 만든 Nt 개의 bias tile
+    std::shared_ptr<tt::tt_metal::distributed::MeshBuffer> bias_buffer = nullptr;
+    // c_16을 output block 2개 크기로 잡는다. L1에 들어가지 않으면 single buffer로 돌린다.
+    bool double_buffer_output = false;
+    // B slice를 둔 L1 buffer (create_matmul_resident_in1_buffer). 주면 weight-stationary (IN1_L1_RESIDENT)
+    std::shared_ptr<tt::tt_metal::distributed::MeshBuffer> resident_in1_buffer = nullptr;
+    // core 하나가 맡는 연속된 batch 수. 0 이면 모든 core가 B 전체를 돈다. (get_matmul_batch_per_core)
+    uint32_t batch_per_core = 0;
+    // src0 을 Kt x Mt tiles 로 보고 src0^T * B 를 계산한다. (TRANSPOSE_IN0)
+    bool transpose_in0 = false;
+    // src1 을 Nt x Kt tiles 로 보고 A * src1^T 를 계산한다. (TRANSPOSE_IN1)
+    bool transpose_in1 = false;
+    // src0 / src1 / dst 가 row-major bfloat16 DRAM buffer (create_matmul_row_major_buffer) 이다. (ROW_MAJOR_IO)
+    bool row_major_io = false;
+    // output block을 core에 두는 순서와 core 별 K block 순서 (MatmulBlockSchedule)
+    MatmulBlockSchedule schedule{};
+};
+
+/*
+    matmul_multicore_reuse 와 같은 program (reader_bmm_tile_layout / bmm_large_block_zm / writer_bmm_tile_layout)
+    을 주어진 block 분할로 만든다. output block 하나당 core 하나를 쓰므로 (Mt / per_core_M) * (Nt / per_core_N) 가
+    grid 안에 들어가야 한다. autotuner가 후보 분할마다 program을 다시 만들 때 쓴다.
+
+    data format
+    - CB 크기와 page size는 operand 별 tile 크기로 계산한다.
+    - in1 과 interm 이 다르면 RELOAD_RECONFIG_DF, out 과 interm 이 다르면 PACK_RECONFIG_DF 를 켠다.
+    - interm 이 Float32 / UInt32 / Int32 이면 fp32_dest_acc_en 으로 돌리고 c_24는 dst로 바로 unpack
+      (UnpackToDestFp32) 해서 spill / reload 에서 srcA (19-bit) 를 거치며 값이 잘리지 않는다.
+    - double_buffer_output, interm != out, row_major_io 이면 c_24를 c_16과 따로 만든다. (SEPARATE_INTERM_CB)
+
+    options (MatmulProgramOptions)
+    - epilogue.mod : UInt32 결과를 pack 하기 전에 Barrett reduction 한다. (1-tile sub-block)
+    - double_buffer_output : L1은 MatmulL1Budget{.interm_shares_output = false, .out_buffering = 2} 로 확인한다.
+    - resident_in1_buffer : c_1은 그 L1 buffer 위에 만들어지고 reader는 B를 DRAM에서 읽지 않는다.
+      이때 src1_dram_buffer 는 nullptr 이어도 된다.
+    - batch_per_core : (batch group, output block) 을 core에 나눈다. core 수는 (B / batch_per_core) * num_blocks_total.
+    - transpose_in0 / transpose_in1 : host에서 전치하지 않는다. reader는 stride만 바꿔 tile 순서를 맞추고
+      tile 안의 전치는 compute가 한다. TRANSPOSE_IN0 은 A block을 c_5에 두므로 in0 block 하나만큼 L1을 더 쓰고,
+      in0 / interm 이 output과 같은 형식이어야 한다.
+    - row_major_io : reader / writer는 block의 행렬 row 하나 (block 폭 x 64B) 를 NoC transaction 하나로 옮기고
+      compute가 tilize / pack_untilize 한다. tilize 한 block을 c_6 / c_7 에 두므로 in0 / in1 block 하나씩 L1을
+      더 쓴다. 전치된 operand와는 같이 쓰지 않는다.
+    - schedule : core가 자기 L1의 block을 쓰는 경우 (weight-stationary, IN0_SHARDED, BLOCK_SHARDED) 는
+      순서를 바꿀 수 없다.
+
+    sharded operand (create_matmul_sharded_buffer, B == 1)
+    - reader / writer는 TensorAccessor로 page가 있는 core를 찾으므로 DRAM 대신 shard에서 읽고 쓴다.
+    - in0 HEIGHT_SHARDED, num_blocks_x == 1 : c_0을 shard (per_core_M x Kt) 위에 만든다. (IN0_SHARDED)
+    - in1 WIDTH_SHARDED, num_blocks_y == 1  : shard (Kt x per_core_N) 를 resident_in1_buffer 로 쓴다.
+    - BLOCK_SHARDED operand가 있으면 output block (y, x) 를 core (x, y) 에 둔다.
+*/
+inline tt::tt_metal::Program create_matmul_multicore_reuse_program(
+    const std::shared_ptr<tt::tt_metal::distributed::MeshBuffer>& src0_dram_buffer,
+    const std::shared_ptr<tt::tt_metal::distributed::MeshBuffer>& src1_dram_buffer,
+    const std::shared_ptr<tt::tt_metal::distributed::MeshBuffer>& dst_dram_buffer,
+    uint32_t Mt,
+    uint32_t Nt,
+    uint32_t Kt,
+    uint32_t B,
+    bool bcast_batch,
+    const MatmulBlockConfig& config,
+    const MatmulDataFormats& data_formats,
+    MathFidelity math_fidelity,
+    CoreCoord compute_with_storage_grid_size,
+    const MatmulProgramOptions& options = MatmulProgramOptions{}) {
+    using namespace tt::tt_metal;
+
+    const auto& epilogue = options.epilogue;
+    const auto& bias_dram_buffer = options.bias_buffer;
+    bool double_buffer_output = options.double_buffer_output;
+    const auto& resident_in1_buffer = options.resident_in1_buffer;
+    uint32_t batch_per_core = options.batch_per_core;
+    bool transpose_in0 = options.transpose_in0;
+    bool transpose_in1 = options.transpose_in1;
+    bool row_major_io = options.row_major_io;
+    const auto& schedule = options.schedule;
+
+    Program program{};
+
+    uint32_t in0_single_tile_size = tt::tile_size(data_formats.in0);
+    uint32_t in1_single_tile_size = tt::tile_size(data_formats.in1);
+    uint32_t out_single_tile_size = tt::tile_size(data_formats.out);
+    uint32_t interm_single_tile_size = tt::tile_size(data_formats.interm);
+    uint32_t num_cores_x = compute_with_storage_grid_size.x;
+
+    uint32_t per_core_M = config.per_core_M;
+    uint32_t per_core_N = config.per_core_N;
+    uint32_t in0_block_w = config.in0_block_w;
+    uint32_t out_subblock_h = config.out_subblock_h;
+    uint32_t out_subblock_w = config.out_subblock_w;
+
+    TT_FATAL(
+        Mt % per_core_M == 0 && Nt % per_core_N == 0 && Kt % in0_block_w == 0,
+        "Block config ({}, {}, {}) does not divide Mt={}, Nt={}, Kt={}",
+        per_core_M,
+        per_core_N,
+        in0_block_w,
+        Mt,
+        Nt,
+        Kt);
+    TT_FATAL(
+        per_core_M % out_subblock_h == 0 && per_core_N % out_subblock_w == 0,
+        "Sub-block {}x{} does not divide block {}x{}",
+        out_subblock_h,
+        out_subblock_w,
+        per_core_M,
+        per_core_N);
+    TT_FATAL(
+        out_subblock_h * out_subblock_w <= data_formats.max_subblock_num_tiles(),
+        "Sub-block {}x{} does not fit in dst ({} tiles)",
+        out_subblock_h,
+        out_subblock_w,
+        data_formats.max_subblock_num_tiles());
+
+    uint32_t num_blocks_y = Mt / per_core_M;
+    uint32_t num_blocks_x = Nt / per_core_N;
+    uint32_t num_blocks_total = num_blocks_y * num_blocks_x;
+
+    auto in0_layout = get_matmul_operand_layout(src0_dram_buffer);
+    auto in1_layout = get_matmul_operand_layout(src1_dram_buffer);
+    auto out_layout = get_matmul_operand_layout(dst_dram_buffer);
+    bool block_placement = in0_layout == TensorMemoryLayout::BLOCK_SHARDED ||
+                           in1_layout == TensorMemoryLayout::BLOCK_SHARDED ||
+                           out_layout == TensorMemoryLayout::BLOCK_SHARDED;
+    if (in0_layout != TensorMemoryLayout::INTERLEAVED || in1_layout != TensorMemoryLayout::INTERLEAVED ||
+        out_layout != TensorMemoryLayout::INTERLEAVED) {
+        TT_FATAL(B == 1, "Sharded matmul operands hold a single batch (B = {})", B);
+        TT_FATAL(!row_major_io, "Row-major matmul operands must be interleaved in DRAM");
+        TT_FATAL(!block_placement || !resident_in1_buffer, "Weight-stationary matmul places output blocks row-major");
+    }
+    // core 자신의 shard가 in0 / in1 block 전체인 경우 (위 설명 참고)
+    bool in0_sharded = in0_layout == TensorMemoryLayout::HEIGHT_SHARDED && num_blocks_x == 1 && !block_placement &&
+                       !transpose_in0;
+    bool in1_sharded = in1_layout == TensorMemoryLayout::WIDTH_SHARDED && num_blocks_y == 1 && !transpose_in1 &&
+                       !resident_in1_buffer;
+    const auto& in1_resident_buffer = in1_sharded ? src1_dram_buffer : resident_in1_buffer;
+    if (in0_sharded || in1_sharded) {
+        // B == 1 이므로 core i 가 output block i 를 맡는다.
+        auto block_cores = num_cores_to_corerangeset(num_blocks_total, compute_with_storage_grid_size, true);
+        if (in0_sharded) {
+            validate_matmul_block_shard(src0_dram_buffer, per_core_M, Kt, block_cores, "in0");
+        }
+        if (in1_sharded) {
+            validate_matmul_block_shard(src1_dram_buffer, Kt, per_core_N, block_cores, "in1");
+        }
+    }
+
+    uint32_t in0_CB_size = per_core_M * in0_block_w * 2 * in0_single_tile_size;  // double buffer
+    uint32_t in1_CB_size = per_core_N * in0_block_w * 2 * in1_single_tile_size;  // double buffer
+    if (in0_sharded) {
+        in0_CB_size = per_core_M * Kt * in0_single_tile_size;  // A shard 전체
+    }
+    if (in1_resident_buffer) {
+        TT_FATAL(B == 1 || bcast_batch, "Weight-stationary matmul needs the same B for every batch");
+        TT_FATAL(!transpose_in1, "Weight-stationary matmul expects B slices in row-major tile order");
+        in1_CB_size = per_core_N * Kt * in1_single_tile_size;  // B slice 전체
+    }
+    const auto& in1_buffer = in1_resident_buffer ? in1_resident_buffer : src1_dram_buffer;
+    uint32_t out_CB_size = per_core_M * per_core_N * out_single_tile_size;
+
+    uint32_t num_blocks = Kt / in0_block_w;
+
+    uint32_t in0_num_subblocks = per_core_M / out_subblock_h;
+    uint32_t in0_block_num_tiles = out_subblock_h * in0_block_w * in0_num_subblocks;
+    uint32_t in0_subblock_num_tiles = out_subblock_h * in0_block_w;
+
+    uint32_t in1_num_subblocks = per_core_N / out_subblock_w;
+    uint32_t in1_block_num_tiles = out_subblock_w * in0_block_w * in1_num_subblocks;
+    uint32_t in1_per_core_w = out_subblock_w * in1_num_subblocks;
+
+    uint32_t out_subblock_num_tiles = out_subblock_h * out_subblock_w;
+
+    if (batch_per_core == 0) {
+        batch_per_core = B;
+    }
+    TT_FATAL(B % batch_per_core == 0, "batch_per_core = {} does not divide B = {}", batch_per_core, B);
+    uint32_t num_batch_groups = B / batch_per_core;
+    TT_FATAL(
+        !in1_resident_buffer || num_batch_groups == 1, "Weight-stationary matmul keeps the whole batch on one core");
+
+    std::vector<uint32_t> compute_kernel_args = {
+        in0_block_w,             // in0_block_w
+        in0_num_subblocks,       // in0_num_subblocks
+        in0_block_num_tiles,     // in0_block_num_tiles
+        in0_subblock_num_tiles,  // in0_subblock_num_tiles
+
+        in1_num_subblocks,    // in1_num_subblocks
+        in1_block_num_tiles,  // in1_block_num_tiles
+        in1_per_core_w,       // in1_per_core_w
+
+        num_blocks,  // num_blocks
+
+        out_subblock_h,          // out_subblock_h
+        out_subblock_w,          // out_subblock_w
+        out_subblock_num_tiles,  // out_subblock_num_tiles
+        batch_per_core           // batch
+    };
+
+    TT_FATAL(
+        (schedule.raster_group_h == 0 && !schedule.rotate_k_blocks) ||
+            (!in1_resident_buffer && !in0_sharded && !block_placement),
+        "Block schedule needs operands that are not fixed to a core's L1");
+    auto block_order = get_matmul_block_order(num_blocks_y, num_blocks_x, schedule.raster_group_h);
+
+    uint32_t num_cores = num_blocks_total * num_batch_groups;
+    TT_FATAL(
+        num_cores <= compute_with_storage_grid_size.x * compute_with_storage_grid_size.y,
+        "{} output blocks x {} batch groups do not fit in the {}x{} core grid",
+        num_blocks_total,
+        num_batch_groups,
+        compute_with_storage_grid_size.x,
+        compute_with_storage_grid_size.y);
+    TT_FATAL(
+        !block_placement ||
+            (num_blocks_x <= compute_with_storage_grid_size.x && num_blocks_y <= compute_with_storage_grid_size.y),
+        "{}x{} output blocks do not fit in the {}x{} core grid as a block",
+        num_blocks_y,
+        num_blocks_x,
+        compute_with_storage_grid_size.y,
+        compute_with_storage_grid_size.x);
+    CoreRangeSet all_cores =
+        block_placement ? CoreRangeSet(CoreRange({0, 0}, {num_blocks_x - 1, num_blocks_y - 1}))
+                        : CoreRangeSet(num_cores_to_corerangeset(num_cores, compute_with_storage_grid_size, true));
+
+    uint32_t src0_cb_index = tt::CBIndex::c_0;
+    CircularBufferConfig cb_src0_config = CircularBufferConfig(in0_CB_size, {{src0_cb_index, data_formats.in0}})
+                                              .set_page_size(src0_cb_index, in0_single_tile_size);
+    if (in0_sharded) {
+        cb_src0_config.set_globally_allocated_address(*src0_dram_buffer->get_reference_buffer());
+    }
+    CreateCircularBuffer(program, all_cores, cb_src0_config);
+
+    uint32_t src1_cb_index = tt::CBIndex::c_1;
+    CircularBufferConfig cb_src1_config = CircularBufferConfig(in1_CB_size, {{src1_cb_index, data_formats.in1}})
+                                              .set_page_size(src1_cb_index, in1_single_tile_size);
+    if (in1_resident_buffer) {
+        cb_src1_config.set_globally_allocated_address(*in1_resident_buffer->get_reference_buffer());
+    }
+    CreateCircularBuffer(program, all_cores, cb_src1_config);
+
+    uint32_t output_cb_index = tt::CBIndex::c_16;
+    uint32_t interm0_cb_index = 24;
+    if (double_buffer_output) {
+        auto double_buffer_budget = get_matmul_l1_budget(
+            dst_dram_buffer->device(),
+            data_formats.in0,
+            data_formats.in1,
+            data_formats.out,
+            data_formats.interm,
+            false,
+            2);
+        if (!double_buffer_budget.fits(per_core_M, per_core_N, in0_block_w)) {
+            fmt::print(
+                " -- {}x{} output block does not fit double buffered, using a single buffer --\n",
+                per_core_M,
+                per_core_N);
+            double_buffer_output = false;
+        }
+    }
+    // ROW_MAJOR_IO: pack_untilize 는 c_16에 sub-block row 단위로 pack 하므로 c_24의 partial과 L1을 같이 쓰면 안 된다.
+    bool separate_interm_cb = double_buffer_output || data_formats.interm != data_formats.out || row_major_io;
+    if (separate_interm_cb) {
+        CircularBufferConfig cb_output_config =
+            CircularBufferConfig((double_buffer_output ? 2 : 1) * out_CB_size, {{output_cb_index, data_formats.out}})
+                .set_page_size(output_cb_index, out_single_tile_size);
+        CreateCircularBuffer(program, all_cores, cb_output_config);
+        CircularBufferConfig cb_interm0_config =
+            CircularBufferConfig(
+                per_core_M * per_core_N * interm_single_tile_size, {{interm0_cb_index, data_formats.interm}})
+                .set_page_size(interm0_cb_index, interm_single_tile_size);
+        CreateCircularBuffer(program, all_cores, cb_interm0_config);
+    } else {
+        std::map<uint8_t, tt::DataFormat> output_cb_data_format_spec{
+            {output_cb_index, data_formats.out}, {interm0_cb_index, data_formats.out}};
+        CircularBufferConfig cb_output_config = CircularBufferConfig(out_CB_size, output_cb_data_format_spec)
+                                                    .set_page_size(output_cb_index, out_single_tile_size)
+                                                    .set_page_size(interm0_cb_index, out_single_tile_size);
+        CreateCircularBuffer(program, all_cores, cb_output_config);
+    }
+
+    TT_FATAL(!epilogue.fuse_bias || bias_dram_buffer != nullptr, "FUSE_BIAS needs a bias buffer");
+    // bias tile은 in0 자리 (srcB) 로 unpack 되므로 in0과 같은 형식이어야 한다.
+    TT_FATAL(
+        !epilogue.fuse_bias || data_formats.in0 == data_formats.out,
+        "FUSE_BIAS needs in0 and output in the same data format");
+    if (epilogue.mod.q != 0) {
+        // Barrett epilogue는 dst[0] 만 reduce 하고 dst[1..6] 을 scratch로 쓴다.
+        TT_FATAL(
+            out_subblock_num_tiles == 1, "MOD_EPILOGUE needs 1-tile sub-blocks, got {}", out_subblock_num_tiles);
+        TT_FATAL(
+            data_formats.interm == tt::DataFormat::UInt32 && data_formats.out == tt::DataFormat::UInt32,
+            "MOD_EPILOGUE needs UInt32 partials and output");
+        TT_FATAL(
+            !epilogue.fuse_bias && epilogue.activation == MatmulActivation::NONE && epilogue.scale == 1.0f,
+            "MOD_EPILOGUE cannot be combined with the float epilogue");
+        compute_kernel_args.push_back(epilogue.mod.q_bits);
+        compute_kernel_args.push_back(epilogue.mod.q);
+        compute_kernel_args.push_back(epilogue.mod.mu);
+    }
+    auto compute_defines = get_matmul_epilogue_defines(epilogue);
+    if (separate_interm_cb) {
+        compute_defines["SEPARATE_INTERM_CB"] = "1";
+    }
+    if (data_formats.in1 != data_formats.interm) {
+        compute_defines["RELOAD_RECONFIG_DF"] = "1";
+    }
+    if (data_formats.out != data_formats.interm) {
+        compute_defines["PACK_RECONFIG_DF"] = "1";
+    }
+    if (transpose_in0) {
+        // 전치한 A tile은 output packer 설정 그대로 c_5에 pack 한다.
+        TT_FATAL(
+            data_formats.in0 == data_formats.out && data_formats.interm == data_formats.out,
+            "Transposed in0 needs in0, interm and output in the same data format");
+        uint32_t in0_transposed_cb_index = tt::CBIndex::c_5;
+        CircularBufferConfig cb_in0_transposed_config =
+            CircularBufferConfig(
+                per_core_M * in0_block_w * in0_single_tile_size, {{in0_transposed_cb_index, data_formats.in0}})
+                .set_page_size(in0_transposed_cb_index, in0_single_tile_size);
+        CreateCircularBuffer(program, all_cores, cb_in0_transposed_config);
+        compute_defines["TRANSPOSE_IN0"] = "1";
+    }
+    if (transpose_in1) {
+        compute_defines["TRANSPOSE_IN1"] = "1";
+    }
+    if (in0_sharded) {
+        compute_defines["IN0_SHARDED"] = "1";
+    }
+    std::map<std::string, std::string> writer_defines;
+    if (row_major_io) {
+        // row 조각은 tile 폭 (bfloat16 32개 = 64B) 의 배수이므로 DRAM alignment가 64B 이하여야 한다.
+        TT_FATAL(
+            data_formats.in0 == tt::DataFormat::Float16_b && data_formats.in1 == tt::DataFormat::Float16_b &&
+                data_formats.out == tt::DataFormat::Float16_b,
+            "Row-major matmul operands must be Float16_b");
+        TT_FATAL(!resident_in1_buffer, "Weight-stationary matmul keeps B in tile layout");
+        TT_FATAL(!transpose_in0 && !transpose_in1, "Row-major matmul operands cannot be transposed");
+        TT_FATAL(
+            hal::get_dram_alignment() <= 32 * sizeof(uint16_t),
+            "DRAM alignment {}B is larger than a tile row",
+            hal::get_dram_alignment());
+        // c_6 / c_7 (tilize 한 block) 만큼 in0 / in1 block을 하나씩 더 쓴다.
+        auto row_major_budget = get_matmul_l1_budget(
+            dst_dram_buffer->device(),
+            data_formats.in0,
+            data_formats.in1,
+            data_formats.out,
+            data_formats.interm,
+            false,
+            double_buffer_output ? 2 : 1);
+        row_major_budget.in_buffering = 3;
+        TT_FATAL(
+            row_major_budget.fits(per_core_M, per_core_N, in0_block_w),
+            "{}x{} output block with in0_block_w = {} does not fit in L1 with row-major I/O",
+            per_core_M,
+            per_core_N,
+            in0_block_w);
+        uint32_t in0_tilized_cb_index = tt::CBIndex::c_6;
+        CircularBufferConfig cb_in0_tilized_config =
+            CircularBufferConfig(
+                per_core_M * in0_block_w * in0_single_tile_size, {{in0_tilized_cb_index, data_formats.in0}})
+                .set_page_size(in0_tilized_cb_index, in0_single_tile_size);
+        CreateCircularBuffer(program, all_cores, cb_in0_tilized_config);
+        uint32_t in1_tilized_cb_index = tt::CBIndex::c_7;
+        CircularBufferConfig cb_in1_tilized_config =
+            CircularBufferConfig(
+                per_core_N * in0_block_w * in1_single_tile_size, {{in1_tilized_cb_index, data_formats.in1}})
+                .set_page_size(in1_tilized_cb_index, in1_single_tile_size);
+        CreateCircularBuffer(program, all_cores, cb_in1_tilized_config);
+        compute_defines["ROW_MAJOR_IO"] = "1";
+        writer_defines["ROW_MAJOR_IO"] = "1";
+    }
+    std::vector<UnpackToDestMode> unpack_to_dest_mode(NUM_CIRCULAR_BUFFERS, UnpackToDestMode::Default);
+    if (data_formats.fp32_dest_acc_en()) {
+        unpack_to_dest_mode[interm0_cb_index] = UnpackToDestMode::UnpackToDestFp32;
+    }
+    std::map<std::string, std::string> reader_defines;
+    if (row_major_io) {
+        reader_defines["ROW_MAJOR_IO"] = "1";
+    }
+    if (epilogue.fuse_bias) {
+        // bias tile은 block의 column (per_core_N 개) 만큼 한 번 읽어서 끝까지 둔다.
+        uint32_t bias_cb_index = tt::CBIndex::c_2;
+        CircularBufferConfig cb_bias_config =
+            CircularBufferConfig(per_core_N * out_single_tile_size, {{bias_cb_index, data_formats.out}})
+                .set_page_size(bias_cb_index, out_single_tile_size);
+        CreateCircularBuffer(program, all_cores, cb_bias_config);
+        reader_defines["FUSE_BIAS"] = "1";
+    }
+    if (in0_sharded) {
+        reader_defines["IN0_SHARDED"] = "1";
+    }
+    if (schedule.rotate_k_blocks) {
+        reader_defines["BANK_ROTATE"] = "1";
+    }
+    if (in1_resident_buffer) {
+        reader_defines["IN1_L1_RESIDENT"] = "1";
+    }
+
+    std::vector<uint32_t> reader_compile_time_args;
+    TensorAccessorArgs(*src0_dram_buffer).append_to(reader_compile_time_args);
+    TensorAccessorArgs(*in1_buffer).append_to(reader_compile_time_args);
+    if (epilogue.fuse_bias) {
+        TensorAccessorArgs(*bias_dram_buffer).append_to(reader_compile_time_args);
+    }
+
+    std::vector<uint32_t> writer_compile_time_args;
+    TensorAccessorArgs(*dst_dram_buffer).append_to(writer_compile_time_args);
+
+    auto reader_id = CreateKernel(
+        program,
+        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/matmul_common/kernels/reader_bmm_tile_layout.cpp",
+        all_cores,
+        DataMovementConfig{
+            .processor = DataMovementProcessor::RISCV_1,
+            .noc = NOC::RISCV_1_default,
+            .compile_args = reader_compile_time_args,
+            .defines = reader_defines});
+
+    auto writer_id = CreateKernel(
+        program,
+        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/matmul_common/kernels/writer_bmm_tile_layout.cpp",
+        all_cores,
+        DataMovementConfig{
+            .processor = DataMovementProcessor::RISCV_0,
+            .noc = NOC::RISCV_0_default,
+            .compile_args = writer_compile_time_args,
+            .defines = writer_defines});
+
+    CreateKernel(
+        program,
+        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/matmul_common/kernels/bmm_large_block_zm.cpp",
+        all_cores,
+        ComputeConfig{
+            .math_fidelity = math_fidelity,
+            .fp32_dest_acc_en = data_formats.fp32_dest_acc_en(),
+            .dst_full_sync_en = epilogue.mod.q != 0,
+            .unpack_to_dest_mode = unpack_to_dest_mode,
+            .compile_args = compute_kernel_args,
+            .defines = compute_defines});
+
+    /*
+        reader가 block을 읽는 stride. w 는 block의 가로 방향 (in0 는 K, in1 은 N), h 는 세로 방향이다.
+        전치된 operand는 저장된 tile (j, i) 가 논리적인 tile (i, j) 이므로 w / h stride를 서로 바꾼다.
+    */
+    uint32_t in0_stride_w = transpose_in0 ? Mt : 1;
+    uint32_t in0_stride_h = transpose_in0 ? 1 : Kt;
+    uint32_t in0_next_block_stride = transpose_in0 ? in0_block_w * Mt : in0_block_w;
+    uint32_t in1_stride_w = transpose_in1 ? Kt : 1;
+    uint32_t in1_stride_h = transpose_in1 ? 1 : Nt;
+    uint32_t in1_next_block_stride = transpose_in1 ? in0_block_w : in0_block_w * Nt;
+
+    uint32_t num_blocks_read = 0;
+    for (uint32_t batch_group = 0; batch_group < num_batch_groups; batch_group++) {
+        // batch group 의 첫 batch. bcast_batch 이면 B는 모든 batch가 같은 slice를 쓴다.
+        uint32_t batch_start = batch_group * batch_per_core;
+        uint32_t in0_batch_offset = batch_start * Mt * Kt;
+        uint32_t in1_batch_offset = bcast_batch ? 0 : batch_start * Kt * Nt;
+        uint32_t out_batch_offset = batch_start * Mt * Nt;
+        for (const auto& [output_idx_y, output_idx_x] : block_order) {
+            CoreCoord core = {num_blocks_read % num_cores_x, num_blocks_read / num_cores_x};
+            if (block_placement) {
+                core = {output_idx_x, output_idx_y};
+            }
+
+            uint32_t in0_start_tile_id = transpose_in0 ? per_core_M * output_idx_y : Kt * per_core_M * output_idx_y;
+            uint32_t in1_start_tile_id = transpose_in1 ? Kt * per_core_N * output_idx_x : per_core_N * output_idx_x;
+
+            std::vector<uint32_t> mm_reader_args = {
+                (std::uint32_t)src0_dram_buffer->address(),  // in0_tensor_addr
+                in0_batch_offset + in0_start_tile_id,        // in0_tensor_start_tile_id
+                in0_stride_w,                                // in0_tensor_stride_w
+                in0_stride_h,                                // in0_tensor_stride_h
+                in0_next_block_stride,                       // in0_tensor_next_block_stride
+
+                (std::uint32_t)in0_block_w,               // in0_block_w
+                (std::uint32_t)per_core_M,                // in0_block_h
+                (std::uint32_t)in0_block_w * per_core_M,  // in0_block_num_tiles
+
+                (std::uint32_t)in1_buffer->address(),  // in1_tensor_addr
+                in1_batch_offset + in1_start_tile_id,  // in1_tensor_start_tile_id
+                in1_stride_w,                          // in1_tensor_stride_w
+                in1_stride_h,                          // in1_tensor_stride_h
+                in1_next_block_stride,                 // in1_tensor_next_block_stride
+
+                (std::uint32_t)per_core_N,                // in1_block_w
+                (std::uint32_t)in0_block_w,               // in1_block_h
+                (std::uint32_t)per_core_N * in0_block_w,  // in1_block_num_tiles
+
+                (std::uint32_t)num_blocks,  // num_blocks
+
+                (std::uint32_t)Mt * Kt,     // MtKt
+                (std::uint32_t)Kt * Nt,     // KtNt
+                (std::uint32_t)batch_per_core,  // batch
+                (std::uint32_t)bcast_batch      // bcast_B
+            };
+            if (epilogue.fuse_bias) {
+                mm_reader_args.push_back(bias_dram_buffer->address());  // bias_tensor_addr
+                mm_reader_args.push_back(per_core_N * output_idx_x);    // bias_tensor_start_tile_id
+                mm_reader_args.push_back(per_core_N);                   // bias_num_tiles
+            }
+            if (row_major_io) {
+                mm_reader_args.resize(24, 0);  // FUSE_BIAS args 자리
+                mm_reader_args.push_back(Kt);  // in0_width_tiles
+                mm_reader_args.push_back(Nt);  // in1_width_tiles
+            }
+            if (schedule.rotate_k_blocks) {
+                mm_reader_args.resize(26, 0);                            // ROW_MAJOR_IO args 자리
+                mm_reader_args.push_back(num_blocks_read % num_blocks);  // k_block_start
+            }
+
+            std::vector<uint32_t> writer_args = {
+                (std::uint32_t)dst_dram_buffer->address(),  // out_buffer_addr
+                out_batch_offset + (output_idx_x * per_core_N) +
+                    (output_idx_y * per_core_M * Nt),  // out_tensor_start_tile_id
+                (std::uint32_t)1,                      // out_tensor_stride_w
+                (std::uint32_t)Nt,                     // out_tensor_stride_h
+                (std::uint32_t)out_subblock_w,         // out_tensor_next_subblock_stride_w
+                (std::uint32_t)out_subblock_h * Nt,    // out_tensor_next_subblock_stride_h
+
+                (std::uint32_t)out_subblock_w,                     // out_subblock_w
+                (std::uint32_t)out_subblock_h,                     // out_subblock_h
+                (std::uint32_t)(out_subblock_w * out_subblock_h),  // out_subblocks_w * out_subblocks_h
+                (std::uint32_t)(per_core_N / out_subblock_w),      // out_num_subblocks_w
+                (std::uint32_t)(per_core_M / out_subblock_h),      // out_num_subblocks_h
+
+                (std::uint32_t)Mt * Nt,        // MtNt
+                (std::uint32_t)batch_per_core  // batch
+            };
+            if (row_major_io) {
+                writer_args.push_back(Nt);  // out_width_tiles
+            }
+
+            SetRuntimeArgs(program, reader_id, core, mm_reader_args);
+            SetRuntimeArgs(program, writer_id, core, writer_args);
+
+            num_blocks_read++;
+        }
+    }
+
+    return program;
+}
+
+}  // namespace bmm_op_utils
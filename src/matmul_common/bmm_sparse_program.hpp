@@ -0,0 +1,301 @@
+#pragma once
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "bmm_reuse_program.hpp"
+
+namespace bmm_op_utils {
+
+/*
+    block-sparse matmul: B (Kt x Nt tiles) 의 대부분의 32x32 tile이 0일 때 0 tile을 읽지도 곱하지도 않는다.
+
+    B는 tile row 단위 CSR 로 들고 있다. row_ptr[k] .. row_ptr[k + 1] 이 tile row k 의 0이 아닌 tile이고,
+    col_idx 는 그 tile들의 column (row 안에서 오름차순), DRAM의 B buffer는 0이 아닌 tile만 같은 순서로 담는다.
+    output block 하나당 core 하나를 쓰며 (create_matmul_multicore_reuse_program 과 같은 배치), core는 자기
+    output column 구간에 0이 아닌 tile이 있는 K tile ("present") 만 읽고 계산한다.
+    (reader_bmm_tile_layout_sparse.cpp) per_core_N 이 작을수록 skip 단위가 tile 하나에 가까워진다.
+*/
+struct MatmulBlockSparseIndex {
+    uint32_t Kt = 0;
+    uint32_t Nt = 0;
+    std::vector<uint32_t> row_ptr;  // Kt + 1
+    std::vector<uint32_t> col_idx;  // nnz
+
+    uint32_t nnz() const { return col_idx.size(); }
+
+    // DRAM에 올리는 형태: row_ptr 과 col_idx 를 이어 붙이고 32B의 배수로 0 padding 한다.
+    std::vector<uint32_t> packed() const {
+        std::vector<uint32_t> words(row_ptr);
+        words.insert(words.end(), col_idx.begin(), col_idx.end());
+        words.resize((words.size() + 7) / 8 * 8, 0);
+        return words;
+    }
+
+    // column 구간 [n_start, n_start + n_count) 에 0이 아닌 tile이 있는 K tile 수
+    uint32_t count_present_k(uint32_t n_start, uint32_t n_count) const {
+        uint32_t present = 0;
+        for (uint32_t k = 0; k < Kt; k++) {
+            for (uint32_t p = row_ptr[k]; p < row_ptr[k + 1]; p++) {
+                if (col_idx[p] >= n_start && col_idx[p] < n_start + n_count) {
+                    present++;
+                    break;
+                }
+            }
+        }
+        return present;
+    }
+};
+
+/*
+    tilize_nfaces 로 tile 순서가 된 B (Kt x Nt tiles) 에서 값이 모두 0인 tile을 빼고 CSR index와
+    0이 아닌 tile (CSR 순서) 을 만든다.
+*/
+template <typename T>
+inline std::pair<MatmulBlockSparseIndex, std::vector<T>> make_block_sparse_tiles(
+    const std::vector<T>& in1_tiles, uint32_t Kt, uint32_t Nt) {
+    constexpr uint32_t tile_elems = tt::constants::TILE_HW;
+    MatmulBlockSparseIndex index{.Kt = Kt, .Nt = Nt};
+    std::vector<T> nonzero_tiles;
+    index.row_ptr.push_back(0);
+    for (uint32_t k = 0; k < Kt; k++) {
+        for (uint32_t n = 0; n < Nt; n++) {
+            auto tile_begin = in1_tiles.begin() + ((size_t)k * Nt + n) * tile_elems;
+            auto tile_end = tile_begin + tile_elems;
+            if (std::all_of(tile_begin, tile_end, [](const T& x) { return static_cast<float>(x) == 0.0f; })) {
+                continue;
+            }
+            index.col_idx.push_back(n);
+            nonzero_tiles.insert(nonzero_tiles.end(), tile_begin, tile_end);
+        }
+        index.row_ptr.push_back(index.col_idx.size());
+    }
+    return {index, nonzero_tiles};
+}
+
+// CSR index를 DRAM buffer (page 하나) 로 만들어 쓴다.
+inline std::shared_ptr<tt::tt_metal::distributed::MeshBuffer> create_block_sparse_index_buffer(
+    tt::tt_metal::distributed::MeshDevice* mesh_device,
+    tt::tt_metal::distributed::MeshCommandQueue& cq,
+    const MatmulBlockSparseIndex& index) {
+    using namespace tt::tt_metal;
+
+    std::vector<uint32_t> words = index.packed();
+    uint32_t index_bytes = words.size() * sizeof(uint32_t);
+    distributed::DeviceLocalBufferConfig dram_config{.page_size = index_bytes, .buffer_type = BufferType::DRAM};
+    distributed::ReplicatedBufferConfig buffer_config{.size = index_bytes};
+    auto index_buffer = distributed::MeshBuffer::create(buffer_config, dram_config, mesh_device);
+    distributed::EnqueueWriteMeshBuffer(cq, index_buffer, words, false);
+    return index_buffer;
+}
+
+/*
+    block-sparse matmul program. reader_bmm_tile_layout_sparse / bmm_large_block_zm (GROUPED_WORK_ITEMS, item 1개)
+    / writer_bmm_tile_layout 을 output block 수만큼의 core에 만든다.
+    src1_nonzero_buffer 는 make_block_sparse_tiles 의 0이 아닌 tile, index_buffer 는
+    create_block_sparse_index_buffer 로 만든 것이다. core 별 K block 수는 index로 여기서 계산한다.
+*/
+inline tt::tt_metal::Program create_block_sparse_matmul_program(
+    const std::shared_ptr<tt::tt_metal::distributed::MeshBuffer>& src0_dram_buffer,
+    const std::shared_ptr<tt::tt_metal::distributed::MeshBuffer>& src1_nonzero_buffer,
+    const std::shared_ptr<tt::tt_metal::distributed::MeshBuffer>& index_buffer,
+    const std::shared_ptr<tt::tt_metal::distributed::MeshBuffer>& dst_dram_buffer,
+    uint32_t Mt,
+    uint32_t Nt,
+    uint32_t Kt,
+    const MatmulBlockSparseIndex& index,
+    const MatmulBlockConfig& config,
+    tt::DataFormat data_format,
+    MathFidelity math_fidelity,
+    CoreCoord compute_with_storage_grid_size) {
+    using namespace tt::tt_metal;
+
+    Program program{};
+
+    uint32_t single_tile_size = tt::tile_size(data_format);
+    uint32_t num_cores_x = compute_with_storage_grid_size.x;
+
+    uint32_t per_core_M = config.per_core_M;
+    uint32_t per_core_N = config.per_core_N;
+    uint32_t in0_block_w = config.in0_block_w;
+    uint32_t out_subblock_h = config.out_subblock_h;
+    uint32_t out_subblock_w = config.out_subblock_w;
+
+    TT_FATAL(
+        index.Kt == Kt && index.Nt == Nt,
+        "Sparse index is {}x{} tiles, expected {}x{}",
+        index.Kt,
+        index.Nt,
+        Kt,
+        Nt);
+    TT_FATAL(
+        Mt % per_core_M == 0 && Nt % per_core_N == 0,
+        "Block {}x{} does not divide Mt={}, Nt={}",
+        per_core_M,
+        per_core_N,
+        Mt,
+        Nt);
+    TT_FATAL(
+        per_core_M % out_subblock_h == 0 && per_core_N % out_subblock_w == 0,
+        "Sub-block {}x{} does not divide block {}x{}",
+        out_subblock_h,
+        out_subblock_w,
+        per_core_M,
+        per_core_N);
+    TT_FATAL(
+        out_subblock_h * out_subblock_w <= 8, "Sub-block {}x{} does not fit in dst", out_subblock_h, out_subblock_w);
+
+    uint32_t num_blocks_y = Mt / per_core_M;
+    uint32_t num_blocks_x = Nt / per_core_N;
+    uint32_t num_blocks_total = num_blocks_y * num_blocks_x;
+    TT_FATAL(
+        num_blocks_total <= compute_with_storage_grid_size.x * compute_with_storage_grid_size.y,
+        "{} output blocks do not fit in the {}x{} core grid",
+        num_blocks_total,
+        compute_with_storage_grid_size.x,
+        compute_with_storage_grid_size.y);
+    CoreRangeSet all_cores(num_cores_to_corerangeset(num_blocks_total, compute_with_storage_grid_size, true));
+
+    uint32_t in0_num_subblocks = per_core_M / out_subblock_h;
+    uint32_t in0_block_num_tiles = per_core_M * in0_block_w;
+    uint32_t in0_subblock_num_tiles = out_subblock_h * in0_block_w;
+    uint32_t in1_num_subblocks = per_core_N / out_subblock_w;
+    uint32_t in1_block_num_tiles = per_core_N * in0_block_w;
+    uint32_t out_subblock_num_tiles = out_subblock_h * out_subblock_w;
+
+    // num_blocks 와 batch 는 GROUPED_WORK_ITEMS 에서 runtime arg로 바뀐다.
+    std::vector<uint32_t> compute_kernel_args = {
+        in0_block_w,             // in0_block_w
+        in0_num_subblocks,       // in0_num_subblocks
+        in0_block_num_tiles,     // in0_block_num_tiles
+        in0_subblock_num_tiles,  // in0_subblock_num_tiles
+
+        in1_num_subblocks,    // in1_num_subblocks
+        in1_block_num_tiles,  // in1_block_num_tiles
+        per_core_N,           // in1_per_core_w
+
+        0,  // num_blocks (core 별 present K block 수, runtime arg)
+
+        out_subblock_h,          // out_subblock_h
+        out_subblock_w,          // out_subblock_w
+        out_subblock_num_tiles,  // out_subblock_num_tiles
+        0                        // batch (1, runtime arg)
+    };
+
+    CreateCircularBuffer(
+        program,
+        all_cores,
+        CircularBufferConfig(in0_block_num_tiles * 2 * single_tile_size, {{tt::CBIndex::c_0, data_format}})
+            .set_page_size(tt::CBIndex::c_0, single_tile_size));  // double buffer
+    CreateCircularBuffer(
+        program,
+        all_cores,
+        CircularBufferConfig(in1_block_num_tiles * 2 * single_tile_size, {{tt::CBIndex::c_1, data_format}})
+            .set_page_size(tt::CBIndex::c_1, single_tile_size));  // double buffer
+    uint32_t index_bytes = index_buffer->size();
+    CreateCircularBuffer(
+        program,
+        all_cores,
+        CircularBufferConfig(index_bytes, {{tt::CBIndex::c_3, tt::DataFormat::UInt32}})
+            .set_page_size(tt::CBIndex::c_3, index_bytes));
+    uint32_t output_cb_index = tt::CBIndex::c_16;
+    uint32_t interm0_cb_index = 24;
+    std::map<uint8_t, tt::DataFormat> output_cb_data_format_spec{
+        {output_cb_index, data_format}, {interm0_cb_index, data_format}};
+    CreateCircularBuffer(
+        program,
+        all_cores,
+        CircularBufferConfig(per_core_M * per_core_N * single_tile_size, output_cb_data_format_spec)
+            .set_page_size(output_cb_index, single_tile_size)
+            .set_page_size(interm0_cb_index, single_tile_size));
+
+    std::vector<uint32_t> reader_compile_time_args;
+    TensorAccessorArgs(*src0_dram_buffer).append_to(reader_compile_time_args);
+    TensorAccessorArgs(*src1_nonzero_buffer).append_to(reader_compile_time_args);
+    TensorAccessorArgs(*index_buffer).append_to(reader_compile_time_args);
+
+    std::vector<uint32_t> writer_compile_time_args;
+    TensorAccessorArgs(*dst_dram_buffer).append_to(writer_compile_time_args);
+
+    auto reader_id = CreateKernel(
+        program,
+        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/matmul_common/kernels/reader_bmm_tile_layout_sparse.cpp",
+        all_cores,
+        DataMovementConfig{
+            .processor = DataMovementProcessor::RISCV_1,
+            .noc = NOC::RISCV_1_default,
+            .compile_args = reader_compile_time_args});
+
+    auto writer_id = CreateKernel(
+        program,
+        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/matmul_common/kernels/writer_bmm_tile_layout.cpp",
+        all_cores,
+        DataMovementConfig{
+            .processor = DataMovementProcessor::RISCV_0,
+            .noc = NOC::RISCV_0_default,
+            .compile_args = writer_compile_time_args});
+
+    auto compute_id = CreateKernel(
+        program,
+        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/matmul_common/kernels/bmm_large_block_zm.cpp",
+        all_cores,
+        ComputeConfig{
+            .math_fidelity = math_fidelity,
+            .compile_args = compute_kernel_args,
+            .defines = {{"GROUPED_WORK_ITEMS", "1"}}});
+
+    uint32_t num_blocks_read = 0;
+    for (uint32_t output_idx_y = 0; output_idx_y < num_blocks_y; output_idx_y++) {
+        for (uint32_t output_idx_x = 0; output_idx_x < num_blocks_x; output_idx_x++) {
+            CoreCoord core = {num_blocks_read % num_cores_x, num_blocks_read / num_cores_x};
+
+            // present k 가 없어도 0 block 하나는 계산해서 output을 0으로 쓴다.
+            uint32_t present_k = index.count_present_k(output_idx_x * per_core_N, per_core_N);
+            uint32_t num_k_blocks = std::max<uint32_t>(1, (present_k + in0_block_w - 1) / in0_block_w);
+
+            std::vector<uint32_t> mm_reader_args = {
+                (std::uint32_t)src0_dram_buffer->address(),     // in0_tensor_addr
+                (std::uint32_t)src1_nonzero_buffer->address(),  // in1_tensor_addr
+                (std::uint32_t)index_buffer->address(),         // index_addr
+                index_bytes,                                    // index_bytes
+                Kt,                                             // Kt
+                per_core_M,                                     // per_core_M
+                per_core_N,                                     // per_core_N
+                in0_block_w,                                    // in0_block_w
+                output_idx_y * per_core_M,                      // out_row_start
+                output_idx_x * per_core_N,                      // out_col_start
+                num_k_blocks                                    // num_k_blocks
+            };
+
+            std::vector<uint32_t> writer_args = {
+                (std::uint32_t)dst_dram_buffer->address(),  // out_buffer_addr
+                ((std::uint32_t)output_idx_x * per_core_N) +
+                    (output_idx_y * per_core_M * Nt),  // out_tensor_start_tile_id
+                (std::uint32_t)1,                      // out_tensor_stride_w
+                (std::uint32_t)Nt,                     // out_tensor_stride_h
+                (std::uint32_t)out_subblock_w,         // out_tensor_next_subblock_stride_w
+                (std::uint32_t)out_subblock_h * Nt,    // out_tensor_next_subblock_stride_h
+
+                (std::uint32_t)out_subblock_w,                     // out_subblock_w
+                (std::uint32_t)out_subblock_h,                     // out_subblock_h
+                (std::uint32_t)(out_subblock_w * out_subblock_h),  // out_subblocks_w * out_subblocks_h
+                (std::uint32_t)(per_core_N / out_subblock_w),      // out_num_subblocks_w
+                (std::uint32_t)(per_core_M / out_subblock_h),      // out_num_subblocks_h
+
+                (std::uint32_t)Mt * Nt,  // MtNt
+                (std::uint32_t)1         // batch
+            };
+
+            SetRuntimeArgs(program, reader_id, core, mm_reader_args);
+            SetRuntimeArgs(program, writer_id, core, writer_args);
+            SetRuntimeArgs(program, compute_id, core, {1, num_k_blocks});
+
+            num_blocks_read++;
+        }
+    }
+
+    return program;
+}
+
+}  // namespace bmm_op_utils
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <stdint.h>
+#include "dataflow_api.h"
+
+/*
+    matmul reader / writer kernel들이 같이 쓰는 dataflow helper.
+*/
+
+// 유효 범위 밖(padding)의 tile 자리를 0으로 채운다. matmul에서 0 tile은 결과에 영향을 주지 않는다.
+inline void fill_zero_tile(uint32_t l1_write_addr, uint32_t tile_size_bytes) {
+    volatile tt_l1_ptr uint32_t* ptr = reinterpret_cast<volatile tt_l1_ptr uint32_t*>(l1_write_addr);
+    for (uint32_t i = 0; i < tile_size_bytes / sizeof(uint32_t); i++) {
+        ptr[i] = 0;
+    }
+}
+
+/*
+    row-major tile grid (num_rows x num_cols, 유효 범위 valid_rows x valid_cols) 에서
+    (row_start, col_start) 부터 block_h x block_w 개의 tile을 CB로 읽는다. 범위 밖의 tile은 0으로 채운다.
+    tile_offset 은 tensor 안에서 이 grid가 시작하는 tile id 이다. (batch offset)
+    호출한 쪽에서 noc_async_read_barrier() 를 해야 한다.
+*/
+template <typename Accessor>
+inline void read_block_padded(
+    const Accessor& s,
+    uint32_t l1_write_addr,
+    uint32_t row_start,
+    uint32_t col_start,
+    uint32_t block_h,
+    uint32_t block_w,
+    uint32_t valid_rows,
+    uint32_t valid_cols,
+    uint32_t tile_size_bytes,
+    uint32_t tile_offset = 0) {
+    for (uint32_t h = 0; h < block_h; h++) {
+        uint32_t row = row_start + h;
+        for (uint32_t w = 0; w < block_w; w++) {
+            uint32_t col = col_start + w;
+            if (row < valid_rows && col < valid_cols) {
+                noc_async_read_tile(tile_offset + row * valid_cols + col, s, l1_write_addr);
+            } else {
+                fill_zero_tile(l1_write_addr, tile_size_bytes);
+            }
+            l1_write_addr += tile_size_bytes;
+        }
+    }
+}
+
+/*
+    grouped matmul descriptor table 의 entry 하나. (bmm_grouped_program.hpp 의 MatmulGroupDesc 와 같은 배치)
+    host가 DRAM에 group 수만큼 이어서 써 두고, reader가 core마다 한 번 L1로 읽어 온다.
+*/
+struct matmul_group_desc_t {
+    uint32_t Mt;
+    uint32_t Nt;
+    uint32_t Kt;
+    uint32_t in0_addr;
+    uint32_t in1_addr;
+    uint32_t out_addr;
+    uint32_t reserved[2];
+};
+
+/*
+    row-major bfloat16 tensor (page 하나 = 행렬 row 하나) 와 L1 사이의 block 복사. (ROW_MAJOR_IO)
+    (tile_row, tile_col) 부터 height_tiles x width_tiles tile 크기의 구간을 행렬 row 하나 (width_tiles * 64B) 당
+    NoC transaction 하나로 옮긴다. L1에는 row-major 그대로 두고 (row 32개 = tile row 하나 = width_tiles tile 크기),
+    tile layout으로의 변환은 compute kernel이 tilize / pack_untilize 로 한다.
+    transaction의 DRAM 쪽 시작 주소와 크기가 모두 64B의 배수이므로 DRAM alignment가 64B 이하이면 된다.
+    호출한 쪽에서 barrier를 해야 한다.
+*/
+constexpr uint32_t TILE_ROW_BYTES = 32 * sizeof(uint16_t);
+
+template <typename Accessor>
+inline void read_block_from_row_major(
+    const Accessor& s,
+    uint32_t tile_row,
+    uint32_t tile_col,
+    uint32_t height_tiles,
+    uint32_t width_tiles,
+    uint32_t l1_write_addr) {
+    uint32_t row_bytes = width_tiles * TILE_ROW_BYTES;
+    for (uint32_t r = 0; r < height_tiles * 32; r++) {
+        noc_async_read(s.get_noc_addr(tile_row * 32 + r, tile_col * TILE_ROW_BYTES), l1_write_addr, row_bytes);
+        l1_write_addr += row_bytes;
+    }
+}
+
+template <typename Accessor>
+inline void write_block_to_row_major(
+    const Accessor& s,
+    uint32_t tile_row,
+    uint32_t tile_col,
+    uint32_t height_tiles,
+    uint32_t width_tiles,
+    uint32_t l1_read_addr) {
+    uint32_t row_bytes = width_tiles * TILE_ROW_BYTES;
+    for (uint32_t r = 0; r < height_tiles * 32; r++) {
+        noc_async_write(l1_read_addr, s.get_noc_addr(tile_row * 32 + r, tile_col * TILE_ROW_BYTES), row_bytes);
+        l1_read_addr += row_bytes;
+    }
+}
@@ -2,6 +2,73 @@
 
 #include "compute_kernel_api/tile_move_copy.h"
 #include "compute_kernel_api/matmul.h"
+#ifdef PACK_RECONFIG_DF
+#include "compute_kernel_api/pack.h"
+#include "compute_kernel_api/reconfig_data_format.h"
+#endif
+
+#ifdef MOD_EPILOGUE
+#include "../../modular_common/kernels/mod_sfpu.h"
+#endif
+
+/*
+    Fused epilogue (host에서 define으로 켠다). 마지막 K block의 sub-block이 dst에 있는 동안
+        out = activation(scale * acc + bias)
+    를 계산하고 pack 한다. output을 DRAM에서 다시 읽고 쓰는 elementwise program이 필요 없다.
+    - FUSE_SCALE=<fp32 bits> : SFPU로 scalar 곱
+    - FUSE_BIAS              : c_2 의 bias tile (per_core_N 개, tile 안의 32 row가 모두 같은 bias row) 을
+                               binary_dest_reuse로 dst에 더한다. reader가 시작할 때 한 번 읽어 둔다.
+    - FUSE_ACTIVATION=1/2/3  : ReLU / GELU / SiLU (SFPU)
+*/
+#ifdef FUSE_SCALE
+#include "compute_kernel_api/eltwise_unary/binop_with_scalar.h"
+#endif
+#ifdef FUSE_BIAS
+#include "compute_kernel_api/eltwise_binary.h"
+#endif
+#ifdef FUSE_ACTIVATION
+#include "compute_kernel_api.h"
+#include "compute_kernel_api/eltwise_unary/relu.h"
+#endif
+#if defined(FUSE_SCALE) || defined(FUSE_BIAS) || defined(FUSE_ACTIVATION)
+#define FUSED_EPILOGUE
+#endif
+
+/*
+    전치된 operand (host에서 정한다). reader는 tile 순서만 바꿔 읽고 tile 안의 전치는 여기서 한다.
+    - TRANSPOSE_IN1 : B tile은 matmul_tiles의 transpose flag로 unpack 할 때 전치한다.
+    - TRANSPOSE_IN0 : transpose flag는 in1에만 있으므로 A block을 transpose_wh로 c_5에 전치해 두고
+                      c_5를 in0로 쓴다. (c_5 pack은 c_16과 같은 형식이어야 한다.)
+*/
+/*
+    ROW_MAJOR_IO (host에서 정한다). reader는 c_0 / c_1 에 A / B block을 row-major 그대로 넣는다.
+    tile row 하나 (행렬 row 32개) 씩 tilize 해서 c_6 / c_7 로 옮기고 그것을 in0 / in1 으로 쓴다.
+    마지막 K block의 결과는 pack_untilize_dest로 c_16에 row-major로 pack 하고, sub-block row 하나
+    (out_subblock_h x per_core_N tiles) 가 다 모이면 push 한다. TRANSPOSE_IN0 / TRANSPOSE_IN1 과 같이 쓰지 않는다.
+*/
+#ifdef ROW_MAJOR_IO
+#include "compute_kernel_api/tilize.h"
+#include "compute_kernel_api/pack_untilize.h"
+#endif
+
+#ifdef TRANSPOSE_IN0
+#include "compute_kernel_api/transpose_wh.h"
+constexpr auto cb_in0 = tt::CBIndex::c_5;
+#elif defined(ROW_MAJOR_IO)
+constexpr auto cb_in0 = tt::CBIndex::c_6;
+#else
+constexpr auto cb_in0 = tt::CBIndex::c_0;
+#endif
+#ifdef ROW_MAJOR_IO
+constexpr auto cb_in1 = tt::CBIndex::c_7;
+#else
+constexpr auto cb_in1 = tt::CBIndex::c_1;
+#endif
+#ifdef TRANSPOSE_IN1
+constexpr uint32_t transpose_in1 = 1;
+#else
+constexpr uint32_t transpose_in1 = 0;
+#endif
 
 namespace NAMESPACE {
 void MAIN {
@@ -24,9 +91,77 @@ void MAIN {
     uint32_t out_subblock_num_tiles = get_compile_time_arg_val(10);  // out_subblock_h * out_subblock_w;
     uint32_t batch = get_compile_time_arg_val(11);                   // batch dim
 
-    mm_init(tt::CBIndex::c_0, tt::CBIndex::c_1, tt::CBIndex::c_16);
+#ifdef ROW_MAJOR_IO
+    // pack_untilize_dest의 template 인자
+    constexpr uint32_t untilize_block_ct = get_compile_time_arg_val(9);  // out_subblock_w
+    constexpr uint32_t untilize_full_ct = get_compile_time_arg_val(6);   // per_core_N
+#endif
+
+#ifdef MOD_EPILOGUE
+    // integer matmul 결과를 pack 하기 전에 dst에서 mod q로 reduce 한다. (out_subblock_num_tiles == 1 필요)
+    constexpr uint32_t q_bits = get_compile_time_arg_val(12);
+    constexpr uint32_t q = get_compile_time_arg_val(13);
+    constexpr uint32_t mu = get_compile_time_arg_val(14);
+#endif
+
+#ifdef GROUPED_WORK_ITEMS
+    // grouped matmul (bmm_grouped_program.hpp): core 마다 output block (work item) 수가 다르고 item 마다 K가 다르므로
+    // batch 자리에 item 수를, item 별 K block 수를 runtime arg로 받는다.
+    // block-sparse matmul (bmm_sparse_program.hpp) 도 core 마다 present K block 수가 달라서 같이 쓴다.
+    batch = get_arg_val<uint32_t>(0);
+#endif
+#ifdef RAGGED_BLOCKS
+    /*
+        임의 크기 matmul (create_matmul_padded_program): batch 자리는 core가 처리할 output block 수이고,
+        마지막 row / column block은 행렬 (valid_Mt x valid_Nt tiles) 밖으로 나간다. 그런 block은 유효한 tile을
+        덮는 sub-block만 계산한다. c_0 / c_1 에는 reader가 block 전체를 넣으므로 index와 push / pop 크기는 그대로다.
+        c_24는 block마다 push 하는 양이 달라지므로 c_16과 L1을 같이 쓰면 안 된다. (SEPARATE_INTERM_CB 필요)
+    */
+    uint32_t valid_Mt = get_arg_val<uint32_t>(0);
+    uint32_t valid_Nt = get_arg_val<uint32_t>(1);
+    uint32_t num_blocks_x = get_arg_val<uint32_t>(2);
+    uint32_t blocks_per_batch = get_arg_val<uint32_t>(3);
+    uint32_t block_start = get_arg_val<uint32_t>(4);
+    uint32_t per_core_M = out_subblock_h * in0_num_subblocks;
+#endif
+
+    /*
+        IN0_SHARDED: c_0은 A shard 전체 (per_core_M x Kt, row-major) 이고 block마다 pop 하지 않는다.
+        block 안의 tile (h, inner_dim) 은 shard의 (h, block * in0_block_w + inner_dim) 이므로 row stride가 Kt이다.
+    */
+#ifdef IN0_SHARDED
+    const uint32_t in0_row_stride = in0_block_w * num_blocks;
+#else
+    const uint32_t in0_row_stride = in0_block_w;
+#endif
+
+    mm_init(cb_in0, cb_in1, tt::CBIndex::c_16, transpose_in1);
+
+#ifdef FUSE_BIAS
+    // bias는 모든 batch에서 같이 쓰므로 마지막에 pop 한다.
+    cb_wait_front(tt::CBIndex::c_2, in1_per_core_w);
+#endif
+#ifdef IN0_SHARDED
+    cb_wait_front(cb_in0, in0_block_num_tiles * num_blocks);
+#endif
 
     for (uint32_t b = 0; b < batch; b++) {
+#ifdef GROUPED_WORK_ITEMS
+        num_blocks = get_arg_val<uint32_t>(1 + b);
+#endif
+        uint32_t num_subblocks_h = in0_num_subblocks;
+        uint32_t num_subblocks_w = in1_num_subblocks;
+#ifdef RAGGED_BLOCKS
+        uint32_t block_in_batch = (block_start + b) % blocks_per_batch;
+        uint32_t rows_left = valid_Mt - (block_in_batch / num_blocks_x) * per_core_M;
+        uint32_t cols_left = valid_Nt - (block_in_batch % num_blocks_x) * in1_per_core_w;
+        if (rows_left < per_core_M) {
+            num_subblocks_h = (rows_left + out_subblock_h - 1) / out_subblock_h;
+        }
+        if (cols_left < in1_per_core_w) {
+            num_subblocks_w = (cols_left + out_subblock_w - 1) / out_subblock_w;
+        }
+#endif
         bool spill = num_blocks > 1;
         bool enable_reload = false;
         uint32_t out_num_tiles_to_wait = out_subblock_num_tiles;
@@ -34,23 +169,77 @@ void MAIN {
         for (uint32_t block = 0; block < num_blocks; block++) {
             bool last_out = block == (num_blocks - 1);
 
+#ifdef TRANSPOSE_IN0
+            // reader가 tile 순서만 바꿔 넣은 A block을 tile 안에서 전치해 c_5로 옮긴다.
             cb_wait_front(tt::CBIndex::c_0, in0_block_num_tiles);
-            cb_wait_front(tt::CBIndex::c_1, in1_block_num_tiles);
+            cb_reserve_back(cb_in0, in0_block_num_tiles);
+            transpose_wh_init_short(tt::CBIndex::c_0);
+            for (uint32_t i = 0; i < in0_block_num_tiles; i++) {
+                acquire_dst();
+                transpose_wh_tile(tt::CBIndex::c_0, i, 0);
+                pack_tile(0, cb_in0);
+                release_dst();
+            }
+            cb_push_back(cb_in0, in0_block_num_tiles);
+            cb_pop_front(tt::CBIndex::c_0, in0_block_num_tiles);
+            mm_init_short(cb_in0, cb_in1, transpose_in1);
+#endif
+#ifdef ROW_MAJOR_IO
+            // c_0 / c_1 의 row-major block을 tile row 단위로 tilize 해서 c_6 / c_7 로 옮긴다.
+            tilize_init(tt::CBIndex::c_0, in0_block_w, cb_in0);
+            for (uint32_t h = 0; h < in0_block_num_tiles / in0_block_w; h++) {
+                cb_wait_front(tt::CBIndex::c_0, in0_block_w);
+                cb_reserve_back(cb_in0, in0_block_w);
+                tilize_block(tt::CBIndex::c_0, in0_block_w, cb_in0);
+                cb_push_back(cb_in0, in0_block_w);
+                cb_pop_front(tt::CBIndex::c_0, in0_block_w);
+            }
+            tilize_uninit(tt::CBIndex::c_0, cb_in0);
+            tilize_init(tt::CBIndex::c_1, in1_per_core_w, cb_in1);
+            for (uint32_t h = 0; h < in0_block_w; h++) {
+                cb_wait_front(tt::CBIndex::c_1, in1_per_core_w);
+                cb_reserve_back(cb_in1, in1_per_core_w);
+                tilize_block(tt::CBIndex::c_1, in1_per_core_w, cb_in1);
+                cb_push_back(cb_in1, in1_per_core_w);
+                cb_pop_front(tt::CBIndex::c_1, in1_per_core_w);
+            }
+            tilize_uninit(tt::CBIndex::c_1, cb_in1);
+            mm_init_short(cb_in0, cb_in1, transpose_in1);
+            if (last_out) {
+                pack_untilize_dest_init<untilize_block_ct, untilize_full_ct>(tt::CBIndex::c_16);
+            }
+#endif
+#ifdef IN0_SHARDED
+            int in0_index_subblock_offset = block * in0_block_w;
+#else
+            cb_wait_front(cb_in0, in0_block_num_tiles);
             int in0_index_subblock_offset = 0;
-            for (uint32_t in0_subblock = 0; in0_subblock < in0_num_subblocks; in0_subblock++) {
+#endif
+            cb_wait_front(cb_in1, in1_block_num_tiles);
+            for (uint32_t in0_subblock = 0; in0_subblock < num_subblocks_h; in0_subblock++) {
                 int in1_index_subblock_offset = 0;
-                for (uint32_t in1_subblock = 0; in1_subblock < in1_num_subblocks; in1_subblock++) {
+                for (uint32_t in1_subblock = 0; in1_subblock < num_subblocks_w; in1_subblock++) {
                     acquire_dst();
 
                     if (enable_reload) {
                         // bring prior partial C tiles back from c_24
+#ifdef RELOAD_RECONFIG_DF
+                        // in1 (srcA) 과 partial (interm 형식) 이 다르면 읽기 전에 unpacker 형식을 바꾸고,
+                        // 다시 matmul로 돌아갈 때 되돌린다.
+                        copy_tile_to_dst_init_short_with_dt(cb_in1, tt::CBIndex::c_24);
+#else
                         copy_tile_to_dst_init_short(tt::CBIndex::c_24);
+#endif
                         cb_wait_front(tt::CBIndex::c_24, out_subblock_num_tiles);
                         for (uint32_t i = 0; i < out_subblock_num_tiles; i++) {
                             copy_tile(tt::CBIndex::c_24, i, i);     // reload partials into dst registers
                         }
                         cb_pop_front(tt::CBIndex::c_24, out_subblock_num_tiles);
-                        mm_init_short(tt::CBIndex::c_0, tt::CBIndex::c_1);
+#ifdef RELOAD_RECONFIG_DF
+                        mm_init_short_with_dt(cb_in0, cb_in1, tt::CBIndex::c_24, transpose_in1);
+#else
+                        mm_init_short(cb_in0, cb_in1, transpose_in1);
+#endif
                     }
 
                     // Compute output sub-block from in0_subblock x in1_subblock
@@ -72,33 +261,97 @@ void MAIN {
                                 int in0_index = in0_index_subblock_offset + in0_index_h_offset + inner_dim;
                                 int in1_index = in1_index_subblock_offset + in1_index_inner_dim_offset + w;
                                 matmul_tiles(           // dst register에 값을 누적해서 더한다. (overwrite 하는게 아님)
-                                    tt::CBIndex::c_0,
-                                    tt::CBIndex::c_1,
+                                    cb_in0,
+                                    cb_in1,
                                     in0_index,
                                     in1_index,
                                     dst_index,
-                                    false /* transpose */);
+                                    transpose_in1);
                                 in1_index_inner_dim_offset += in1_per_core_w;
                             }
                             dst_index++;
                         }
-                        in0_index_h_offset += in0_block_w;
+                        in0_index_h_offset += in0_row_stride;
                     }
 
                     if (last_out) {
+#ifdef MOD_EPILOGUE
+                        // dst register 0: 누적된 uint32 결과, 1 ~ 6: scratch
+                        barrett_reduce32_tile<q_bits>(0, 1, 2, 3, 4, 5, 6, q, mu);
+                        mm_init_short(cb_in0, cb_in1, transpose_in1);
+#endif
+#ifdef FUSE_SCALE
+                        binop_with_scalar_tile_init();
+                        for (uint32_t i = 0; i < out_subblock_num_tiles; i++) {
+                            mul_unary_tile(i, FUSE_SCALE);
+                        }
+#endif
+#ifdef FUSE_BIAS
+                        binary_dest_reuse_tiles_init<ELWADD, EltwiseBinaryReuseDestType::DEST_TO_SRCA>(
+                            tt::CBIndex::c_2);
+                        for (uint32_t h = 0; h < out_subblock_h; h++) {
+                            for (uint32_t w = 0; w < out_subblock_w; w++) {
+                                binary_dest_reuse_tiles<ELWADD, EltwiseBinaryReuseDestType::DEST_TO_SRCA>(
+                                    tt::CBIndex::c_2, in1_index_subblock_offset + w, h * out_subblock_w + w);
+                            }
+                        }
+#endif
+#ifdef FUSE_ACTIVATION
+#if FUSE_ACTIVATION == 1
+                        relu_tile_init();
+#elif FUSE_ACTIVATION == 2
+                        gelu_tile_init<false>();
+#else
+                        silu_tile_init();
+#endif
+                        for (uint32_t i = 0; i < out_subblock_num_tiles; i++) {
+#if FUSE_ACTIVATION == 1
+                            relu_tile(i);
+#elif FUSE_ACTIVATION == 2
+                            gelu_tile<false>(i);
+#else
+                            silu_tile(i);
+#endif
+                        }
+#endif
+#ifdef FUSED_EPILOGUE
+                        mm_init_short(cb_in0, cb_in1, transpose_in1);
+#endif
+#ifdef PACK_RECONFIG_DF
+                        // c_24 (fp32 partial) 과 c_16 형식이 다르면 packer 형식을 바꿔 가며 pack 한다.
+                        pack_reconfig_data_format(tt::CBIndex::c_16);
+#endif
                         // Pack out to output buffer
+#ifdef ROW_MAJOR_IO
+                        // sub-block row 하나를 c_16에 row-major로 모은다. (행렬 row 하나 = per_core_N tiles 폭)
+                        if (in1_subblock == 0) {
+                            cb_reserve_back(tt::CBIndex::c_16, out_subblock_h * in1_per_core_w);
+                        }
+                        pack_untilize_dest<untilize_block_ct, untilize_full_ct>(
+                            tt::CBIndex::c_16, out_subblock_h, in1_subblock);
+                        if (in1_subblock == num_subblocks_w - 1) {
+                            cb_push_back(tt::CBIndex::c_16, out_subblock_h * in1_per_core_w);
+                        }
+#else
                         cb_reserve_back(tt::CBIndex::c_16, out_subblock_num_tiles);
                         for (uint32_t i = 0; i < out_subblock_num_tiles; i++) {
                             pack_tile(i, tt::CBIndex::c_16);
                         }
                         cb_push_back(tt::CBIndex::c_16, out_subblock_num_tiles);
+#endif
                     } else {
+#ifndef SEPARATE_INTERM_CB
                         // Wait for tiles in output buffer to be written out since interm and output share memory
+                        // (SEPARATE_INTERM_CB: c_24가 따로 있으면 writer를 기다리지 않고 다음 batch를 시작한다.)
                         if (block == 0) {
                             cb_reserve_back(tt::CBIndex::c_16, out_num_tiles_to_wait);
                             out_num_tiles_to_wait += out_subblock_num_tiles;
                         }
+#endif
                         // Move partial result to interm buffer
+#ifdef PACK_RECONFIG_DF
+                        pack_reconfig_data_format(tt::CBIndex::c_24);
+#endif
                         cb_reserve_back(tt::CBIndex::c_24, out_subblock_num_tiles);
                         for (uint32_t i = 0; i < out_subblock_num_tiles; i++) {
                             pack_tile(i, tt::CBIndex::c_24);
@@ -109,7 +362,7 @@ void MAIN {
                     release_dst();
                     in1_index_subblock_offset += out_subblock_w;
                 }
-                in0_index_subblock_offset += in0_subblock_num_tiles;
+                in0_index_subblock_offset += out_subblock_h * in0_row_stride;
             }
 
             /*
@@ -122,11 +375,26 @@ void MAIN {
             if (spill) {
                 enable_reload = true;
             }
+#ifdef ROW_MAJOR_IO
+            if (last_out) {
+                pack_untilize_uninit(tt::CBIndex::c_16);
+            }
+#endif
 
             // 계산을 마친 데이터는 pop을 해서 cb에서 제거한다.
-            cb_pop_front(tt::CBIndex::c_0, in0_block_num_tiles);
-            cb_pop_front(tt::CBIndex::c_1, in1_block_num_tiles);
+#ifndef IN0_SHARDED
+            cb_pop_front(cb_in0, in0_block_num_tiles);
+#endif
+            cb_pop_front(cb_in1, in1_block_num_tiles);
         }
     }
+
+#ifdef IN0_SHARDED
+    cb_pop_front(cb_in0, in0_block_num_tiles * num_blocks);
+#endif
+
+#ifdef FUSE_BIAS
+    cb_pop_front(tt::CBIndex::c_2, in1_per_core_w);
+#endif
 }
 }  // namespace NAMESPACE
\ No newline at end of file
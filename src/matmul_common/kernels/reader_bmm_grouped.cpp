@@ -0,0 +1,97 @@
+#include <stdint.h>
+#include "dataflow_api.h"
+#include "bmm_dataflow_utils.h"
+
+/*
+    grouped matmul reader. (bmm_grouped_program.hpp)
+
+    group 마다 shape (Mt, Nt, Kt) 과 operand 주소가 다르고, 이는 DRAM의 descriptor table에 있다.
+    시작할 때 table 전체를 c_3 으로 읽어 writer와 같이 쓴다. core는 host가 나눠 준 work item
+    (group, output block y, output block x) 을 차례로 처리하며, block은 reader_bmm_tile_layout_padded 와 같이
+    group 행렬 밖의 tile을 0으로 채운다.
+    모든 group의 buffer는 같은 종류 (interleaved DRAM, 같은 tile 크기) 이므로 TensorAccessorArgs 하나로
+    item 마다 주소만 바꿔 TensorAccessor를 만든다.
+
+    runtime args: table_addr, table_bytes, per_core_M, per_core_N, in0_block_w, num_items,
+                  item 마다 (group, block_y, block_x)
+*/
+void kernel_main() {
+    uint32_t table_addr = get_arg_val<uint32_t>(0);
+    uint32_t table_bytes = get_arg_val<uint32_t>(1);
+    uint32_t per_core_M = get_arg_val<uint32_t>(2);
+    uint32_t per_core_N = get_arg_val<uint32_t>(3);
+    uint32_t in0_block_w = get_arg_val<uint32_t>(4);
+    uint32_t num_items = get_arg_val<uint32_t>(5);
+    constexpr uint32_t items_arg_start = 6;
+
+    constexpr uint32_t cb_id_in0 = 0;
+    constexpr uint32_t cb_id_in1 = 1;
+    constexpr uint32_t cb_id_desc = 3;
+
+    const uint32_t in0_single_tile_size_bytes = get_tile_size(cb_id_in0);
+    const uint32_t in1_single_tile_size_bytes = get_tile_size(cb_id_in1);
+    const uint32_t in0_block_num_tiles = per_core_M * in0_block_w;
+    const uint32_t in1_block_num_tiles = in0_block_w * per_core_N;
+
+    constexpr auto s0_args = TensorAccessorArgs<0>();
+    constexpr auto s1_args = TensorAccessorArgs<s0_args.next_compile_time_args_offset()>();
+    constexpr auto table_args = TensorAccessorArgs<s1_args.next_compile_time_args_offset()>();
+    const auto table = TensorAccessor(table_args, table_addr, table_bytes);
+
+    // descriptor table은 page 하나이다. writer도 읽으므로 push만 하고 pop 하지 않는다.
+    cb_reserve_back(cb_id_desc, 1);
+    uint32_t table_l1_addr = get_write_ptr(cb_id_desc);
+    noc_async_read_tile(0, table, table_l1_addr);
+    noc_async_read_barrier();
+    cb_push_back(cb_id_desc, 1);
+    volatile tt_l1_ptr matmul_group_desc_t* groups =
+        reinterpret_cast<volatile tt_l1_ptr matmul_group_desc_t*>(table_l1_addr);
+
+    for (uint32_t item = 0; item < num_items; item++) {
+        uint32_t group = get_arg_val<uint32_t>(items_arg_start + item * 3);
+        uint32_t block_y = get_arg_val<uint32_t>(items_arg_start + item * 3 + 1);
+        uint32_t block_x = get_arg_val<uint32_t>(items_arg_start + item * 3 + 2);
+
+        uint32_t Mt = groups[group].Mt;
+        uint32_t Nt = groups[group].Nt;
+        uint32_t Kt = groups[group].Kt;
+        const auto s0 = TensorAccessor(s0_args, groups[group].in0_addr, in0_single_tile_size_bytes);
+        const auto s1 = TensorAccessor(s1_args, groups[group].in1_addr, in1_single_tile_size_bytes);
+
+        uint32_t out_row_start = block_y * per_core_M;
+        uint32_t out_col_start = block_x * per_core_N;
+        uint32_t num_k_blocks = (Kt + in0_block_w - 1) / in0_block_w;
+
+        for (uint32_t kb = 0; kb < num_k_blocks; kb++) {
+            uint32_t k_start = kb * in0_block_w;
+
+            cb_reserve_back(cb_id_in0, in0_block_num_tiles);
+            cb_reserve_back(cb_id_in1, in1_block_num_tiles);
+
+            read_block_padded(
+                s0,
+                get_write_ptr(cb_id_in0),
+                out_row_start,
+                k_start,
+                per_core_M,
+                in0_block_w,
+                Mt,
+                Kt,
+                in0_single_tile_size_bytes);
+            read_block_padded(
+                s1,
+                get_write_ptr(cb_id_in1),
+                k_start,
+                out_col_start,
+                in0_block_w,
+                per_core_N,
+                Kt,
+                Nt,
+                in1_single_tile_size_bytes);
+            noc_async_read_barrier();
+
+            cb_push_back(cb_id_in0, in0_block_num_tiles);
+            cb_push_back(cb_id_in1, in1_block_num_tiles);
+        }
+    }
+}
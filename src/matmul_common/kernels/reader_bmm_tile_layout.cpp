@@ -1,5 +1,6 @@
 #include <stdint.h>
 #include "dataflow_api.h"
+#include "bmm_dataflow_utils.h"
 
 void kernel_main() {
     // in0 tensor args
@@ -41,28 +42,105 @@ void kernel_main() {
     const uint32_t in0_single_tile_size_bytes = get_tile_size(cb_id_in0);
     const uint32_t in1_single_tile_size_bytes = get_tile_size(cb_id_in1);
 
+#ifdef ROW_MAJOR_IO
+    // ROW_MAJOR_IO args: in0 / in1 이 row-major (page 하나 = 행렬 row 하나) 로 저장되어 있고, 저장된 행렬의 폭 (tiles).
+    // block 시작 tile id를 (row, column) 으로 바꿔서 block을 행렬 row 단위로 읽는다. (read_block_from_row_major)
+    // compute가 c_0 / c_1 을 tilize 한다.
+    uint32_t in0_width_tiles = get_arg_val<uint32_t>(24);
+    uint32_t in1_width_tiles = get_arg_val<uint32_t>(25);
+    const uint32_t in0_page_size_bytes = in0_width_tiles * (in0_single_tile_size_bytes / 32);
+    const uint32_t in1_page_size_bytes = in1_width_tiles * (in1_single_tile_size_bytes / 32);
+#else
+    const uint32_t in0_page_size_bytes = in0_single_tile_size_bytes;
+    const uint32_t in1_page_size_bytes = in1_single_tile_size_bytes;
+#endif
+
+#ifdef BANK_ROTATE
+    // BANK_ROTATE: core마다 K block k_block_start 부터 돌아서 읽어 같은 때에 core들이 서로 다른 DRAM bank를 읽게 한다.
+    uint32_t k_block_start = get_arg_val<uint32_t>(26);
+#endif
+
+#ifndef IN0_SHARDED
     uint32_t l1_write_addr_in0;
+#endif
+#ifndef IN1_L1_RESIDENT
     uint32_t l1_write_addr_in1;
+#endif
 
     constexpr auto s0_args = TensorAccessorArgs<0>();
-    const auto s0 = TensorAccessor(s0_args, in0_tensor_addr, in0_single_tile_size_bytes);
+    const auto s0 = TensorAccessor(s0_args, in0_tensor_addr, in0_page_size_bytes);
     constexpr auto s1_args = TensorAccessorArgs<s0_args.next_compile_time_args_offset()>();
-    const auto s1 = TensorAccessor(s1_args, in1_tensor_addr, in1_single_tile_size_bytes);
+    const auto s1 = TensorAccessor(s1_args, in1_tensor_addr, in1_page_size_bytes);
+
+#ifdef FUSE_BIAS
+    // bias args: bmm_large_block_zm의 fused epilogue가 쓰는 bias tile (per_core_N 개) 을 c_2에 한 번만 읽어 둔다.
+    uint32_t bias_tensor_addr = get_arg_val<uint32_t>(21);
+    uint32_t bias_tensor_start_tile_id = get_arg_val<uint32_t>(22);
+    uint32_t bias_num_tiles = get_arg_val<uint32_t>(23);
+
+    constexpr uint32_t cb_id_bias = 2;
+    const uint32_t bias_single_tile_size_bytes = get_tile_size(cb_id_bias);
+    constexpr auto s2_args = TensorAccessorArgs<s1_args.next_compile_time_args_offset()>();
+    const auto s2 = TensorAccessor(s2_args, bias_tensor_addr, bias_single_tile_size_bytes);
+
+    cb_reserve_back(cb_id_bias, bias_num_tiles);
+    uint32_t l1_write_addr_bias = get_write_ptr(cb_id_bias);
+    for (uint32_t i = 0; i < bias_num_tiles; i++) {
+        noc_async_read_tile(bias_tensor_start_tile_id + i, s2, l1_write_addr_bias);
+        l1_write_addr_bias += bias_single_tile_size_bytes;
+    }
+    noc_async_read_barrier();
+    cb_push_back(cb_id_bias, bias_num_tiles);
+#endif
+
+#ifdef IN0_SHARDED
+    // IN0_SHARDED: c_0은 이 core의 A shard (in0_block_h x num_blocks * in0_block_w, row-major) 위에 있으므로 읽지 않고
+    // shard 전체를 한 번 push 한다. compute가 shard 안에서 block 위치를 계산해서 쓴다. (B == 1)
+    cb_reserve_back(cb_id_in0, in0_block_num_tiles * num_blocks);
+    cb_push_back(cb_id_in0, in0_block_num_tiles * num_blocks);
+#endif
 
     for (uint32_t b = 0; b < batch; b++) {
         uint32_t in0_tensor_current_block_start_tile_id = in0_tensor_start_tile_id;
         uint32_t in1_tensor_current_block_start_tile_id = in1_tensor_start_tile_id;
         for (uint32_t block = 0; block < num_blocks; block++) {
+#ifdef BANK_ROTATE
+            uint32_t k_block = block + k_block_start;
+            if (k_block >= num_blocks) {
+                k_block -= num_blocks;
+            }
+            in0_tensor_current_block_start_tile_id = in0_tensor_start_tile_id + k_block * in0_tensor_next_block_stride;
+            in1_tensor_current_block_start_tile_id = in1_tensor_start_tile_id + k_block * in1_tensor_next_block_stride;
+#endif
+#ifndef IN0_SHARDED
             cb_reserve_back(cb_id_in0, in0_block_num_tiles);
+#endif
+            // IN1_L1_RESIDENT: c_1은 B slice 전체 (num_blocks * in1_block_num_tiles) 가 이미 올라가 있는 L1 buffer
+            // 위에 있으므로 읽지 않고 reserve / push 만 해서 compute에 block을 넘긴다. 마지막 block 뒤에는 write
+            // pointer가 처음으로 돌아가므로 다음 batch도 같은 slice를 쓴다.
             cb_reserve_back(cb_id_in1, in1_block_num_tiles);
 
+#ifndef IN0_SHARDED
             l1_write_addr_in0 = get_write_ptr(cb_id_in0);
+#endif
+#ifndef IN1_L1_RESIDENT
             l1_write_addr_in1 = get_write_ptr(cb_id_in1);
+#endif
 
             // 데이터를 읽어 올 때는 block 단위로 읽어온다.
             // 본 예제에서는 A_block = 20x2 , B_block = 2x2
             // cb0에는 A_block의 tile 40개가 왼쪽->오른쪽, 위쪽->아래쪽으로 id(index)를 주면서 저장된다.
             // cb1에는 B_block의 tile 4개가가 왼쪽->오른쪽, 위쪽->아래쪽으로 id(index)를 주면서 저장된다.
+#ifndef IN0_SHARDED
+#ifdef ROW_MAJOR_IO
+            read_block_from_row_major(
+                s0,
+                in0_tensor_current_block_start_tile_id / in0_width_tiles,
+                in0_tensor_current_block_start_tile_id % in0_width_tiles,
+                in0_block_h,
+                in0_block_w,
+                l1_write_addr_in0);
+#else
             uint32_t in0_tensor_row_start_tile_id = in0_tensor_current_block_start_tile_id;
             for (uint32_t h = 0; h < in0_block_h; h++) {
                 uint32_t in0_tensor_tile_id = in0_tensor_row_start_tile_id;
@@ -73,8 +151,20 @@ void kernel_main() {
                 }
                 in0_tensor_row_start_tile_id += in0_tensor_stride_h;
             }
+#endif
             in0_tensor_current_block_start_tile_id += in0_tensor_next_block_stride;
-
+#endif
+
+#ifndef IN1_L1_RESIDENT
+#ifdef ROW_MAJOR_IO
+            read_block_from_row_major(
+                s1,
+                in1_tensor_current_block_start_tile_id / in1_width_tiles,
+                in1_tensor_current_block_start_tile_id % in1_width_tiles,
+                in1_block_h,
+                in1_block_w,
+                l1_write_addr_in1);
+#else
             uint32_t in1_tensor_row_start_tile_id = in1_tensor_current_block_start_tile_id;
             for (uint32_t h = 0; h < in1_block_h; h++) {
                 uint32_t in1_tensor_tile_id = in1_tensor_row_start_tile_id;
@@ -85,11 +175,15 @@ void kernel_main() {
                 }
                 in1_tensor_row_start_tile_id += in1_tensor_stride_h;
             }
+#endif
             in1_tensor_current_block_start_tile_id += in1_tensor_next_block_stride;
+#endif
 
             noc_async_read_barrier();
 
+#ifndef IN0_SHARDED
             cb_push_back(cb_id_in0, in0_block_num_tiles);
+#endif
             cb_push_back(cb_id_in1, in1_block_num_tiles);
         }
         if (bcast_B == 0) {
@@ -0,0 +1,247 @@
+#include <stdint.h>
+#include "dataflow_api.h"
+
+/*
+    reader_bmm_tile_layout.cpp 의 multicast 버전.
+
+    같은 grid row의 core들은 같은 in0 block을, 같은 grid column의 core들은 같은 in1 block을 읽는다.
+    그래서 row의 x = 0 core만 in0 block을 DRAM에서 읽고 나머지 core들에게 multicast 하고,
+    column의 y = 0 core만 in1 block을 DRAM에서 읽고 나머지 core들에게 multicast 한다.
+
+    block 하나를 주고받는 순서 (noc_tile_transfer 예제와 같은 semaphore handshake):
+    1. receiver: cb_reserve_back 후 자기 receiver semaphore를 INVALID로 두고 sender의 sender semaphore를 1 올린다.
+    2. sender: DRAM에서 block을 읽은 뒤 sender semaphore == num_dests (모든 receiver의 CB가 비어 있음) 를 기다린다.
+    3. sender: block을 같은 L1 주소(모든 core의 CB 설정과 진행이 같으므로 write pointer가 같다)로 multicast 하고
+       receiver semaphore에 VALID를 multicast 한다.
+    4. receiver: receiver semaphore == VALID 를 기다린 뒤 cb_push_back.
+
+    in0를 먼저, in1을 나중에 처리한다. in1 sender는 receiver들이 in0를 다 받은 뒤에야 준비 신호를 받으므로
+    두 단계 사이에 순환 대기는 생기지 않는다.
+*/
+
+constexpr uint32_t INVALID = 0;
+constexpr uint32_t VALID = 1;
+
+// block을 DRAM에서 CB로 읽는다. (reader_bmm_tile_layout.cpp 와 같은 순서)
+template <typename Accessor>
+inline void read_block(
+    const Accessor& s,
+    uint32_t l1_write_addr,
+    uint32_t block_start_tile_id,
+    uint32_t block_h,
+    uint32_t block_w,
+    uint32_t stride_h,
+    uint32_t stride_w,
+    uint32_t tile_size_bytes) {
+    uint32_t row_start_tile_id = block_start_tile_id;
+    for (uint32_t h = 0; h < block_h; h++) {
+        uint32_t tile_id = row_start_tile_id;
+        for (uint32_t w = 0; w < block_w; w++) {
+            noc_async_read_tile(tile_id, s, l1_write_addr);
+            l1_write_addr += tile_size_bytes;
+            tile_id += stride_w;
+        }
+        row_start_tile_id += stride_h;
+    }
+    noc_async_read_barrier();
+}
+
+inline void send_block(
+    uint32_t l1_addr,
+    uint32_t block_size_bytes,
+    uint32_t num_dests,
+    uint32_t dest_start_x,
+    uint32_t dest_start_y,
+    uint32_t dest_end_x,
+    uint32_t dest_end_y,
+    uint32_t sender_sem_addr,
+    uint32_t receiver_sem_addr) {
+    if (num_dests == 0) {
+        return;
+    }
+
+    volatile tt_l1_ptr uint32_t* sender_sem_ptr = reinterpret_cast<volatile tt_l1_ptr uint32_t*>(sender_sem_addr);
+
+    // 모든 receiver가 CB 공간을 확보할 때까지 기다린다.
+    noc_semaphore_wait(sender_sem_ptr, num_dests);
+    noc_semaphore_set(sender_sem_ptr, 0);
+
+    // NOC_1은 반대 방향으로 routing 되므로 multicast 사각형의 start / end 가 뒤바뀐다.
+    uint64_t mcast_data_addr;
+    uint64_t mcast_sem_addr;
+    if (noc_index == 0) {
+        mcast_data_addr = get_noc_multicast_addr(dest_start_x, dest_start_y, dest_end_x, dest_end_y, l1_addr);
+        mcast_sem_addr = get_noc_multicast_addr(dest_start_x, dest_start_y, dest_end_x, dest_end_y, receiver_sem_addr);
+    } else {
+        mcast_data_addr = get_noc_multicast_addr(dest_end_x, dest_end_y, dest_start_x, dest_start_y, l1_addr);
+        mcast_sem_addr = get_noc_multicast_addr(dest_end_x, dest_end_y, dest_start_x, dest_start_y, receiver_sem_addr);
+    }
+
+    noc_async_write_multicast(l1_addr, mcast_data_addr, block_size_bytes, num_dests);
+    // 같은 NoC / VC 이므로 data가 semaphore보다 먼저 도착한다.
+    noc_semaphore_set_multicast(receiver_sem_addr, mcast_sem_addr, num_dests);
+    noc_async_write_barrier();
+}
+
+inline void receive_block(
+    uint32_t sender_noc_x, uint32_t sender_noc_y, uint32_t sender_sem_addr, uint32_t receiver_sem_addr) {
+    volatile tt_l1_ptr uint32_t* receiver_sem_ptr =
+        reinterpret_cast<volatile tt_l1_ptr uint32_t*>(receiver_sem_addr);
+
+    noc_semaphore_set(receiver_sem_ptr, INVALID);
+
+    uint64_t remote_sender_sem_addr = get_noc_addr(sender_noc_x, sender_noc_y, sender_sem_addr);
+    noc_semaphore_inc(remote_sender_sem_addr, 1);
+
+    noc_semaphore_wait(receiver_sem_ptr, VALID);
+}
+
+void kernel_main() {
+    // in0 tensor args
+    uint32_t in0_tensor_addr = get_arg_val<uint32_t>(0);
+    uint32_t in0_tensor_start_tile_id = get_arg_val<uint32_t>(1);
+    uint32_t in0_tensor_stride_w = get_arg_val<uint32_t>(2);
+    uint32_t in0_tensor_stride_h = get_arg_val<uint32_t>(3);
+    uint32_t in0_tensor_next_block_stride = get_arg_val<uint32_t>(4);
+
+    // in0 block args
+    uint32_t in0_block_w = get_arg_val<uint32_t>(5);
+    uint32_t in0_block_h = get_arg_val<uint32_t>(6);
+    uint32_t in0_block_num_tiles = get_arg_val<uint32_t>(7);
+
+    // in1 tensor args
+    uint32_t in1_tensor_addr = get_arg_val<uint32_t>(8);
+    uint32_t in1_tensor_start_tile_id = get_arg_val<uint32_t>(9);
+    uint32_t in1_tensor_stride_w = get_arg_val<uint32_t>(10);
+    uint32_t in1_tensor_stride_h = get_arg_val<uint32_t>(11);
+    uint32_t in1_tensor_next_block_stride = get_arg_val<uint32_t>(12);
+
+    // in1 block args
+    uint32_t in1_block_w = get_arg_val<uint32_t>(13);
+    uint32_t in1_block_h = get_arg_val<uint32_t>(14);
+    uint32_t in1_block_num_tiles = get_arg_val<uint32_t>(15);
+
+    // in0/in1 common args
+    uint32_t num_blocks = get_arg_val<uint32_t>(16);
+
+    // batch args
+    uint32_t MtKt = get_arg_val<uint32_t>(17);
+    uint32_t KtNt = get_arg_val<uint32_t>(18);
+    uint32_t batch = get_arg_val<uint32_t>(19);
+    uint32_t bcast_B = get_arg_val<uint32_t>(20);
+
+    // in0 multicast args (grid row)
+    uint32_t in0_is_sender = get_arg_val<uint32_t>(21);
+    uint32_t in0_sender_noc_x = get_arg_val<uint32_t>(22);
+    uint32_t in0_sender_noc_y = get_arg_val<uint32_t>(23);
+    uint32_t in0_mcast_dest_noc_start_x = get_arg_val<uint32_t>(24);
+    uint32_t in0_mcast_dest_noc_start_y = get_arg_val<uint32_t>(25);
+    uint32_t in0_mcast_dest_noc_end_x = get_arg_val<uint32_t>(26);
+    uint32_t in0_mcast_dest_noc_end_y = get_arg_val<uint32_t>(27);
+    uint32_t in0_mcast_num_dests = get_arg_val<uint32_t>(28);
+
+    // in1 multicast args (grid column)
+    uint32_t in1_is_sender = get_arg_val<uint32_t>(29);
+    uint32_t in1_sender_noc_x = get_arg_val<uint32_t>(30);
+    uint32_t in1_sender_noc_y = get_arg_val<uint32_t>(31);
+    uint32_t in1_mcast_dest_noc_start_x = get_arg_val<uint32_t>(32);
+    uint32_t in1_mcast_dest_noc_start_y = get_arg_val<uint32_t>(33);
+    uint32_t in1_mcast_dest_noc_end_x = get_arg_val<uint32_t>(34);
+    uint32_t in1_mcast_dest_noc_end_y = get_arg_val<uint32_t>(35);
+    uint32_t in1_mcast_num_dests = get_arg_val<uint32_t>(36);
+
+    // semaphores
+    uint32_t in0_mcast_sender_sem_addr = get_semaphore(get_arg_val<uint32_t>(37));
+    uint32_t in0_mcast_receiver_sem_addr = get_semaphore(get_arg_val<uint32_t>(38));
+    uint32_t in1_mcast_sender_sem_addr = get_semaphore(get_arg_val<uint32_t>(39));
+    uint32_t in1_mcast_receiver_sem_addr = get_semaphore(get_arg_val<uint32_t>(40));
+
+    constexpr uint32_t cb_id_in0 = 0;
+    constexpr uint32_t cb_id_in1 = 1;
+
+    const uint32_t in0_single_tile_size_bytes = get_tile_size(cb_id_in0);
+    const uint32_t in1_single_tile_size_bytes = get_tile_size(cb_id_in1);
+    const uint32_t in0_block_size_bytes = in0_block_num_tiles * in0_single_tile_size_bytes;
+    const uint32_t in1_block_size_bytes = in1_block_num_tiles * in1_single_tile_size_bytes;
+
+    constexpr auto s0_args = TensorAccessorArgs<0>();
+    const auto s0 = TensorAccessor(s0_args, in0_tensor_addr, in0_single_tile_size_bytes);
+    constexpr auto s1_args = TensorAccessorArgs<s0_args.next_compile_time_args_offset()>();
+    const auto s1 = TensorAccessor(s1_args, in1_tensor_addr, in1_single_tile_size_bytes);
+
+    // sender는 자기 receiver semaphore의 VALID 값을 receiver들에게 multicast 하는 source로 쓴다.
+    if (in0_is_sender) {
+        *reinterpret_cast<volatile tt_l1_ptr uint32_t*>(in0_mcast_receiver_sem_addr) = VALID;
+    }
+    if (in1_is_sender) {
+        *reinterpret_cast<volatile tt_l1_ptr uint32_t*>(in1_mcast_receiver_sem_addr) = VALID;
+    }
+
+    for (uint32_t b = 0; b < batch; b++) {
+        uint32_t in0_tensor_current_block_start_tile_id = in0_tensor_start_tile_id;
+        uint32_t in1_tensor_current_block_start_tile_id = in1_tensor_start_tile_id;
+        for (uint32_t block = 0; block < num_blocks; block++) {
+            cb_reserve_back(cb_id_in0, in0_block_num_tiles);
+            uint32_t l1_write_addr_in0 = get_write_ptr(cb_id_in0);
+            if (in0_is_sender) {
+                read_block(
+                    s0,
+                    l1_write_addr_in0,
+                    in0_tensor_current_block_start_tile_id,
+                    in0_block_h,
+                    in0_block_w,
+                    in0_tensor_stride_h,
+                    in0_tensor_stride_w,
+                    in0_single_tile_size_bytes);
+                send_block(
+                    l1_write_addr_in0,
+                    in0_block_size_bytes,
+                    in0_mcast_num_dests,
+                    in0_mcast_dest_noc_start_x,
+                    in0_mcast_dest_noc_start_y,
+                    in0_mcast_dest_noc_end_x,
+                    in0_mcast_dest_noc_end_y,
+                    in0_mcast_sender_sem_addr,
+                    in0_mcast_receiver_sem_addr);
+            } else {
+                receive_block(
+                    in0_sender_noc_x, in0_sender_noc_y, in0_mcast_sender_sem_addr, in0_mcast_receiver_sem_addr);
+            }
+            cb_push_back(cb_id_in0, in0_block_num_tiles);
+            in0_tensor_current_block_start_tile_id += in0_tensor_next_block_stride;
+
+            cb_reserve_back(cb_id_in1, in1_block_num_tiles);
+            uint32_t l1_write_addr_in1 = get_write_ptr(cb_id_in1);
+            if (in1_is_sender) {
+                read_block(
+                    s1,
+                    l1_write_addr_in1,
+                    in1_tensor_current_block_start_tile_id,
+                    in1_block_h,
+                    in1_block_w,
+                    in1_tensor_stride_h,
+                    in1_tensor_stride_w,
+                    in1_single_tile_size_bytes);
+                send_block(
+                    l1_write_addr_in1,
+                    in1_block_size_bytes,
+                    in1_mcast_num_dests,
+                    in1_mcast_dest_noc_start_x,
+                    in1_mcast_dest_noc_start_y,
+                    in1_mcast_dest_noc_end_x,
+                    in1_mcast_dest_noc_end_y,
+                    in1_mcast_sender_sem_addr,
+                    in1_mcast_receiver_sem_addr);
+            } else {
+                receive_block(
+                    in1_sender_noc_x, in1_sender_noc_y, in1_mcast_sender_sem_addr, in1_mcast_receiver_sem_addr);
+            }
+            cb_push_back(cb_id_in1, in1_block_num_tiles);
+            in1_tensor_current_block_start_tile_id += in1_tensor_next_block_stride;
+        }
+        if (bcast_B == 0) {
+            in1_tensor_start_tile_id += KtNt;
+        }
+        in0_tensor_start_tile_id += MtKt;
+    }
+}
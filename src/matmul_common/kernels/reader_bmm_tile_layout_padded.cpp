@@ -0,0 +1,84 @@
+#include <stdint.h>
+#include "dataflow_api.h"
+#include "bmm_dataflow_utils.h"
+
+/*
+    임의 크기 (Mt x Kt) * (Kt x Nt) 용 reader.
+
+    output은 per_core_M x per_core_N 크기의 block으로 나누고, 마지막 row / column의 block이 행렬 밖으로 나가면
+    그 부분의 tile은 DRAM에서 읽지 않고 0으로 채운다. K 방향도 in0_block_w의 배수가 아니면 같은 방식으로 채운다.
+    core 하나가 output block을 여러 개 (block_start 부터 block_count 개, batch 마다 row-major) 처리할 수 있다.
+    CB에는 항상 block 전체 크기로 push 하고, compute가 그 중 유효한 sub-block만 쓴다.
+*/
+void kernel_main() {
+    uint32_t in0_tensor_addr = get_arg_val<uint32_t>(0);
+    uint32_t in1_tensor_addr = get_arg_val<uint32_t>(1);
+    uint32_t Mt = get_arg_val<uint32_t>(2);  // 유효한 tile 수
+    uint32_t Kt = get_arg_val<uint32_t>(3);
+    uint32_t Nt = get_arg_val<uint32_t>(4);
+    uint32_t per_core_M = get_arg_val<uint32_t>(5);
+    uint32_t per_core_N = get_arg_val<uint32_t>(6);
+    uint32_t in0_block_w = get_arg_val<uint32_t>(7);
+    uint32_t num_k_blocks = get_arg_val<uint32_t>(8);
+    uint32_t num_blocks_x = get_arg_val<uint32_t>(9);  // N 방향 output block 수
+    uint32_t block_start = get_arg_val<uint32_t>(10);
+    uint32_t block_count = get_arg_val<uint32_t>(11);
+    uint32_t blocks_per_batch = get_arg_val<uint32_t>(12);  // batch 하나의 output block 수
+    uint32_t in1_batch_tiles = get_arg_val<uint32_t>(13);   // batch 마다 in1 offset (bcast 이면 0)
+
+    constexpr uint32_t cb_id_in0 = 0;
+    constexpr uint32_t cb_id_in1 = 1;
+
+    const uint32_t in0_single_tile_size_bytes = get_tile_size(cb_id_in0);
+    const uint32_t in1_single_tile_size_bytes = get_tile_size(cb_id_in1);
+    const uint32_t in0_block_num_tiles = per_core_M * in0_block_w;
+    const uint32_t in1_block_num_tiles = in0_block_w * per_core_N;
+
+    constexpr auto s0_args = TensorAccessorArgs<0>();
+    const auto s0 = TensorAccessor(s0_args, in0_tensor_addr, in0_single_tile_size_bytes);
+    constexpr auto s1_args = TensorAccessorArgs<s0_args.next_compile_time_args_offset()>();
+    const auto s1 = TensorAccessor(s1_args, in1_tensor_addr, in1_single_tile_size_bytes);
+
+    for (uint32_t block = block_start; block < block_start + block_count; block++) {
+        uint32_t batch = block / blocks_per_batch;
+        uint32_t block_in_batch = block % blocks_per_batch;
+        uint32_t out_row_start = (block_in_batch / num_blocks_x) * per_core_M;
+        uint32_t out_col_start = (block_in_batch % num_blocks_x) * per_core_N;
+        uint32_t in0_tile_offset = batch * Mt * Kt;
+        uint32_t in1_tile_offset = batch * in1_batch_tiles;
+
+        for (uint32_t kb = 0; kb < num_k_blocks; kb++) {
+            uint32_t k_start = kb * in0_block_w;
+
+            cb_reserve_back(cb_id_in0, in0_block_num_tiles);
+            cb_reserve_back(cb_id_in1, in1_block_num_tiles);
+
+            read_block_padded(
+                s0,
+                get_write_ptr(cb_id_in0),
+                out_row_start,
+                k_start,
+                per_core_M,
+                in0_block_w,
+                Mt,
+                Kt,
+                in0_single_tile_size_bytes,
+                in0_tile_offset);
+            read_block_padded(
+                s1,
+                get_write_ptr(cb_id_in1),
+                k_start,
+                out_col_start,
+                in0_block_w,
+                per_core_N,
+                Kt,
+                Nt,
+                in1_single_tile_size_bytes,
+                in1_tile_offset);
+            noc_async_read_barrier();
+
+            cb_push_back(cb_id_in0, in0_block_num_tiles);
+            cb_push_back(cb_id_in1, in1_block_num_tiles);
+        }
+    }
+}
@@ -0,0 +1,113 @@
+#include <stdint.h>
+#include "dataflow_api.h"
+#include "bmm_dataflow_utils.h"
+
+/*
+    block-sparse B 용 reader. (bmm_sparse_program.hpp)
+
+    B (Kt x Nt tiles) 는 0이 아닌 tile만 CSR 순서 (tile row k 마다 column 오름차순) 로 DRAM에 있고,
+    index buffer에 row_ptr (Kt + 1 개) 와 col_idx (nnz 개) 가 이어서 있다. 시작할 때 index를 c_3 으로 읽는다.
+    core의 output column 구간 [out_col_start, out_col_start + per_core_N) 에 0이 아닌 tile이 하나라도 있는 k만
+    "present" 이고, present k 의 A column (per_core_M tiles) 과 B row 구간만 읽는다. 구간 안의 0 tile은 읽지 않고
+    0으로 채운다. present k를 in0_block_w 개씩 모아 block 하나로 보내며, 마지막 block의 빈 자리와
+    present k가 하나도 없을 때의 block 하나는 0 tile이다. (compute가 output을 한 번은 pack 해야 한다.)
+    compute kernel은 bmm_large_block_zm (GROUPED_WORK_ITEMS) 이고, K block 수 (num_k_blocks) 는 host가 같은
+    index로 계산해서 reader와 compute에 같이 준다.
+*/
+void kernel_main() {
+    uint32_t in0_tensor_addr = get_arg_val<uint32_t>(0);
+    uint32_t in1_tensor_addr = get_arg_val<uint32_t>(1);  // 0이 아닌 B tile (CSR 순서)
+    uint32_t index_addr = get_arg_val<uint32_t>(2);
+    uint32_t index_bytes = get_arg_val<uint32_t>(3);
+    uint32_t Kt = get_arg_val<uint32_t>(4);
+    uint32_t per_core_M = get_arg_val<uint32_t>(5);
+    uint32_t per_core_N = get_arg_val<uint32_t>(6);
+    uint32_t in0_block_w = get_arg_val<uint32_t>(7);
+    uint32_t out_row_start = get_arg_val<uint32_t>(8);
+    uint32_t out_col_start = get_arg_val<uint32_t>(9);
+    uint32_t num_k_blocks = get_arg_val<uint32_t>(10);  // max(1, ceil(present k 수 / in0_block_w))
+
+    constexpr uint32_t cb_id_in0 = 0;
+    constexpr uint32_t cb_id_in1 = 1;
+    constexpr uint32_t cb_id_index = 3;
+
+    const uint32_t in0_single_tile_size_bytes = get_tile_size(cb_id_in0);
+    const uint32_t in1_single_tile_size_bytes = get_tile_size(cb_id_in1);
+    const uint32_t in0_block_num_tiles = per_core_M * in0_block_w;
+    const uint32_t in1_block_num_tiles = in0_block_w * per_core_N;
+    const uint32_t out_col_end = out_col_start + per_core_N;
+
+    constexpr auto s0_args = TensorAccessorArgs<0>();
+    const auto s0 = TensorAccessor(s0_args, in0_tensor_addr, in0_single_tile_size_bytes);
+    constexpr auto s1_args = TensorAccessorArgs<s0_args.next_compile_time_args_offset()>();
+    const auto s1 = TensorAccessor(s1_args, in1_tensor_addr, in1_single_tile_size_bytes);
+    constexpr auto index_args = TensorAccessorArgs<s1_args.next_compile_time_args_offset()>();
+    const auto index = TensorAccessor(index_args, index_addr, index_bytes);
+
+    cb_reserve_back(cb_id_index, 1);
+    uint32_t index_l1_addr = get_write_ptr(cb_id_index);
+    noc_async_read_tile(0, index, index_l1_addr);
+    noc_async_read_barrier();
+    volatile tt_l1_ptr uint32_t* row_ptr = reinterpret_cast<volatile tt_l1_ptr uint32_t*>(index_l1_addr);
+    volatile tt_l1_ptr uint32_t* col_idx = row_ptr + Kt + 1;
+
+    uint32_t k = 0;
+    for (uint32_t kb = 0; kb < num_k_blocks; kb++) {
+        cb_reserve_back(cb_id_in0, in0_block_num_tiles);
+        cb_reserve_back(cb_id_in1, in1_block_num_tiles);
+        uint32_t l1_write_addr_in0 = get_write_ptr(cb_id_in0);
+        uint32_t l1_write_addr_in1 = get_write_ptr(cb_id_in1);
+
+        // block의 inner_dim 자리 w 에 다음 present k 를 채운다. (c_0: row-major per_core_M x in0_block_w,
+        // c_1: row-major in0_block_w x per_core_N)
+        for (uint32_t w = 0; w < in0_block_w; w++) {
+            uint32_t p = 0;
+            uint32_t p_end = 0;
+            for (; k < Kt; k++) {
+                p = row_ptr[k];
+                p_end = row_ptr[k + 1];
+                while (p < p_end && col_idx[p] < out_col_start) {
+                    p++;
+                }
+                if (p < p_end && col_idx[p] < out_col_end) {
+                    break;
+                }
+            }
+
+            uint32_t in1_row_addr = l1_write_addr_in1 + w * per_core_N * in1_single_tile_size_bytes;
+            if (k == Kt) {
+                for (uint32_t h = 0; h < per_core_M; h++) {
+                    fill_zero_tile(
+                        l1_write_addr_in0 + (h * in0_block_w + w) * in0_single_tile_size_bytes,
+                        in0_single_tile_size_bytes);
+                }
+                for (uint32_t n = 0; n < per_core_N; n++) {
+                    fill_zero_tile(in1_row_addr + n * in1_single_tile_size_bytes, in1_single_tile_size_bytes);
+                }
+                continue;
+            }
+
+            for (uint32_t h = 0; h < per_core_M; h++) {
+                noc_async_read_tile(
+                    (out_row_start + h) * Kt + k,
+                    s0,
+                    l1_write_addr_in0 + (h * in0_block_w + w) * in0_single_tile_size_bytes);
+            }
+            // col_idx는 row 안에서 오름차순이므로 구간 안의 tile을 한 번 훑으면서 빈 column은 0으로 채운다.
+            for (uint32_t n = out_col_start; n < out_col_end; n++) {
+                uint32_t l1_addr = in1_row_addr + (n - out_col_start) * in1_single_tile_size_bytes;
+                if (p < p_end && col_idx[p] == n) {
+                    noc_async_read_tile(p, s1, l1_addr);
+                    p++;
+                } else {
+                    fill_zero_tile(l1_addr, in1_single_tile_size_bytes);
+                }
+            }
+            k++;
+        }
+        noc_async_read_barrier();
+
+        cb_push_back(cb_id_in0, in0_block_num_tiles);
+        cb_push_back(cb_id_in1, in1_block_num_tiles);
+    }
+}
@@ -0,0 +1,66 @@
+#include <stdint.h>
+#include "dataflow_api.h"
+#include "bmm_dataflow_utils.h"
+
+/*
+    reader_bmm_grouped.cpp 와 짝이 되는 writer.
+    descriptor table은 reader가 c_3 에 읽어 둔 것을 같이 본다. item 마다 그 group의 output (Mt x Nt) 안의
+    tile만 쓰고 block padding은 버린다. (writer_bmm_tile_layout_padded 와 같은 방식)
+
+    runtime args: per_core_M, per_core_N, out_subblock_h, out_subblock_w, num_items,
+                  item 마다 (group, block_y, block_x)
+*/
+void kernel_main() {
+    uint32_t per_core_M = get_arg_val<uint32_t>(0);
+    uint32_t per_core_N = get_arg_val<uint32_t>(1);
+    uint32_t out_subblock_h = get_arg_val<uint32_t>(2);
+    uint32_t out_subblock_w = get_arg_val<uint32_t>(3);
+    uint32_t num_items = get_arg_val<uint32_t>(4);
+    constexpr uint32_t items_arg_start = 5;
+
+    constexpr uint32_t cb_id_out0 = 16;
+    constexpr uint32_t cb_id_desc = 3;
+
+    const uint32_t single_tile_size_bytes = get_tile_size(cb_id_out0);
+    const uint32_t out_subblock_tile_count = out_subblock_h * out_subblock_w;
+
+    constexpr auto s_args = TensorAccessorArgs<0>();
+
+    cb_wait_front(cb_id_desc, 1);
+    volatile tt_l1_ptr matmul_group_desc_t* groups =
+        reinterpret_cast<volatile tt_l1_ptr matmul_group_desc_t*>(get_read_ptr(cb_id_desc));
+
+    for (uint32_t item = 0; item < num_items; item++) {
+        uint32_t group = get_arg_val<uint32_t>(items_arg_start + item * 3);
+        uint32_t block_y = get_arg_val<uint32_t>(items_arg_start + item * 3 + 1);
+        uint32_t block_x = get_arg_val<uint32_t>(items_arg_start + item * 3 + 2);
+
+        uint32_t Mt = groups[group].Mt;
+        uint32_t Nt = groups[group].Nt;
+        const auto s = TensorAccessor(s_args, groups[group].out_addr, single_tile_size_bytes);
+
+        uint32_t out_row_start = block_y * per_core_M;
+        uint32_t out_col_start = block_x * per_core_N;
+
+        for (uint32_t sbh = 0; sbh < per_core_M / out_subblock_h; sbh++) {
+            for (uint32_t sbw = 0; sbw < per_core_N / out_subblock_w; sbw++) {
+                cb_wait_front(cb_id_out0, out_subblock_tile_count);
+                uint32_t l1_read_addr = get_read_ptr(cb_id_out0);
+
+                for (uint32_t h = 0; h < out_subblock_h; h++) {
+                    uint32_t row = out_row_start + sbh * out_subblock_h + h;
+                    for (uint32_t w = 0; w < out_subblock_w; w++) {
+                        uint32_t col = out_col_start + sbw * out_subblock_w + w;
+                        if (row < Mt && col < Nt) {
+                            noc_async_write_tile(row * Nt + col, s, l1_read_addr);
+                        }
+                        l1_read_addr += single_tile_size_bytes;
+                    }
+                }
+
+                noc_async_write_barrier();
+                cb_pop_front(cb_id_out0, out_subblock_tile_count);
+            }
+        }
+    }
+}
@@ -1,4 +1,5 @@
 #include "dataflow_api.h"
+#include "bmm_dataflow_utils.h"
 
 void kernel_main() {
     // out tensor args
@@ -25,12 +26,38 @@ void kernel_main() {
     // single-tile
     const uint32_t single_tile_size_bytes = get_tile_size(cb_id_out0);
 
+#ifdef ROW_MAJOR_IO
+    // ROW_MAJOR_IO: output은 row-major (page 하나 = 행렬 row 하나, Nt tiles 폭) 이다.
+    // compute가 sub-block row 하나 (out_subblock_h x per_core_N tiles) 를 untilize 해서 한 번에 push 하고,
+    // writer는 그것을 행렬 row 단위로 쓴다. (write_block_to_row_major)
+    uint32_t out_width_tiles = get_arg_val<uint32_t>(13);
+    const uint32_t page_size_bytes = out_width_tiles * (single_tile_size_bytes / 32);
+#else
+    const uint32_t page_size_bytes = single_tile_size_bytes;
+#endif
+
     constexpr auto s_args = TensorAccessorArgs<0>();
-    const auto s = TensorAccessor(s_args, out_tensor_addr, single_tile_size_bytes);
+    const auto s = TensorAccessor(s_args, out_tensor_addr, page_size_bytes);
 
     bool one_time_profile = true;
     for (uint32_t b = 0; b < batch; b++) {
         uint32_t out_tensor_sbh_start_tile_id = out_tensor_start_tile_id;
+#ifdef ROW_MAJOR_IO
+        const uint32_t out_row_group_tile_count = out_subblock_tile_count * out_num_subblocks_w;
+        for (uint32_t sbh = 0; sbh < out_num_subblocks_h; sbh++) {
+            cb_wait_front(cb_id_out0, out_row_group_tile_count);
+            write_block_to_row_major(
+                s,
+                out_tensor_sbh_start_tile_id / out_width_tiles,
+                out_tensor_sbh_start_tile_id % out_width_tiles,
+                out_subblock_h,
+                out_subblock_w * out_num_subblocks_w,
+                get_read_ptr(cb_id_out0));
+            noc_async_write_barrier();
+            cb_pop_front(cb_id_out0, out_row_group_tile_count);
+            out_tensor_sbh_start_tile_id += out_tensor_next_subblock_stride_h;
+        }
+#else
         for (uint32_t sbh = 0; sbh < out_num_subblocks_h; sbh++) {
             uint32_t out_tensor_sbw_start_tile_id = out_tensor_sbh_start_tile_id;
             for (uint32_t sbw = 0; sbw < out_num_subblocks_w; sbw++) {
@@ -62,6 +89,7 @@ void kernel_main() {
             }
             out_tensor_sbh_start_tile_id += out_tensor_next_subblock_stride_h;
         }
+#endif
         out_tensor_start_tile_id += MtNt;
     }
 }
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include <stdint.h>
+#include "dataflow_api.h"
+
+/*
+    reader_bmm_tile_layout_padded.cpp 와 짝이 되는 writer.
+    compute kernel (RAGGED_BLOCKS) 은 block 중 유효 범위 (Mt x Nt) 에 걸치는 sub-block만 내보내므로
+    writer도 같은 sub-block 수만큼 받는다. sub-block 안에서 행렬 밖으로 나가는 tile은 DRAM에 쓰지 않고 버린다.
+*/
+void kernel_main() {
+    uint32_t out_tensor_addr = get_arg_val<uint32_t>(0);
+    uint32_t Mt = get_arg_val<uint32_t>(1);  // 유효한 tile 수
+    uint32_t Nt = get_arg_val<uint32_t>(2);
+    uint32_t per_core_M = get_arg_val<uint32_t>(3);
+    uint32_t per_core_N = get_arg_val<uint32_t>(4);
+    uint32_t out_subblock_h = get_arg_val<uint32_t>(5);
+    uint32_t out_subblock_w = get_arg_val<uint32_t>(6);
+    uint32_t num_blocks_x = get_arg_val<uint32_t>(7);
+    uint32_t block_start = get_arg_val<uint32_t>(8);
+    uint32_t block_count = get_arg_val<uint32_t>(9);
+    uint32_t blocks_per_batch = get_arg_val<uint32_t>(10);
+
+    constexpr uint32_t cb_id_out0 = 16;
+
+    const uint32_t single_tile_size_bytes = get_tile_size(cb_id_out0);
+    const uint32_t out_subblock_tile_count = out_subblock_h * out_subblock_w;
+
+    constexpr auto s_args = TensorAccessorArgs<0>();
+    const auto s = TensorAccessor(s_args, out_tensor_addr, single_tile_size_bytes);
+
+    for (uint32_t block = block_start; block < block_start + block_count; block++) {
+        uint32_t batch = block / blocks_per_batch;
+        uint32_t block_in_batch = block % blocks_per_batch;
+        uint32_t out_row_start = (block_in_batch / num_blocks_x) * per_core_M;
+        uint32_t out_col_start = (block_in_batch % num_blocks_x) * per_core_N;
+        uint32_t out_tile_offset = batch * Mt * Nt;
+
+        // bmm_large_block_zm.cpp (RAGGED_BLOCKS) 와 같은 sub-block 수
+        uint32_t block_rows = Mt - out_row_start < per_core_M ? Mt - out_row_start : per_core_M;
+        uint32_t block_cols = Nt - out_col_start < per_core_N ? Nt - out_col_start : per_core_N;
+        uint32_t num_subblocks_h = (block_rows + out_subblock_h - 1) / out_subblock_h;
+        uint32_t num_subblocks_w = (block_cols + out_subblock_w - 1) / out_subblock_w;
+
+        for (uint32_t sbh = 0; sbh < num_subblocks_h; sbh++) {
+            for (uint32_t sbw = 0; sbw < num_subblocks_w; sbw++) {
+                cb_wait_front(cb_id_out0, out_subblock_tile_count);
+                uint32_t l1_read_addr = get_read_ptr(cb_id_out0);
+
+                for (uint32_t h = 0; h < out_subblock_h; h++) {
+                    uint32_t row = out_row_start + sbh * out_subblock_h + h;
+                    for (uint32_t w = 0; w < out_subblock_w; w++) {
+                        uint32_t col = out_col_start + sbw * out_subblock_w + w;
+                        if (row < Mt && col < Nt) {
+                            noc_async_write_tile(out_tile_offset + row * Nt + col, s, l1_read_addr);
+                        }
+                        l1_read_addr += single_tile_size_bytes;
+                    }
+                }
+
+                noc_async_write_barrier();
+                cb_pop_front(cb_id_out0, out_subblock_tile_count);
+            }
+        }
+    }
+}
@@ -0,0 +1,169 @@
+#include <cstdlib>
+#include <tt-metalium/host_api.hpp>
+#include <tt-metalium/constants.hpp>
+#include <tt-metalium/bfloat16.hpp>
+#include <tt-metalium/tilize_utils.hpp>
+#include <tt-metalium/device.hpp>
+#include <tt-metalium/tt_metal.hpp>
+#include <tt-metalium/distributed.hpp>
+#include <bmm_op.hpp>
+#include <bmm_autotune.hpp>
+#include <fmt/core.h>
+
+using namespace tt::constants;
+using namespace std;
+using namespace tt;
+using namespace tt::tt_metal;
+
+void golden_matmul(
+    std::vector<bfloat16>& a, std::vector<bfloat16>& b, std::vector<bfloat16>& output, uint32_t M, uint32_t N, uint32_t K) {
+    for (uint32_t i = 0; i < M; i++) {
+        for (uint32_t j = 0; j < N; j++) {
+            float c_f = 0;
+            for (uint32_t k = 0; k < K; k++) {
+                c_f += static_cast<float>(a[i * K + k]) * static_cast<float>(b[k * N + j]);
+            }
+            output.at(i * N + j) = bfloat16(c_f);
+        }
+    }
+}
+
+// create_random_vector_of_bfloat16_native 의 [offset, offset + rand_max] 균등 분포
+struct InputDistribution {
+    const char* tag;
+    float rand_max;
+    float offset;
+};
+
+/*
+    math fidelity 자동 선택 예제.
+
+    같은 shape를 입력 분포 두 가지로 돌려서 LoFi / HiFi2 / HiFi3 / HiFi4 의 시간과 PCC를 재고,
+    min_pcc (두 번째 인자, 기본값 0.999) 를 넘는 것 중 가장 빠른 fidelity를 고른다.
+    선택 결과는 cache 파일 (첫 번째 인자, 기본값 matmul_fidelity_cache.txt) 에 저장되므로
+    두 번째 실행부터는 benchmark 없이 cache에서 바로 읽는다.
+*/
+int main(int argc, char** argv) {
+    bool pass = true;
+
+    constexpr int device_id = 0;
+    std::shared_ptr<distributed::MeshDevice> mesh_device = distributed::MeshDevice::create_unit_mesh(device_id);
+    distributed::MeshCommandQueue& cq = mesh_device->mesh_command_queue();
+
+    std::string cache_path = argc > 1 ? argv[1] : "matmul_fidelity_cache.txt";
+    float min_pcc = argc > 2 ? std::strtof(argv[2], nullptr) : 0.999f;
+    bmm_op_utils::MatmulFidelityCache cache(cache_path);
+    fmt::print(" -- fidelity cache {}: {} entries, min PCC {} --\n", cache.path(), cache.size(), min_pcc);
+
+    constexpr uint32_t M = 640;  // user-defined
+    constexpr uint32_t N = 640;  // user-defined
+    constexpr uint32_t K = 640;  // user-defined
+
+    uint32_t Mt = M / TILE_HEIGHT;
+    uint32_t Kt = K / TILE_WIDTH;
+    uint32_t Nt = N / TILE_WIDTH;
+
+    tt::DataFormat data_format = tt::DataFormat::Float16_b;
+    uint32_t single_tile_size = tt::tile_size(data_format);
+    auto grid = mesh_device->compute_with_storage_grid_size();
+
+    uint32_t in0_block_w = 2;
+    auto matmul_params = bmm_op_utils::get_large_matmul_params(Mt, Nt, grid.y, grid.x, in0_block_w);
+    bmm_op_utils::MatmulBlockConfig config{
+        std::get<0>(matmul_params),
+        std::get<1>(matmul_params),
+        in0_block_w,
+        std::get<2>(matmul_params),
+        std::get<3>(matmul_params)};
+    TT_FATAL(config.per_core_M != 0, "No valid core sizing for Mt = {}, Nt = {}", Mt, Nt);
+
+    distributed::DeviceLocalBufferConfig dram_config{
+        .page_size = single_tile_size, .buffer_type = tt_metal::BufferType::DRAM};
+    distributed::ReplicatedBufferConfig buffer_config_A{.size = single_tile_size * Mt * Kt};
+    distributed::ReplicatedBufferConfig buffer_config_B{.size = single_tile_size * Nt * Kt};
+    distributed::ReplicatedBufferConfig buffer_config_C{.size = single_tile_size * Mt * Nt};
+
+    auto src0_dram_buffer = distributed::MeshBuffer::create(buffer_config_A, dram_config, mesh_device.get());
+    auto src1_dram_buffer = distributed::MeshBuffer::create(buffer_config_B, dram_config, mesh_device.get());
+    auto dst_dram_buffer = distributed::MeshBuffer::create(buffer_config_C, dram_config, mesh_device.get());
+
+    const std::vector<InputDistribution> distributions = {
+        {"centered", 1.0f, -0.5f},
+        {"positive", 1.0f, 1.0f},
+    };
+
+    for (const auto& [tag, rand_max, offset] : distributions) {
+        std::vector<bfloat16> src0_vec =
+            create_random_vector_of_bfloat16_native(M * K * sizeof(bfloat16), rand_max, 123, offset);
+        std::vector<bfloat16> src1_vec =
+            create_random_vector_of_bfloat16_native(K * N * sizeof(bfloat16), rand_max, 12522, offset);
+
+        std::vector<bfloat16> golden_vec(M * N, 0);
+        golden_matmul(src0_vec, src1_vec, golden_vec, M, N, K);
+
+        distributed::EnqueueWriteMeshBuffer(cq, src0_dram_buffer, tilize_nfaces(src0_vec, M, K), false);
+        distributed::EnqueueWriteMeshBuffer(cq, src1_dram_buffer, tilize_nfaces(src1_vec, K, N), false);
+
+        fmt::print(" -- input distribution: {} --\n", tag);
+        auto selected = bmm_op_utils::select_matmul_fidelity(
+            mesh_device,
+            src0_dram_buffer,
+            src1_dram_buffer,
+            dst_dram_buffer,
+            Mt,
+            Nt,
+            Kt,
+            config,
+            data_format,
+            golden_vec,
+            tag,
+            min_pcc,
+            cache);
+        fmt::print(
+            " -- selected {} ({:.1f} us, PCC = {}) --\n",
+            bmm_op_utils::math_fidelity_name(selected.math_fidelity),
+            selected.time_us,
+            selected.pcc);
+
+        // 고른 fidelity로 한 번 더 돌려서 결과를 확인한다.
+        distributed::MeshWorkload workload;
+        distributed::MeshCoordinateRange device_range = distributed::MeshCoordinateRange(mesh_device->shape());
+        workload.add_program(
+            device_range,
+            bmm_op_utils::create_matmul_multicore_reuse_program(
+                src0_dram_buffer,
+                src1_dram_buffer,
+                dst_dram_buffer,
+                Mt,
+                Nt,
+                Kt,
+                1,
+                false,
+                config,
+                data_format,
+                selected.math_fidelity,
+                grid));
+        distributed::EnqueueMeshWorkload(cq, workload, false);
+
+        std::vector<bfloat16> result_vec(M * N);
+        distributed::EnqueueReadMeshBuffer(cq, result_vec, dst_dram_buffer, true);
+        result_vec = untilize_nfaces(result_vec, M, N);
+
+        float pearson = check_bfloat16_vector_pcc(golden_vec, result_vec);
+        fmt::print("Metalium vs Golden -- PCC = {}\n", pearson);
+        if (selected.math_fidelity != MathFidelity::HiFi4 && pearson < min_pcc) {
+            fmt::print("PCC not high enough for {}. Result PCC: {}, Expected PCC: {}\n", tag, pearson, min_pcc);
+            pass = false;
+        }
+    }
+
+    pass &= mesh_device->close();
+
+    if (pass) {
+        fmt::print("Test Passed!!! - matmul fidelity\n");
+    } else {
+        TT_THROW("Test Failed");
+    }
+
+    return 0;
+}
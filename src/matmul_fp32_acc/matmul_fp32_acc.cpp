@@ -0,0 +1,173 @@
+#include <tt-metalium/host_api.hpp>
+#include <tt-metalium/constants.hpp>
+#include <tt-metalium/bfloat16.hpp>
+#include <tt-metalium/tilize_utils.hpp>
+#include <tt-metalium/device.hpp>
+#include <tt-metalium/tt_metal.hpp>
+#include <tt-metalium/distributed.hpp>
+#include <bmm_op.hpp>
+#include <bmm_reuse_program.hpp>
+#include <fmt/core.h>
+
+using namespace tt::constants;
+using namespace std;
+using namespace tt;
+using namespace tt::tt_metal;
+
+void golden_matmul(
+    std::vector<bfloat16>& a, std::vector<bfloat16>& b, std::vector<bfloat16>& output, uint32_t M, uint32_t N, uint32_t K) {
+    for (uint32_t i = 0; i < M; i++) {
+        for (uint32_t j = 0; j < N; j++) {
+            float c_f = 0;
+            for (uint32_t k = 0; k < K; k++) {
+                c_f += static_cast<float>(a[i * K + k]) * static_cast<float>(b[k * N + j]);
+            }
+            output.at(i * N + j) = bfloat16(c_f);
+        }
+    }
+}
+
+struct AccCase {
+    const char* name;
+    tt::DataFormat interm_data_format;
+    tt::DataFormat out_data_format;
+};
+
+/*
+    K가 긴 matmul에서 partial sum 정밀도 비교 예제.
+
+    bmm_large_block_zm은 K block마다 partial을 c_24에 spill 했다가 다시 읽어서 누적한다. (K = 8192, in0_block_w = 2
+    이면 tile 하나당 128번) c_24가 bf16이면 spill 할 때마다 mantissa를 잘라서 오차가 쌓인다.
+    interm을 Float32로 두면 fp32_dest_acc_en 으로 dst와 c_24가 모두 fp32가 되고 (dst에는 tile 4개만 들어간다),
+    output은 Float16_b 또는 Float32로 고를 수 있다.
+*/
+int main() {
+    bool pass = true;
+
+    constexpr int device_id = 0;
+    std::shared_ptr<distributed::MeshDevice> mesh_device = distributed::MeshDevice::create_unit_mesh(device_id);
+    distributed::MeshCommandQueue& cq = mesh_device->mesh_command_queue();
+
+    constexpr uint32_t M = 256;   // user-defined
+    constexpr uint32_t N = 256;   // user-defined
+    constexpr uint32_t K = 8192;  // user-defined
+
+    uint32_t Mt = M / TILE_HEIGHT;
+    uint32_t Kt = K / TILE_WIDTH;
+    uint32_t Nt = N / TILE_WIDTH;
+
+    constexpr tt::DataFormat in_data_format = tt::DataFormat::Float16_b;
+    uint32_t in_single_tile_size = tt::tile_size(in_data_format);
+    auto grid = mesh_device->compute_with_storage_grid_size();
+
+    distributed::DeviceLocalBufferConfig in_dram_config{
+        .page_size = in_single_tile_size, .buffer_type = tt_metal::BufferType::DRAM};
+    distributed::ReplicatedBufferConfig buffer_config_A{.size = in_single_tile_size * Mt * Kt};
+    distributed::ReplicatedBufferConfig buffer_config_B{.size = in_single_tile_size * Nt * Kt};
+    auto src0_dram_buffer = distributed::MeshBuffer::create(buffer_config_A, in_dram_config, mesh_device.get());
+    auto src1_dram_buffer = distributed::MeshBuffer::create(buffer_config_B, in_dram_config, mesh_device.get());
+
+    std::vector<bfloat16> src0_vec = create_random_vector_of_bfloat16_native(M * K * sizeof(bfloat16), 1, 123, -0.5);
+    std::vector<bfloat16> src1_vec = create_random_vector_of_bfloat16_native(K * N * sizeof(bfloat16), 1, 12522, -0.5);
+
+    std::vector<bfloat16> golden_vec(M * N, 0);
+    golden_matmul(src0_vec, src1_vec, golden_vec, M, N, K);
+
+    distributed::EnqueueWriteMeshBuffer(cq, src0_dram_buffer, tilize_nfaces(src0_vec, M, K), false);
+    distributed::EnqueueWriteMeshBuffer(cq, src1_dram_buffer, tilize_nfaces(src1_vec, K, N), false);
+
+    const std::vector<AccCase> cases = {
+        {"bf16 interm / bf16 out", tt::DataFormat::Float16_b, tt::DataFormat::Float16_b},
+        {"fp32 interm / bf16 out", tt::DataFormat::Float32, tt::DataFormat::Float16_b},
+        {"fp32 interm / fp32 out", tt::DataFormat::Float32, tt::DataFormat::Float32},
+    };
+
+    float bf16_acc_pcc = 0.0f;
+    for (const auto& [name, interm_data_format, out_data_format] : cases) {
+        bmm_op_utils::MatmulDataFormats data_formats(
+            in_data_format, in_data_format, out_data_format, interm_data_format);
+
+        // fp32 dst는 tile을 절반만 담으므로 sub-block을 4 tile 이하로 고르고, c_24 크기도 fp32 tile로 계산한다.
+        auto l1_budget = get_matmul_l1_budget(
+            mesh_device.get(),
+            in_data_format,
+            in_data_format,
+            out_data_format,
+            interm_data_format,
+            interm_data_format == out_data_format);
+        uint32_t in0_block_w = 2;
+        auto matmul_params = bmm_op_utils::get_large_matmul_params(
+            Mt, Nt, grid.y, grid.x, in0_block_w, data_formats.max_subblock_num_tiles(), l1_budget);
+        bmm_op_utils::MatmulBlockConfig config{
+            std::get<0>(matmul_params),
+            std::get<1>(matmul_params),
+            in0_block_w,
+            std::get<2>(matmul_params),
+            std::get<3>(matmul_params)};
+        TT_FATAL(config.per_core_M != 0, "No valid core sizing for Mt = {}, Nt = {}", Mt, Nt);
+
+        uint32_t out_single_tile_size = tt::tile_size(out_data_format);
+        distributed::DeviceLocalBufferConfig out_dram_config{
+            .page_size = out_single_tile_size, .buffer_type = tt_metal::BufferType::DRAM};
+        distributed::ReplicatedBufferConfig buffer_config_C{.size = out_single_tile_size * Mt * Nt};
+        auto dst_dram_buffer = distributed::MeshBuffer::create(buffer_config_C, out_dram_config, mesh_device.get());
+
+        distributed::MeshWorkload workload;
+        distributed::MeshCoordinateRange device_range = distributed::MeshCoordinateRange(mesh_device->shape());
+        workload.add_program(
+            device_range,
+            bmm_op_utils::create_matmul_multicore_reuse_program(
+                src0_dram_buffer,
+                src1_dram_buffer,
+                dst_dram_buffer,
+                Mt,
+                Nt,
+                Kt,
+                1,
+                false,
+                config,
+                data_formats,
+                MathFidelity::HiFi4,
+                grid));
+        distributed::EnqueueMeshWorkload(cq, workload, false);
+
+        std::vector<bfloat16> result_vec;
+        if (out_data_format == tt::DataFormat::Float32) {
+            std::vector<float> result_fp32(M * N);
+            distributed::EnqueueReadMeshBuffer(cq, result_fp32, dst_dram_buffer, true);
+            result_fp32 = untilize_nfaces(result_fp32, M, N);
+            result_vec.assign(result_fp32.begin(), result_fp32.end());
+        } else {
+            result_vec.resize(M * N);
+            distributed::EnqueueReadMeshBuffer(cq, result_vec, dst_dram_buffer, true);
+            result_vec = untilize_nfaces(result_vec, M, N);
+        }
+
+        float pearson = check_bfloat16_vector_pcc(golden_vec, result_vec);
+        fmt::print(
+            "{}: block = {}x{}, sub-block = {}x{} -- PCC = {}\n",
+            name,
+            config.per_core_M,
+            config.per_core_N,
+            config.out_subblock_h,
+            config.out_subblock_w,
+            pearson);
+
+        if (!data_formats.fp32_dest_acc_en()) {
+            bf16_acc_pcc = pearson;
+        } else if (pearson < 0.999f || pearson < bf16_acc_pcc) {
+            fmt::print("PCC not high enough for {}. Result PCC: {}, Expected PCC: 0.999\n", name, pearson);
+            pass = false;
+        }
+    }
+
+    pass &= mesh_device->close();
+
+    if (pass) {
+        fmt::print("Test Passed!!! - matmul fp32 acc\n");
+    } else {
+        TT_THROW("Test Failed");
+    }
+
+    return 0;
+}
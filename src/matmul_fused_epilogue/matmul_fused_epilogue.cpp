@@ -0,0 +1,140 @@
+#include <cmath>
+#include <tt-metalium/host_api.hpp>
+#include <tt-metalium/constants.hpp>
+#include <tt-metalium/bfloat16.hpp>
+#include <tt-metalium/tilize_utils.hpp>
+#include <tt-metalium/device.hpp>
+#include <tt-metalium/tt_metal.hpp>
+#include <tt-metalium/distributed.hpp>
+#include <bmm_op.hpp>
+#include <bmm_reuse_program.hpp>
+#include <fmt/core.h>
+
+using namespace tt::constants;
+using namespace std;
+using namespace tt;
+using namespace tt::tt_metal;
+
+// out = gelu(scale * (A * B) + bias)
+void golden_matmul_bias_gelu(
+    std::vector<bfloat16>& a,
+    std::vector<bfloat16>& b,
+    std::vector<bfloat16>& bias,
+    std::vector<bfloat16>& output,
+    uint32_t M,
+    uint32_t N,
+    uint32_t K,
+    float scale) {
+    for (uint32_t i = 0; i < M; i++) {
+        for (uint32_t j = 0; j < N; j++) {
+            float c_f = 0;
+            for (uint32_t k = 0; k < K; k++) {
+                c_f += static_cast<float>(a[i * K + k]) * static_cast<float>(b[k * N + j]);
+            }
+            float x = scale * c_f + static_cast<float>(bias[j]);
+            output.at(i * N + j) = bfloat16(0.5f * x * (1.0f + std::erf(x / std::sqrt(2.0f))));
+        }
+    }
+}
+
+/*
+    matmul_multicore_reuse + fused epilogue 예제. (transformer MLP의 첫 번째 linear)
+
+    bias 더하기, scale, GELU를 bmm_large_block_zm의 마지막 K block에서 sub-block이 dst에 있는 동안 처리한다.
+    따로 elementwise program을 돌리면 output (M x N) 을 DRAM에서 한 번 더 읽고 쓰게 되는데, 그 왕복이 없어진다.
+*/
+int main() {
+    bool pass = true;
+
+    constexpr int device_id = 0;
+    std::shared_ptr<distributed::MeshDevice> mesh_device = distributed::MeshDevice::create_unit_mesh(device_id);
+    distributed::MeshCommandQueue& cq = mesh_device->mesh_command_queue();
+
+    constexpr uint32_t M = 640;  // user-defined
+    constexpr uint32_t N = 640;  // user-defined
+    constexpr uint32_t K = 640;  // user-defined
+    constexpr float scale = 0.5f;
+
+    uint32_t Mt = M / TILE_HEIGHT;
+    uint32_t Kt = K / TILE_WIDTH;
+    uint32_t Nt = N / TILE_WIDTH;
+
+    tt::DataFormat cb_data_format = tt::DataFormat::Float16_b;
+    uint32_t single_tile_size = tt::tile_size(cb_data_format);
+    auto grid = mesh_device->compute_with_storage_grid_size();
+
+    uint32_t in0_block_w = 2;
+    auto matmul_params = bmm_op_utils::get_large_matmul_params(Mt, Nt, grid.y, grid.x, in0_block_w);
+    bmm_op_utils::MatmulBlockConfig config{
+        std::get<0>(matmul_params),
+        std::get<1>(matmul_params),
+        in0_block_w,
+        std::get<2>(matmul_params),
+        std::get<3>(matmul_params)};
+    TT_FATAL(config.per_core_M != 0, "No valid core sizing for Mt = {}, Nt = {}", Mt, Nt);
+
+    distributed::DeviceLocalBufferConfig dram_config{
+        .page_size = single_tile_size, .buffer_type = tt_metal::BufferType::DRAM};
+    distributed::ReplicatedBufferConfig buffer_config_A{.size = single_tile_size * Mt * Kt};
+    distributed::ReplicatedBufferConfig buffer_config_B{.size = single_tile_size * Nt * Kt};
+    distributed::ReplicatedBufferConfig buffer_config_C{.size = single_tile_size * Mt * Nt};
+    distributed::ReplicatedBufferConfig buffer_config_bias{.size = single_tile_size * Nt};
+
+    auto src0_dram_buffer = distributed::MeshBuffer::create(buffer_config_A, dram_config, mesh_device.get());
+    auto src1_dram_buffer = distributed::MeshBuffer::create(buffer_config_B, dram_config, mesh_device.get());
+    auto dst_dram_buffer = distributed::MeshBuffer::create(buffer_config_C, dram_config, mesh_device.get());
+    auto bias_dram_buffer = distributed::MeshBuffer::create(buffer_config_bias, dram_config, mesh_device.get());
+
+    std::vector<bfloat16> src0_vec = create_random_vector_of_bfloat16_native(M * K * sizeof(bfloat16), 1, 123, -0.4);
+    std::vector<bfloat16> src1_vec = create_random_vector_of_bfloat16_native(K * N * sizeof(bfloat16), 1, 12522, -0.3);
+    std::vector<bfloat16> bias_vec = create_random_vector_of_bfloat16_native(N * sizeof(bfloat16), 2, 777, -1.0);
+
+    std::vector<bfloat16> golden_vec(M * N, 0);
+    golden_matmul_bias_gelu(src0_vec, src1_vec, bias_vec, golden_vec, M, N, K, scale);
+
+    distributed::EnqueueWriteMeshBuffer(cq, src0_dram_buffer, tilize_nfaces(src0_vec, M, K), false);
+    distributed::EnqueueWriteMeshBuffer(cq, src1_dram_buffer, tilize_nfaces(src1_vec, K, N), false);
+    distributed::EnqueueWriteMeshBuffer(
+        cq, bias_dram_buffer, bmm_op_utils::make_matmul_bias_tiles(bias_vec, N), false);
+
+    bmm_op_utils::MatmulEpilogue epilogue{
+        .fuse_bias = true, .activation = bmm_op_utils::MatmulActivation::GELU, .scale = scale};
+
+    distributed::MeshWorkload workload;
+    distributed::MeshCoordinateRange device_range = distributed::MeshCoordinateRange(mesh_device->shape());
+    workload.add_program(
+        device_range,
+        bmm_op_utils::create_matmul_multicore_reuse_program(
+            src0_dram_buffer,
+            src1_dram_buffer,
+            dst_dram_buffer,
+            Mt,
+            Nt,
+            Kt,
+            1,
+            false,
+            config,
+            cb_data_format,
+            MathFidelity::HiFi4,
+            grid,
+            {.epilogue = epilogue, .bias_buffer = bias_dram_buffer}));
+    distributed::EnqueueMeshWorkload(cq, workload, false);
+
+    std::vector<bfloat16> result_vec(M * N);
+    distributed::EnqueueReadMeshBuffer(cq, result_vec, dst_dram_buffer, true);
+    result_vec = untilize_nfaces(result_vec, M, N);
+
+    float pearson = check_bfloat16_vector_pcc(golden_vec, result_vec);
+    fmt::print("Metalium vs Golden -- PCC = {}\n", pearson);
+    TT_FATAL(pearson > 0.99, "PCC not high enough. Result PCC: {}, Expected PCC: 0.99", pearson);
+
+    pass &= mesh_device->close();
+
+    if (pass) {
+        fmt::print("Test Passed!!! - matmul fused epilogue\n");
+    } else {
+        TT_THROW("Test Failed");
+    }
+
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include <cstdint>
+#include <algorithm>
+#include "compute_kernel_api/tile_move_copy.h"
+#include "compute_kernel_api/matmul.h"
+
+using std::uint32_t;
+
+namespace NAMESPACE {
+/*
+    GEMV compute. output은 tile row 하나이고 이 core는 그 중 n_tiles column을 맡는다.
+
+    column을 group_w 개씩 묶어서 dst에 올려 두고 K 전체를 누적한 뒤 pack 한다. (partial spill 없음)
+    c_0에는 A row 전체 (Kt tiles) 가 쌓이며, 첫 group은 A chunk가 도착하는 대로 (cb_wait_front의 누적 개수) 계산하고
+    나머지 group은 이미 있는 A를 다시 쓴다. 마지막에 A row를 pop 한다.
+    c_1에는 B chunk (k_block x group 크기, row-major) 가 들어온다.
+*/
+void MAIN {
+    uint32_t n_tiles = get_arg_val<uint32_t>(0);
+    uint32_t Kt = get_arg_val<uint32_t>(1);
+    uint32_t k_block = get_arg_val<uint32_t>(2);
+    uint32_t group_w = get_arg_val<uint32_t>(3);
+
+    constexpr auto cb_in0 = tt::CBIndex::c_0;
+    constexpr auto cb_in1 = tt::CBIndex::c_1;
+    constexpr auto cb_out = tt::CBIndex::c_16;
+
+    const uint32_t num_k_blocks = Kt / k_block;
+
+    mm_init(cb_in0, cb_in1, cb_out);
+    for (uint32_t group_start = 0; group_start < n_tiles; group_start += group_w) {
+        uint32_t group_tiles = std::min(group_w, n_tiles - group_start);
+
+        tile_regs_acquire();
+        for (uint32_t kb = 0; kb < num_k_blocks; kb++) {
+            if (group_start == 0) {
+                cb_wait_front(cb_in0, (kb + 1) * k_block);
+            }
+            cb_wait_front(cb_in1, k_block * group_tiles);
+            for (uint32_t k = 0; k < k_block; k++) {
+                for (uint32_t w = 0; w < group_tiles; w++) {
+                    matmul_tiles(cb_in0, cb_in1, kb * k_block + k, k * group_tiles + w, w, false);
+                }
+            }
+            cb_pop_front(cb_in1, k_block * group_tiles);
+        }
+        tile_regs_commit();
+        tile_regs_wait();
+
+        cb_reserve_back(cb_out, group_tiles);
+        for (uint32_t w = 0; w < group_tiles; w++) {
+            pack_tile(w, cb_out);
+        }
+        cb_push_back(cb_out, group_tiles);
+        tile_regs_release();
+    }
+
+    if (n_tiles > 0) {
+        cb_pop_front(cb_in0, Kt);
+    }
+}
+}  // namespace NAMESPACE
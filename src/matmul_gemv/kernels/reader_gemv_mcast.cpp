@@ -0,0 +1,161 @@
+#include <stdint.h>
+#include <algorithm>
+#include "dataflow_api.h"
+
+/*
+    GEMV (M <= 32) reader.
+
+    A는 tile row 하나 (Kt tiles) 뿐이라 모든 core가 같은 A를 쓴다. sender core (logical (0, 0)) 만 A를 DRAM에서
+    k_block tile씩 읽어서 core 사각형 전체에 multicast 한다. sender도 사각형 안에 있으므로 loopback multicast를 쓴다.
+    (handshake는 reader_bmm_tile_layout_mcast.cpp 와 같다.)
+    c_0는 A row 전체 (Kt tiles) 크기라서 한 번 받은 A는 이 core의 모든 column group이 같이 쓴다.
+
+    B는 core가 맡은 column 구간 [n_start, n_start + n_tiles) 를 group_w column씩 나눠서, K 방향으로 k_block row씩
+    읽는다. row 하나 안의 group_w tile은 DRAM에서 연속이고, k_block * group_w 개의 read를 한 번에 날린 뒤
+    barrier를 한 번만 기다린다.
+    column이 없는 core (n_tiles == 0) 도 A multicast handshake에는 참여해야 한다.
+*/
+
+constexpr uint32_t INVALID = 0;
+constexpr uint32_t VALID = 1;
+
+inline void send_block_loopback(
+    uint32_t l1_addr,
+    uint32_t block_size_bytes,
+    uint32_t num_cores,
+    uint32_t dest_start_x,
+    uint32_t dest_start_y,
+    uint32_t dest_end_x,
+    uint32_t dest_end_y,
+    uint32_t sender_sem_addr,
+    uint32_t receiver_sem_addr) {
+    if (num_cores == 1) {
+        return;
+    }
+
+    volatile tt_l1_ptr uint32_t* sender_sem_ptr = reinterpret_cast<volatile tt_l1_ptr uint32_t*>(sender_sem_addr);
+
+    // sender를 뺀 모든 receiver가 준비될 때까지 기다린다.
+    noc_semaphore_wait(sender_sem_ptr, num_cores - 1);
+    noc_semaphore_set(sender_sem_ptr, 0);
+
+    // NOC_1은 반대 방향으로 routing 되므로 multicast 사각형의 start / end 가 뒤바뀐다.
+    uint64_t mcast_data_addr;
+    uint64_t mcast_sem_addr;
+    if (noc_index == 0) {
+        mcast_data_addr = get_noc_multicast_addr(dest_start_x, dest_start_y, dest_end_x, dest_end_y, l1_addr);
+        mcast_sem_addr = get_noc_multicast_addr(dest_start_x, dest_start_y, dest_end_x, dest_end_y, receiver_sem_addr);
+    } else {
+        mcast_data_addr = get_noc_multicast_addr(dest_end_x, dest_end_y, dest_start_x, dest_start_y, l1_addr);
+        mcast_sem_addr = get_noc_multicast_addr(dest_end_x, dest_end_y, dest_start_x, dest_start_y, receiver_sem_addr);
+    }
+
+    // 사각형에 sender 자신도 들어 있으므로 loopback 버전을 쓰고 num_dests 에 sender도 센다.
+    noc_async_write_multicast_loopback_src(l1_addr, mcast_data_addr, block_size_bytes, num_cores);
+    noc_semaphore_set_multicast_loopback_src(receiver_sem_addr, mcast_sem_addr, num_cores);
+    noc_async_write_barrier();
+}
+
+inline void receive_block(
+    uint32_t sender_noc_x, uint32_t sender_noc_y, uint32_t sender_sem_addr, uint32_t receiver_sem_addr) {
+    volatile tt_l1_ptr uint32_t* receiver_sem_ptr =
+        reinterpret_cast<volatile tt_l1_ptr uint32_t*>(receiver_sem_addr);
+
+    noc_semaphore_set(receiver_sem_ptr, INVALID);
+
+    uint64_t remote_sender_sem_addr = get_noc_addr(sender_noc_x, sender_noc_y, sender_sem_addr);
+    noc_semaphore_inc(remote_sender_sem_addr, 1);
+
+    noc_semaphore_wait(receiver_sem_ptr, VALID);
+}
+
+void kernel_main() {
+    uint32_t in0_tensor_addr = get_arg_val<uint32_t>(0);
+    uint32_t in1_tensor_addr = get_arg_val<uint32_t>(1);
+    uint32_t Kt = get_arg_val<uint32_t>(2);
+    uint32_t Nt = get_arg_val<uint32_t>(3);
+    uint32_t n_start = get_arg_val<uint32_t>(4);  // 이 core가 맡은 첫 output column (tile)
+    uint32_t n_tiles = get_arg_val<uint32_t>(5);  // 이 core가 맡은 output column 수
+    uint32_t k_block = get_arg_val<uint32_t>(6);  // Kt % k_block == 0
+    uint32_t group_w = get_arg_val<uint32_t>(7);  // dst에 한 번에 올리는 output tile 수
+
+    // A multicast args
+    uint32_t is_sender = get_arg_val<uint32_t>(8);
+    uint32_t sender_noc_x = get_arg_val<uint32_t>(9);
+    uint32_t sender_noc_y = get_arg_val<uint32_t>(10);
+    uint32_t mcast_dest_noc_start_x = get_arg_val<uint32_t>(11);
+    uint32_t mcast_dest_noc_start_y = get_arg_val<uint32_t>(12);
+    uint32_t mcast_dest_noc_end_x = get_arg_val<uint32_t>(13);
+    uint32_t mcast_dest_noc_end_y = get_arg_val<uint32_t>(14);
+    uint32_t mcast_num_cores = get_arg_val<uint32_t>(15);  // sender 포함
+    uint32_t mcast_sender_sem_addr = get_semaphore(get_arg_val<uint32_t>(16));
+    uint32_t mcast_receiver_sem_addr = get_semaphore(get_arg_val<uint32_t>(17));
+
+    constexpr uint32_t cb_id_in0 = 0;
+    constexpr uint32_t cb_id_in1 = 1;
+
+    const uint32_t in0_single_tile_size_bytes = get_tile_size(cb_id_in0);
+    const uint32_t in1_single_tile_size_bytes = get_tile_size(cb_id_in1);
+
+    constexpr auto s0_args = TensorAccessorArgs<0>();
+    const auto s0 = TensorAccessor(s0_args, in0_tensor_addr, in0_single_tile_size_bytes);
+    constexpr auto s1_args = TensorAccessorArgs<s0_args.next_compile_time_args_offset()>();
+    const auto s1 = TensorAccessor(s1_args, in1_tensor_addr, in1_single_tile_size_bytes);
+
+    // sender는 자기 receiver semaphore의 VALID 값을 receiver들에게 multicast 하는 source로 쓴다.
+    if (is_sender) {
+        *reinterpret_cast<volatile tt_l1_ptr uint32_t*>(mcast_receiver_sem_addr) = VALID;
+    }
+
+    const uint32_t num_k_blocks = Kt / k_block;
+    const uint32_t num_groups = n_tiles == 0 ? 1 : (n_tiles + group_w - 1) / group_w;
+
+    for (uint32_t g = 0; g < num_groups; g++) {
+        uint32_t group_start = n_start + g * group_w;
+        uint32_t group_tiles = n_tiles == 0 ? 0 : std::min(group_w, n_tiles - g * group_w);
+
+        for (uint32_t kb = 0; kb < num_k_blocks; kb++) {
+            // A는 첫 column group을 도는 동안 K 순서대로 받아서 B와 같이 흘려 보낸다.
+            if (g == 0) {
+                cb_reserve_back(cb_id_in0, k_block);
+                uint32_t l1_write_addr_in0 = get_write_ptr(cb_id_in0);
+                if (is_sender) {
+                    uint32_t l1_addr = l1_write_addr_in0;
+                    for (uint32_t k = kb * k_block; k < (kb + 1) * k_block; k++) {
+                        noc_async_read_tile(k, s0, l1_addr);
+                        l1_addr += in0_single_tile_size_bytes;
+                    }
+                    noc_async_read_barrier();
+                    send_block_loopback(
+                        l1_write_addr_in0,
+                        k_block * in0_single_tile_size_bytes,
+                        mcast_num_cores,
+                        mcast_dest_noc_start_x,
+                        mcast_dest_noc_start_y,
+                        mcast_dest_noc_end_x,
+                        mcast_dest_noc_end_y,
+                        mcast_sender_sem_addr,
+                        mcast_receiver_sem_addr);
+                } else {
+                    receive_block(sender_noc_x, sender_noc_y, mcast_sender_sem_addr, mcast_receiver_sem_addr);
+                }
+                cb_push_back(cb_id_in0, k_block);
+            }
+
+            if (group_tiles == 0) {
+                continue;
+            }
+            cb_reserve_back(cb_id_in1, k_block * group_tiles);
+            uint32_t l1_write_addr_in1 = get_write_ptr(cb_id_in1);
+            for (uint32_t k = kb * k_block; k < (kb + 1) * k_block; k++) {
+                uint32_t tile_id = k * Nt + group_start;
+                for (uint32_t w = 0; w < group_tiles; w++) {
+                    noc_async_read_tile(tile_id + w, s1, l1_write_addr_in1);
+                    l1_write_addr_in1 += in1_single_tile_size_bytes;
+                }
+            }
+            noc_async_read_barrier();
+            cb_push_back(cb_id_in1, k_block * group_tiles);
+        }
+    }
+}
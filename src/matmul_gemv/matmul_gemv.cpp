@@ -0,0 +1,258 @@
+#include <chrono>
+#include <tt-metalium/host_api.hpp>
+#include <tt-metalium/constants.hpp>
+#include <tt-metalium/bfloat16.hpp>
+#include <tt-metalium/tilize_utils.hpp>
+#include <tt-metalium/device.hpp>
+#include <tt-metalium/tt_metal.hpp>
+#include <tt-metalium/distributed.hpp>
+#include <tt-metalium/tensor_accessor_args.hpp>
+#include <bmm_op.hpp>
+#include <fmt/core.h>
+
+using namespace tt::constants;
+using namespace std;
+using namespace tt;
+using namespace tt::tt_metal;
+
+#ifndef OVERRIDE_KERNEL_PREFIX
+#define OVERRIDE_KERNEL_PREFIX ""
+#endif
+
+void golden_matmul(
+    std::vector<bfloat16>& a, std::vector<bfloat16>& b, std::vector<bfloat16>& output, uint32_t M, uint32_t N, uint32_t K) {
+    for (uint32_t i = 0; i < M; i++) {
+        for (uint32_t j = 0; j < N; j++) {
+            float c_f = 0;
+            for (uint32_t k = 0; k < K; k++) {
+                c_f += static_cast<float>(a[i * K + k]) * static_cast<float>(b[k * N + j]);
+            }
+            output.at(i * N + j) = bfloat16(c_f);
+        }
+    }
+}
+
+/*
+    GEMV (M <= 32) matmul.
+
+    M이 tile row 하나 이하이면 get_large_matmul_params 의 분할은 core 몇 개만 쓰거나 실패하고,
+    output tile 하나당 A row를 다시 읽는 matmul_multi_core 방식은 A를 core 수만큼 DRAM에서 읽는다.
+    여기서는 N (output column) 을 core 사각형 전체에 고르게 나누고 K는 k_block 단위로 흘려 보낸다.
+    - A (tile row 하나) 는 sender core 하나만 DRAM에서 읽어 사각형 전체에 multicast 한다.
+    - B는 core마다 자기 column 구간을 row 단위 연속 chunk (k_block x group_w tiles) 로 읽는다.
+    - group_w (dst 크기, 8) column을 dst에 올려 두고 K 전체를 누적하므로 partial을 L1에 spill 하지 않는다.
+    M < 32 이면 host에서 A를 32 row로 0 padding 하고 결과의 앞 M row만 쓴다.
+*/
+void matmul_gemv(
+    const std::vector<bfloat16>& a,
+    const std::vector<bfloat16>& b,
+    std::vector<bfloat16>& output,
+    uint32_t N,
+    uint32_t K,
+    const std::shared_ptr<distributed::MeshDevice>& mesh_device) {
+    distributed::MeshCommandQueue& cq = mesh_device->mesh_command_queue();
+    distributed::MeshWorkload workload;
+    distributed::MeshCoordinateRange device_range = distributed::MeshCoordinateRange(mesh_device->shape());
+    Program program{};
+
+    uint32_t Kt = K / TILE_WIDTH;
+    uint32_t Nt = N / TILE_WIDTH;
+
+    tt::DataFormat cb_data_format = tt::DataFormat::Float16_b;
+    uint32_t single_tile_size = tt::tile_size(cb_data_format);
+
+    /*
+        core 사각형: multicast는 사각형으로만 보낼 수 있으므로 grid.x 폭으로 Nt column을 덮는 row 수만큼 쓴다.
+        column은 core 순서대로 고르게 나누며 (앞쪽 core가 1개 더), 마지막 row의 core 몇 개는 column이 없을 수 있다.
+    */
+    auto grid = mesh_device->compute_with_storage_grid_size();
+    uint32_t num_cores_wanted = std::min<uint32_t>(grid.x * grid.y, Nt);
+    uint32_t rect_w = std::min<uint32_t>(grid.x, num_cores_wanted);
+    uint32_t rect_h = (num_cores_wanted + rect_w - 1) / rect_w;
+    uint32_t num_cores = rect_w * rect_h;
+    CoreRange rect({0, 0}, {rect_w - 1, rect_h - 1});
+    CoreRangeSet all_cores(rect);
+
+    constexpr uint32_t group_w = 8;  // bf16 dst
+    constexpr uint32_t max_k_block = 8;
+    uint32_t k_block = 1;
+    for (uint32_t kb = std::min(max_k_block, Kt); kb > 0; kb--) {
+        if (Kt % kb == 0) {
+            k_block = kb;
+            break;
+        }
+    }
+
+    uint32_t in0_CB_tiles = Kt;                       // A row 전체
+    uint32_t in1_CB_tiles = 2 * k_block * group_w;    // double buffer
+    uint32_t out_CB_tiles = 2 * group_w;
+    auto l1_budget =
+        get_matmul_l1_budget(mesh_device.get(), cb_data_format, cb_data_format, cb_data_format, cb_data_format);
+    TT_FATAL(
+        (uint64_t)(in0_CB_tiles + in1_CB_tiles + out_CB_tiles) * single_tile_size <= l1_budget.l1_size_bytes,
+        "A row of {} tiles does not fit in L1",
+        Kt);
+
+    distributed::DeviceLocalBufferConfig dram_config{
+        .page_size = single_tile_size, .buffer_type = tt_metal::BufferType::DRAM};
+    distributed::ReplicatedBufferConfig buffer_config_A{.size = single_tile_size * Kt};
+    distributed::ReplicatedBufferConfig buffer_config_B{.size = single_tile_size * Kt * Nt};
+    distributed::ReplicatedBufferConfig buffer_config_C{.size = single_tile_size * Nt};
+
+    auto src0_dram_buffer = distributed::MeshBuffer::create(buffer_config_A, dram_config, mesh_device.get());
+    auto src1_dram_buffer = distributed::MeshBuffer::create(buffer_config_B, dram_config, mesh_device.get());
+    auto dst_dram_buffer = distributed::MeshBuffer::create(buffer_config_C, dram_config, mesh_device.get());
+
+    tt_metal::CreateCircularBuffer(
+        program,
+        all_cores,
+        CircularBufferConfig(in0_CB_tiles * single_tile_size, {{CBIndex::c_0, cb_data_format}})
+            .set_page_size(CBIndex::c_0, single_tile_size));
+    tt_metal::CreateCircularBuffer(
+        program,
+        all_cores,
+        CircularBufferConfig(in1_CB_tiles * single_tile_size, {{CBIndex::c_1, cb_data_format}})
+            .set_page_size(CBIndex::c_1, single_tile_size));
+    tt_metal::CreateCircularBuffer(
+        program,
+        all_cores,
+        CircularBufferConfig(out_CB_tiles * single_tile_size, {{CBIndex::c_16, cb_data_format}})
+            .set_page_size(CBIndex::c_16, single_tile_size));
+
+    // Multicast semaphores (sender: 준비된 receiver 수, receiver: VALID / INVALID)
+    uint32_t mcast_sender_sem_id = tt_metal::CreateSemaphore(program, all_cores, 0);
+    uint32_t mcast_receiver_sem_id = tt_metal::CreateSemaphore(program, all_cores, 0);
+
+    std::vector<uint32_t> reader_compile_time_args;
+    TensorAccessorArgs(*src0_dram_buffer).append_to(reader_compile_time_args);
+    TensorAccessorArgs(*src1_dram_buffer).append_to(reader_compile_time_args);
+    auto reader_id = tt_metal::CreateKernel(
+        program,
+        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/matmul_gemv/kernels/reader_gemv_mcast.cpp",
+        all_cores,
+        tt_metal::DataMovementConfig{
+            .processor = DataMovementProcessor::RISCV_1,
+            .noc = NOC::RISCV_1_default,
+            .compile_args = reader_compile_time_args});
+
+    // output은 연속된 tile 구간이므로 matmul_multi_core 의 writer를 그대로 쓴다.
+    std::vector<uint32_t> writer_compile_time_args;
+    TensorAccessorArgs(*dst_dram_buffer).append_to(writer_compile_time_args);
+    auto writer_id = tt_metal::CreateKernel(
+        program,
+        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/matmul_multi_core/kernels/writer_unary_interleaved_start_id.cpp",
+        all_cores,
+        tt_metal::DataMovementConfig{
+            .processor = DataMovementProcessor::RISCV_0,
+            .noc = NOC::RISCV_0_default,
+            .compile_args = writer_compile_time_args});
+
+    auto compute_kernel_id = tt_metal::CreateKernel(
+        program,
+        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/matmul_gemv/kernels/gemv.cpp",
+        all_cores,
+        tt_metal::ComputeConfig{.math_fidelity = MathFidelity::HiFi4});
+
+    // kernel 안의 NoC 주소는 physical 좌표를 써야 한다.
+    CoreCoord sender = mesh_device->worker_core_from_logical_core({0, 0});
+    CoreCoord dest_start = mesh_device->worker_core_from_logical_core({0, 0});
+    CoreCoord dest_end = mesh_device->worker_core_from_logical_core({rect_w - 1, rect_h - 1});
+
+    uint32_t n_start = 0;
+    for (uint32_t i = 0; i < num_cores; i++) {
+        CoreCoord core = {i % rect_w, i / rect_w};
+        uint32_t n_tiles = Nt / num_cores + (i < Nt % num_cores ? 1 : 0);
+
+        tt_metal::SetRuntimeArgs(
+            program,
+            reader_id,
+            core,
+            {(std::uint32_t)src0_dram_buffer->address(),  // in0_tensor_addr
+             (std::uint32_t)src1_dram_buffer->address(),  // in1_tensor_addr
+             Kt,
+             Nt,
+             n_start,
+             n_tiles,
+             k_block,
+             group_w,
+             (std::uint32_t)(i == 0),  // is_sender
+             (std::uint32_t)sender.x,
+             (std::uint32_t)sender.y,
+             (std::uint32_t)dest_start.x,
+             (std::uint32_t)dest_start.y,
+             (std::uint32_t)dest_end.x,
+             (std::uint32_t)dest_end.y,
+             num_cores,
+             mcast_sender_sem_id,
+             mcast_receiver_sem_id});
+        tt_metal::SetRuntimeArgs(program, writer_id, core, {dst_dram_buffer->address(), n_tiles, n_start});
+        tt_metal::SetRuntimeArgs(program, compute_kernel_id, core, {n_tiles, Kt, k_block, group_w});
+
+        n_start += n_tiles;
+    }
+
+    distributed::EnqueueWriteMeshBuffer(cq, src0_dram_buffer, a, false);
+    distributed::EnqueueWriteMeshBuffer(cq, src1_dram_buffer, b, false);
+    workload.add_program(device_range, std::move(program));
+
+    // 첫 launch는 kernel compile 시간이 들어가므로 한 번 돌린 뒤에 잰다.
+    distributed::EnqueueMeshWorkload(cq, workload, false);
+    distributed::Finish(cq);
+    constexpr uint32_t num_iterations = 10;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        distributed::EnqueueMeshWorkload(cq, workload, false);
+    }
+    distributed::Finish(cq);
+    auto end = std::chrono::high_resolution_clock::now();
+    fmt::print(
+        " -- {} cores ({}x{}), k_block = {}: {:.1f} us per launch --\n",
+        num_cores,
+        rect_w,
+        rect_h,
+        k_block,
+        std::chrono::duration<double, std::micro>(end - start).count() / num_iterations);
+
+    distributed::EnqueueReadMeshBuffer(cq, output, dst_dram_buffer, true);
+}
+
+int main() {
+    bool pass = true;
+
+    constexpr int device_id = 0;
+    std::shared_ptr<distributed::MeshDevice> mesh_device = distributed::MeshDevice::create_unit_mesh(device_id);
+
+    constexpr uint32_t M = 1;     // user-defined (M <= 32)
+    constexpr uint32_t N = 4096;  // user-defined
+    constexpr uint32_t K = 2048;  // user-defined
+    static_assert(M <= TILE_HEIGHT, "GEMV path handles at most one tile row");
+
+    std::vector<bfloat16> src0_vec = create_random_vector_of_bfloat16_native(M * K * sizeof(bfloat16), 1, 123, -0.5);
+    std::vector<bfloat16> src1_vec = create_random_vector_of_bfloat16_native(K * N * sizeof(bfloat16), 1, 12522, -0.5);
+
+    std::vector<bfloat16> golden_vec(M * N, 0);
+    golden_matmul(src0_vec, src1_vec, golden_vec, M, N, K);
+
+    // A를 tile row 하나 (32 x K) 로 0 padding
+    std::vector<bfloat16> src0_padded(TILE_HEIGHT * K, bfloat16(0.0f));
+    std::copy(src0_vec.begin(), src0_vec.end(), src0_padded.begin());
+
+    std::vector<bfloat16> result_vec(TILE_HEIGHT * N);
+    matmul_gemv(tilize_nfaces(src0_padded, TILE_HEIGHT, K), tilize_nfaces(src1_vec, K, N), result_vec, N, K, mesh_device);
+    result_vec = untilize_nfaces(result_vec, TILE_HEIGHT, N);
+    result_vec.resize(M * N);
+
+    float pearson = check_bfloat16_vector_pcc(golden_vec, result_vec);
+    fmt::print("Metalium vs Golden -- PCC = {}\n", pearson);
+    TT_FATAL(pearson > 0.99, "PCC not high enough. Result PCC: {}, Expected PCC: 0.99", pearson);
+
+    pass &= mesh_device->close();
+
+    if (pass) {
+        fmt::print("Test Passed!!! - matmul gemv\n");
+    } else {
+        TT_THROW("Test Failed");
+    }
+
+    return 0;
+}
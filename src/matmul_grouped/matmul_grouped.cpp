@@ -0,0 +1,174 @@
+#include <chrono>
+#include <tt-metalium/host_api.hpp>
+#include <tt-metalium/constants.hpp>
+#include <tt-metalium/bfloat16.hpp>
+#include <tt-metalium/tilize_utils.hpp>
+#include <tt-metalium/device.hpp>
+#include <tt-metalium/tt_metal.hpp>
+#include <tt-metalium/distributed.hpp>
+#include <bmm_op.hpp>
+#include <bmm_grouped_program.hpp>
+#include <fmt/core.h>
+
+using namespace tt::constants;
+using namespace std;
+using namespace tt;
+using namespace tt::tt_metal;
+
+void golden_matmul(
+    std::vector<bfloat16>& a, std::vector<bfloat16>& b, std::vector<bfloat16>& output, uint32_t M, uint32_t N, uint32_t K) {
+    for (uint32_t i = 0; i < M; i++) {
+        for (uint32_t j = 0; j < N; j++) {
+            float c_f = 0;
+            for (uint32_t k = 0; k < K; k++) {
+                c_f += static_cast<float>(a[i * K + k]) * static_cast<float>(b[k * N + j]);
+            }
+            output.at(i * N + j) = bfloat16(c_f);
+        }
+    }
+}
+
+struct GroupShape {
+    uint32_t M;
+    uint32_t N;
+    uint32_t K;
+};
+
+/*
+    grouped matmul 예제. (MoE layer)
+
+    routed expert 8개는 같은 weight shape (K x N) 에 token 수 (M) 만 다르고, shared expert 하나는 모든 token을
+    받으며 N이 다르다. 모든 group을 launch 하나 (create_grouped_matmul_program) 로 돌린 것과
+    group 마다 launch 를 따로 한 것의 시간을 비교한다.
+*/
+int main() {
+    bool pass = true;
+
+    constexpr int device_id = 0;
+    std::shared_ptr<distributed::MeshDevice> mesh_device = distributed::MeshDevice::create_unit_mesh(device_id);
+    distributed::MeshCommandQueue& cq = mesh_device->mesh_command_queue();
+
+    constexpr uint32_t K = 512;  // user-defined (hidden)
+    constexpr uint32_t N = 512;  // user-defined (expert ffn)
+    // expert 별 token 수 (tile 단위로 padding 된 값)
+    std::vector<GroupShape> shapes = {
+        {64, N, K}, {256, N, K}, {32, N, K}, {160, N, K}, {96, N, K}, {32, N, K}, {192, N, K}, {128, N, K},
+        {960, 256, K},  // shared expert
+    };
+
+    tt::DataFormat cb_data_format = tt::DataFormat::Float16_b;
+    uint32_t single_tile_size = tt::tile_size(cb_data_format);
+    auto grid = mesh_device->compute_with_storage_grid_size();
+
+    // 모든 group이 같이 쓰는 block 분할. 행렬이 block의 배수가 아니어도 된다.
+    bmm_op_utils::MatmulBlockConfig config{
+        .per_core_M = 2, .per_core_N = 4, .in0_block_w = 4, .out_subblock_h = 2, .out_subblock_w = 4};
+
+    distributed::DeviceLocalBufferConfig dram_config{
+        .page_size = single_tile_size, .buffer_type = tt_metal::BufferType::DRAM};
+    std::vector<bmm_op_utils::MatmulGroup> groups;
+    std::vector<std::vector<bfloat16>> src0_vecs;
+    std::vector<std::vector<bfloat16>> src1_vecs;
+    for (uint32_t g = 0; g < shapes.size(); g++) {
+        auto [M, group_N, group_K] = shapes[g];
+        bmm_op_utils::MatmulGroup group{.Mt = M / TILE_HEIGHT, .Nt = group_N / TILE_WIDTH, .Kt = group_K / TILE_WIDTH};
+        distributed::ReplicatedBufferConfig buffer_config_A{.size = single_tile_size * group.Mt * group.Kt};
+        distributed::ReplicatedBufferConfig buffer_config_B{.size = single_tile_size * group.Kt * group.Nt};
+        distributed::ReplicatedBufferConfig buffer_config_C{.size = single_tile_size * group.Mt * group.Nt};
+        group.in0 = distributed::MeshBuffer::create(buffer_config_A, dram_config, mesh_device.get());
+        group.in1 = distributed::MeshBuffer::create(buffer_config_B, dram_config, mesh_device.get());
+        group.out = distributed::MeshBuffer::create(buffer_config_C, dram_config, mesh_device.get());
+
+        src0_vecs.push_back(create_random_vector_of_bfloat16_native(M * group_K * sizeof(bfloat16), 1, 123 + g, -0.5));
+        src1_vecs.push_back(
+            create_random_vector_of_bfloat16_native(group_K * group_N * sizeof(bfloat16), 1, 12522 + g, -0.5));
+        distributed::EnqueueWriteMeshBuffer(cq, group.in0, tilize_nfaces(src0_vecs[g], M, group_K), false);
+        distributed::EnqueueWriteMeshBuffer(cq, group.in1, tilize_nfaces(src1_vecs[g], group_K, group_N), false);
+        groups.push_back(group);
+    }
+
+    distributed::MeshCoordinateRange device_range = distributed::MeshCoordinateRange(mesh_device->shape());
+    constexpr uint32_t num_iterations = 10;
+    // workload 들을 차례로 launch 한다. 첫 launch는 kernel compile 시간이 들어가므로 한 번 돌린 뒤에 잰다.
+    auto time_workloads = [&](std::vector<distributed::MeshWorkload>& workloads) {
+        for (auto& workload : workloads) {
+            distributed::EnqueueMeshWorkload(cq, workload, false);
+        }
+        distributed::Finish(cq);
+        auto start = std::chrono::high_resolution_clock::now();
+        for (uint32_t i = 0; i < num_iterations; i++) {
+            for (auto& workload : workloads) {
+                distributed::EnqueueMeshWorkload(cq, workload, false);
+            }
+        }
+        distributed::Finish(cq);
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count() / num_iterations;
+    };
+
+    // group 마다 launch 하나
+    std::vector<std::shared_ptr<distributed::MeshBuffer>> tables;
+    std::vector<distributed::MeshWorkload> per_group_workloads(groups.size());
+    for (uint32_t g = 0; g < groups.size(); g++) {
+        std::vector<bmm_op_utils::MatmulGroup> single_group = {groups[g]};
+        tables.push_back(bmm_op_utils::create_matmul_group_table(mesh_device.get(), cq, single_group));
+        per_group_workloads[g].add_program(
+            device_range,
+            bmm_op_utils::create_grouped_matmul_program(
+                single_group, tables.back(), config, cb_data_format, MathFidelity::HiFi4, grid));
+    }
+    double per_group_us = time_workloads(per_group_workloads);
+
+    // 모든 group을 launch 하나로
+    auto table_buffer = bmm_op_utils::create_matmul_group_table(mesh_device.get(), cq, groups);
+    std::vector<distributed::MeshWorkload> grouped_workload(1);
+    grouped_workload[0].add_program(
+        device_range,
+        bmm_op_utils::create_grouped_matmul_program(
+            groups, table_buffer, config, cb_data_format, MathFidelity::HiFi4, grid));
+    double grouped_us = time_workloads(grouped_workload);
+
+    auto core_items = bmm_op_utils::balance_matmul_group_work(groups, config, grid.x * grid.y);
+    uint64_t max_load = 0;
+    uint64_t total_load = 0;
+    for (const auto& items : core_items) {
+        uint64_t load = 0;
+        for (const auto& item : items) {
+            load += item.k_blocks;
+        }
+        max_load = std::max(max_load, load);
+        total_load += load;
+    }
+    fmt::print(
+        " -- {} groups on {} cores, max / mean core load = {:.2f} --\n",
+        groups.size(),
+        core_items.size(),
+        (double)max_load * core_items.size() / total_load);
+    fmt::print(" -- one launch per group: {:.1f} us, grouped: {:.1f} us --\n", per_group_us, grouped_us);
+
+    // 마지막 launch는 grouped workload 이다.
+    for (uint32_t g = 0; g < groups.size(); g++) {
+        auto [M, group_N, group_K] = shapes[g];
+        std::vector<bfloat16> golden_vec(M * group_N, 0);
+        golden_matmul(src0_vecs[g], src1_vecs[g], golden_vec, M, group_N, group_K);
+
+        std::vector<bfloat16> result_vec(M * group_N);
+        distributed::EnqueueReadMeshBuffer(cq, result_vec, groups[g].out, true);
+        float pearson = check_bfloat16_vector_pcc(golden_vec, untilize_nfaces(result_vec, M, group_N));
+        fmt::print("Group {} ({}x{}x{}) Metalium vs Golden -- PCC = {}\n", g, M, group_N, group_K, pearson);
+        if (pearson < 0.99f) {
+            fmt::print("PCC not high enough for group {}. Result PCC: {}, Expected PCC: 0.99\n", g, pearson);
+            pass = false;
+        }
+    }
+
+    pass &= mesh_device->close();
+
+    if (pass) {
+        fmt::print("Test Passed!!! - matmul grouped\n");
+    } else {
+        TT_THROW("Test Failed");
+    }
+
+    return 0;
+}
@@ -22,6 +22,12 @@ namespace NAMESPACE {
  * Runtime arguments:
  *   - num_porduced_tiles: Number of output tiles to produce.
  *   - Kt: Number of tiles in the reduction dimension.
+ *   - k_block: Number of K tiles the reader pushes at once (Kt % k_block == 0).
+ *   - output_tile_start_id: First output tile of this core (used to find A row boundaries).
+ *   - Nt: Number of tiles in the N dimension.
+ *
+ * With A_ROW_REUSE defined, cb_in0 holds a whole A row (Kt tiles) which is kept until the last output tile of
+ * that row is done, so the reader only fetches each A row once per core.
  *
  * Circular buffers:
  *   - cb_in0: Input buffer for matrix A tiles.
@@ -34,11 +40,16 @@ namespace NAMESPACE {
 void MAIN {
     uint32_t num_output_tiles = get_arg_val<uint32_t>(0);  // number of output tiles to produce
     uint32_t Kt = get_arg_val<uint32_t>(1);                // number of tiles in K dimension for dot product
+    uint32_t k_block = get_arg_val<uint32_t>(2);           // number of K tiles pushed by the reader at once
+    uint32_t output_tile_start_id = get_arg_val<uint32_t>(3);
+    uint32_t Nt = get_arg_val<uint32_t>(4);
 
     constexpr tt::CBIndex cb_in0 = tt::CBIndex::c_0;
     constexpr tt::CBIndex cb_in1 = tt::CBIndex::c_1;
     constexpr tt::CBIndex cb_out = tt::CBIndex::c_16;
 
+    const uint32_t num_k_blocks = Kt / k_block;
+
     // Setup the FPU (matrix engine) for the matmul operation. And specify the input
     // and output circular buffers.
     mm_init(cb_in0, cb_in1, cb_out);
@@ -46,20 +57,40 @@ void MAIN {
     // the simplest possible version of outer product blocked matmul
     // the reader is expected to read the A's and B's tile rows and tile columns for each output tile
     for (uint32_t i = 0; i < num_output_tiles; ++i) {
+#ifdef A_ROW_REUSE
+        // The reader pushes a new A row whenever the output row changes (same rule as in the reader).
+        uint32_t tile_id = output_tile_start_id + i;
+        bool row_start = i == 0 || tile_id % Nt == 0;
+        bool row_end = i == num_output_tiles - 1 || (tile_id + 1) % Nt == 0;
+        if (row_start) {
+            cb_wait_front(cb_in0, Kt);
+        }
+#endif
+
         // Make sure registers can be used for the output tile. This also sets the registers to zero.
         tile_regs_acquire();
-        for (uint32_t kt = 0; kt < Kt; kt++) {
+        for (uint32_t kb = 0; kb < num_k_blocks; kb++) {
             // Wait for the input tiles to be available in the input circular buffers.
-            cb_wait_front(cb_in0, 1);
-            cb_wait_front(cb_in1, 1);
+            cb_wait_front(cb_in1, k_block);
+#ifndef A_ROW_REUSE
+            cb_wait_front(cb_in0, k_block);
+#endif
 
-            // Perform the matrix multiplication for the current tile.
-            // NOTE: This function also accumulates the result into the destination tile.
-            matmul_tiles(cb_in0, cb_in1, 0, 0, 0, false);
+            for (uint32_t k = 0; k < k_block; k++) {
+                // Perform the matrix multiplication for the current tile.
+                // NOTE: This function also accumulates the result into the destination tile.
+#ifdef A_ROW_REUSE
+                matmul_tiles(cb_in0, cb_in1, kb * k_block + k, k, 0, false);
+#else
+                matmul_tiles(cb_in0, cb_in1, k, k, 0, false);
+#endif
+            }
 
             // Mark the input tiles as used by popping them from the front of the circular buffers.
-            cb_pop_front(cb_in0, 1);
-            cb_pop_front(cb_in1, 1);
+            cb_pop_front(cb_in1, k_block);
+#ifndef A_ROW_REUSE
+            cb_pop_front(cb_in0, k_block);
+#endif
         }
 
         // Commit and wait for the registers are populated with the results from the FPU
@@ -75,6 +106,12 @@ void MAIN {
 
         // We don't need the registers anymore, so we can release them and prepare for the next output tile.
         tile_regs_release();
+
+#ifdef A_ROW_REUSE
+        if (row_end) {
+            cb_pop_front(cb_in0, Kt);
+        }
+#endif
     }
 }
 }  // namespace NAMESPACE
\ No newline at end of file
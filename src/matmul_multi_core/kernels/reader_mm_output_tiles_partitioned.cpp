@@ -13,6 +13,7 @@ void kernel_main() {
     uint32_t Nt = get_arg_val<uint32_t>(4);
     uint32_t output_tile_start_id = get_arg_val<uint32_t>(5);  // starting tile ID for output tiles
     uint32_t num_output_tiles = get_arg_val<uint32_t>(6);      // number of output tiles to read
+    uint32_t k_block = get_arg_val<uint32_t>(7);               // tiles read per barrier (Kt % k_block == 0)
 
     constexpr uint32_t cb_id_in0 = tt::CBIndex::c_0;
     constexpr uint32_t cb_id_in1 = tt::CBIndex::c_1;
@@ -28,7 +29,11 @@ void kernel_main() {
     constexpr auto b_args = TensorAccessorArgs<a_args.next_compile_time_args_offset()>();
     const auto b = TensorAccessor(b_args, src1_addr, in1_tile_bytes);
 
+    const uint32_t num_k_blocks = Kt / k_block;
+
     // Simple 2D matmul: A[Mt, Kt] @ B[Kt, Nt] = C[Mt, Nt]
+    // tile 하나마다 barrier를 기다리면 NoC read latency가 그대로 드러나므로, k_block 개의 read를 한꺼번에 날리고
+    // barrier는 한 번만 기다린다.
     for (uint32_t output_tile = 0; output_tile < num_output_tiles; output_tile++) {
         uint32_t current_tile_id = output_tile_start_id + output_tile;
 
@@ -36,27 +41,47 @@ void kernel_main() {
         uint32_t out_row = current_tile_id / Nt;  // Which row in output
         uint32_t out_col = current_tile_id % Nt;  // Which col in output
 
-        // Read all K tiles for this output position
-        for (uint32_t k = 0; k < Kt; k++) {
-            // Read A's tile at (out_row, k)
-            uint32_t tile_A = out_row * Kt + k;  // A is MK, so we stride by Kt
-            {
-                cb_reserve_back(cb_id_in0, 1);
-                uint32_t l1_write_addr_in0 = get_write_ptr(cb_id_in0);
-                noc_async_read_tile(tile_A, a, l1_write_addr_in0);
-                noc_async_read_barrier();
-                cb_push_back(cb_id_in0, 1);
+#ifdef A_ROW_REUSE
+        // 같은 out_row의 output tile은 A row (Kt tiles) 를 공유한다. row가 바뀔 때만 A row 전체를 c_0에 읽고,
+        // compute는 그 row의 마지막 output tile을 끝낸 뒤에 pop 한다.
+        if (output_tile == 0 || out_col == 0) {
+            cb_reserve_back(cb_id_in0, Kt);
+            uint32_t l1_write_addr_in0 = get_write_ptr(cb_id_in0);
+            for (uint32_t k = 0; k < Kt; k++) {
+                noc_async_read_tile(out_row * Kt + k, a, l1_write_addr_in0);
+                l1_write_addr_in0 += in0_tile_bytes;
+            }
+            noc_async_read_barrier();
+            cb_push_back(cb_id_in0, Kt);
+        }
+#endif
+
+        for (uint32_t kb = 0; kb < num_k_blocks; kb++) {
+            uint32_t k_start = kb * k_block;
+
+#ifndef A_ROW_REUSE
+            // Read A's tiles at (out_row, k_start ~ k_start + k_block)
+            cb_reserve_back(cb_id_in0, k_block);
+            uint32_t l1_write_addr_in0 = get_write_ptr(cb_id_in0);
+            for (uint32_t k = k_start; k < k_start + k_block; k++) {
+                noc_async_read_tile(out_row * Kt + k, a, l1_write_addr_in0);  // A is MK, so we stride by Kt
+                l1_write_addr_in0 += in0_tile_bytes;
             }
+#endif
 
-            // Read B's tile at (k, out_col)
-            uint32_t tile_B = k * Nt + out_col;  // B is KN, so we stride by Nt
-            {
-                cb_reserve_back(cb_id_in1, 1);
-                uint32_t l1_write_addr_in1 = get_write_ptr(cb_id_in1);
-                noc_async_read_tile(tile_B, b, l1_write_addr_in1);
-                noc_async_read_barrier();
-                cb_push_back(cb_id_in1, 1);
+            // Read B's tiles at (k_start ~ k_start + k_block, out_col)
+            cb_reserve_back(cb_id_in1, k_block);
+            uint32_t l1_write_addr_in1 = get_write_ptr(cb_id_in1);
+            for (uint32_t k = k_start; k < k_start + k_block; k++) {
+                noc_async_read_tile(k * Nt + out_col, b, l1_write_addr_in1);  // B is KN, so we stride by Nt
+                l1_write_addr_in1 += in1_tile_bytes;
             }
+
+            noc_async_read_barrier();
+#ifndef A_ROW_REUSE
+            cb_push_back(cb_id_in0, k_block);
+#endif
+            cb_push_back(cb_id_in1, k_block);
         }
     }
 }
\ No newline at end of file
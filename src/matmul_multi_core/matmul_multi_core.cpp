@@ -78,7 +78,8 @@ void golden_matmul(
  * @param mesh_device Target mesh device (1x1 or larger) for computation
  *
  * @note Matrix dimensions must be divisible by tile size (32x32) for this implementation
- * @note Uses circular buffers with 2 tiles for double-buffering to overlap compute and data movement
+ * @note Input circular buffers hold 2 batches of k_block tiles to overlap compute and data movement, and c_0 keeps
+ *       a whole A row for consecutive output tiles of the same row when it fits in L1
  */
 void matmul_multi_core(
     std::vector<bfloat16>& a,
@@ -147,16 +148,34 @@ void matmul_multi_core(
 
     // Configure Circular Buffers
     // Circular buffers act as staging areas for data movement between DRAM and compute units.
-    // Using 2 tiles per circular buffer to allow for double buffering (data movement can be reading from one tile while
-    // the compute kernel is using the other tile). This number can be adjusted based on the use case, but generally
-    // diminishing returns are observed after several tiles.
-    // input tiles count is = 2 so one tile can be read while the other is being processed
+    // The reader issues k_block tile reads back to back and waits on a single barrier, so the input circular buffers
+    // hold 2 * k_block tiles: one batch can be read while the compute kernel is using the other. k_block is the
+    // largest divisor of Kt up to max_k_block, since every batch has to cover the same number of K tiles.
+    // If a whole A row (Kt tiles) fits in L1 next to the B batches, c_0 keeps the A row for all consecutive output
+    // tiles of the same row (A_ROW_REUSE) instead of re-reading it from DRAM for every output tile.
     const auto cb_data_format = tt::DataFormat::Float16_b;
-    uint32_t num_input_tiles = 2;
+    constexpr uint32_t max_k_block = 8;
+    uint32_t k_block = 1;
+    for (uint32_t kb = std::min(max_k_block, Kt); kb > 0; kb--) {
+        if (Kt % kb == 0) {
+            k_block = kb;
+            break;
+        }
+    }
+    uint32_t num_input_tiles = 2 * k_block;
+    uint32_t num_output_tiles = 2;
+
+    auto l1_budget =
+        get_matmul_l1_budget(mesh_device.get(), cb_data_format, cb_data_format, cb_data_format, cb_data_format);
+    bool a_row_reuse =
+        (uint64_t)(Kt + num_input_tiles + num_output_tiles) * single_tile_size <= l1_budget.l1_size_bytes;
+    uint32_t num_in0_tiles = a_row_reuse ? Kt : num_input_tiles;
+    fmt::print(" -- k_block = {}, A row reuse: {} --\n", k_block, a_row_reuse);
+
     tt_metal::CreateCircularBuffer(
         program,
         all_cores,  // create on all cores
-        CircularBufferConfig(num_input_tiles * single_tile_size, {{CBIndex::c_0, cb_data_format}})
+        CircularBufferConfig(num_in0_tiles * single_tile_size, {{CBIndex::c_0, cb_data_format}})
             .set_page_size(CBIndex::c_0, single_tile_size));
 
     tt_metal::CreateCircularBuffer(
@@ -168,7 +187,7 @@ void matmul_multi_core(
     tt_metal::CreateCircularBuffer(
         program,
         all_cores,  // create on all cores
-        CircularBufferConfig(num_input_tiles * single_tile_size, {{CBIndex::c_16, cb_data_format}})
+        CircularBufferConfig(num_output_tiles * single_tile_size, {{CBIndex::c_16, cb_data_format}})
             .set_page_size(CBIndex::c_16, single_tile_size));
 
     // Create Kernels (Reader, Writer, Compute)
@@ -177,6 +196,10 @@ void matmul_multi_core(
     // - Compute kernel: Performs the actual matrix multiplication computation
     // All kernels run across all cores to enable parallel execution
     MathFidelity math_fidelity = MathFidelity::HiFi4;  // High fidelity math for accurate results
+    std::map<std::string, std::string> mm_defines;
+    if (a_row_reuse) {
+        mm_defines["A_ROW_REUSE"] = "1";
+    }
     std::vector<uint32_t> reader_compile_time_args;
     TensorAccessorArgs(*src0_dram_buffer).append_to(reader_compile_time_args);
     TensorAccessorArgs(*src1_dram_buffer).append_to(reader_compile_time_args);
@@ -187,7 +210,8 @@ void matmul_multi_core(
         tt_metal::DataMovementConfig{
             .processor = DataMovementProcessor::RISCV_1,
             .noc = NOC::RISCV_1_default,
-            .compile_args = reader_compile_time_args});
+            .compile_args = reader_compile_time_args,
+            .defines = mm_defines});
 
     std::vector<uint32_t> writer_compile_time_args;
     TensorAccessorArgs(*dst_dram_buffer).append_to(writer_compile_time_args);
@@ -204,7 +228,7 @@ void matmul_multi_core(
         program,
         OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/matmul_multi_core/kernels/mm.cpp",
         all_cores,
-        tt_metal::ComputeConfig{.math_fidelity = math_fidelity, .compile_args = {}});
+        tt_metal::ComputeConfig{.math_fidelity = math_fidelity, .compile_args = {}, .defines = mm_defines});
 
     // Set Runtime Arguments for Kernels
     // Each core needs to know which portion of the work it's responsible for. We are parallelizing across output
@@ -230,7 +254,8 @@ void matmul_multi_core(
                      Kt,                           // Number of tiles in K dimension
                      Nt,                           // Number of tiles in N dimension
                      work_offset,                  // Starting offset for this core's work
-                     work_per_core});              // Amount of work for this core
+                     work_per_core,                // Amount of work for this core
+                     k_block});                    // Number of K tiles read per barrier
 
                 // Set arguments for the writer kernel (data output)
                 tt_metal::SetRuntimeArgs(
@@ -242,7 +267,10 @@ void matmul_multi_core(
                     compute_kernel_id,
                     core,
                     {work_per_core,            // Amount of work for this core
-                     Kt});                     // Number of tiles in K dimension for dot product
+                     Kt,                       // Number of tiles in K dimension for dot product
+                     k_block,                  // Number of K tiles pushed by the reader at once
+                     work_offset,              // Starting offset for this core's work (A row boundaries)
+                     Nt});                     // Number of tiles in N dimension
                 work_offset += work_per_core;  // Update offset for next core
             }
         }
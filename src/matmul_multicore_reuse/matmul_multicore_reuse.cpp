@@ -4,9 +4,10 @@
 #include <tt-metalium/tilize_utils.hpp>
 #include <tt-metalium/device.hpp>
 #include <tt-metalium/tt_metal.hpp>
-#include <tt-metalium/tensor_accessor_args.hpp>
 #include <tt-metalium/distributed.hpp>
 #include <bmm_op.hpp>
+#include <bmm_padded_program.hpp>
+#include <bmm_reuse_program.hpp>
 #include <fmt/core.h>
 #include <iostream>
 
@@ -15,10 +16,6 @@ using namespace std;
 using namespace tt;
 using namespace tt::tt_metal;
 
-#ifndef OVERRIDE_KERNEL_PREFIX
-#define OVERRIDE_KERNEL_PREFIX ""
-#endif
-
 void golden_matmul(
     std::vector<bfloat16>& a,
     std::vector<bfloat16>& b,
@@ -26,28 +23,29 @@ void golden_matmul(
     uint32_t M,
     uint32_t N,
     uint32_t K,
-    uint32_t /*B*/) {
+    uint32_t B) {
     std::uint32_t idx_c = 0;
     std::uint32_t idx_a = 0;
     std::uint32_t idx_b = 0;
 
     float c_f;
     float float_tmp;
-    std::vector<bfloat16> c_bf(M * N, 0);
-
-    for (int i = 0; i < M; i++) {
-        for (int j = 0; j < N; j++) {
-            idx_c = j + (i * N);
-            idx_a = i * K;
-            idx_b = j;
-            c_f = 0;
-            for (int k_m = 0; k_m < K; k_m++) {
-                float_tmp = static_cast<float>(a[idx_a]) * static_cast<float>(b[idx_b]);
-                c_f += float_tmp;
-                idx_a += 1;
-                idx_b += N;
+
+    for (int batch = 0; batch < B; batch++) {
+        for (int i = 0; i < M; i++) {
+            for (int j = 0; j < N; j++) {
+                idx_c = batch * M * N + j + (i * N);
+                idx_a = batch * M * K + i * K;
+                idx_b = batch * K * N + j;
+                c_f = 0;
+                for (int k_m = 0; k_m < K; k_m++) {
+                    float_tmp = static_cast<float>(a[idx_a]) * static_cast<float>(b[idx_b]);
+                    c_f += float_tmp;
+                    idx_a += 1;
+                    idx_b += N;
+                }
+                output.at(idx_c) = bfloat16(c_f);
             }
-            output.at(idx_c) = bfloat16(c_f);
         }
     }
 }
@@ -75,7 +73,6 @@ void matmul_multicore_reuse(
     distributed::MeshCommandQueue& cq = mesh_device->mesh_command_queue();
     distributed::MeshWorkload workload;
     distributed::MeshCoordinateRange device_range = distributed::MeshCoordinateRange(mesh_device->shape());
-    Program program{};
 
     tt::DataFormat cb_data_format = tt::DataFormat::Float16_b;
     MathFidelity math_fidelity = MathFidelity::HiFi4;
@@ -95,88 +92,6 @@ void matmul_multicore_reuse(
     uint32_t Kt = K / TILE_WIDTH;
     uint32_t Nt = N / TILE_WIDTH;
 
-    // NOTE: Only supports matmuls where output is blocks of 16 x 16 tiles (ie. multiples of 16*32 x 16*32)
-    // NOTE: Maximum number of tiles in output is 120 * 16^2 = 30,720 (eg. [1, 1, 5120, 6144])2
-    uint32_t in0_block_w = 2;       // in0_block_w := K-block 마다 tile 몇 개 들어있나를 나타내는 변수
-    // uint32_t out_subblock_h = 4;
-    // uint32_t out_subblock_w = 2;
-    // uint32_t per_core_M = 16;
-    // uint32_t per_core_N = 16;
-
-    // Get large matmul params
-    auto matmul_params = bmm_op_utils::get_large_matmul_params(Mt, Nt, num_cores_y, num_cores_x, in0_block_w);
-    uint32_t per_core_M = std::get<0>(matmul_params);           // how many output tiles in M (rows) a single core is responsible for.
-    uint32_t per_core_N = std::get<1>(matmul_params);           // how many output tiles in N (cols) a single core is responsible for.
-    uint32_t out_subblock_h = std::get<2>(matmul_params);       // the sub-block height (in tiles) inside a core’s output block
-    uint32_t out_subblock_w = std::get<3>(matmul_params);       // the sub-block width (in tiles) inside a core’s output block
-
-    fmt::print(" -- Metalium Core Sizing --\n");
-    fmt::print(
-        " -- per_core_M= {} -- per_core_N= {} -- out_subblock_h= {} -- out_subblock_w= {} --\n",
-        per_core_M,
-        per_core_N,
-        out_subblock_h,
-        out_subblock_w);
-
-    TT_ASSERT(Mt % per_core_M == 0);
-    TT_ASSERT(Nt % per_core_N == 0);
-    TT_ASSERT(Kt % in0_block_w == 0);
-
-    uint32_t in0_block_tiles = per_core_M * in0_block_w;    // in0 circular buffer에 들어갈 block의 tile의 수
-    uint32_t in0_CB_tiles = in0_block_tiles * 2;  // double buffer
-    uint32_t in0_CB_size = in0_CB_tiles * single_tile_size;
-    uint32_t in1_block_tiles = per_core_N * in0_block_w;
-    uint32_t in1_CB_tiles = in1_block_tiles * 2;  // double buffer
-    uint32_t in1_CB_size = in1_CB_tiles * single_tile_size;
-    uint32_t out_block_tiles = per_core_M * per_core_N;
-    uint32_t out_CB_tiles = out_block_tiles;  // No double buffer
-    uint32_t out_CB_size = out_CB_tiles * single_tile_size;
-
-    // Compute kernel compile time args
-    uint32_t num_blocks = (Kt / in0_block_w);   // 입력 행렬 A(MxK)에서 K축의 block의 갯수
-
-    uint32_t in0_num_subblocks = (per_core_M / out_subblock_h);
-    uint32_t in0_block_num_tiles = out_subblock_h * in0_block_w * in0_num_subblocks;    // A에서 하나의 block에 포함된 타일의 갯수
-    uint32_t in0_subblock_num_tiles = out_subblock_h * in0_block_w;
-
-    uint32_t in1_num_subblocks = (per_core_N / out_subblock_w);
-    uint32_t in1_block_num_tiles = out_subblock_w * in0_block_w * in1_num_subblocks;
-    uint32_t in1_per_core_w = out_subblock_w * in1_num_subblocks;  
-
-    uint32_t out_subblock_num_tiles = out_subblock_h * out_subblock_w;
-
-    std::vector<uint32_t> compute_kernel_args = {
-        in0_block_w,             // in0_block_w
-        in0_num_subblocks,       // in0_num_subblocks
-        in0_block_num_tiles,     // in0_block_num_tiles
-        in0_subblock_num_tiles,  // in0_subblock_num_tiles
-
-        in1_num_subblocks,    // in1_num_subblocks
-        in1_block_num_tiles,  // in1_block_num_tiles
-        in1_per_core_w,       // in1_per_core_w
-
-        num_blocks,  // num_blocks
-
-        out_subblock_h,          // out_subblock_h
-        out_subblock_w,          // out_subblock_w
-        out_subblock_num_tiles,  // out_subblock_num_tiles
-        B                        // batch
-    };
-
-    /*
-     * Multi-Core prep
-     */
-    // auto compute_with_storage_grid_size = device->compute_with_storage_grid_size();
-    // uint32_t num_cores_x = compute_with_storage_grid_size.x;
-    // uint32_t num_cores_y = compute_with_storage_grid_size.y;
-
-    uint32_t num_blocks_y = Mt / per_core_M;        // 1
-    uint32_t num_blocks_x = Nt / per_core_N;        // 10
-    uint32_t num_blocks_total = num_blocks_y * num_blocks_x;        // 1* 10 = 10
-    TT_ASSERT(num_blocks_total <= num_cores_x * num_cores_y);
-    CoreRangeSet all_cores(
-        tt::tt_metal::num_cores_to_corerangeset(num_blocks_x * num_blocks_y, compute_with_storage_grid_size, true));
-
     //////////////////////////////////////////////////
     /*
      * Create DRAM buffers for input and output matrices (replicated per device across the mesh).
@@ -184,11 +99,11 @@ void matmul_multicore_reuse(
      */
 
     uint32_t dram_buffer_A_size =
-        single_tile_size * Mt * Kt;  // num_tiles of FP16_B, hard-coded in the reader/writer kernels
+        single_tile_size * Mt * Kt * B;  // num_tiles of FP16_B, hard-coded in the reader/writer kernels
     uint32_t dram_buffer_B_size =
-        single_tile_size * Nt * Kt;  // num_tiles of FP16_B, hard-coded in the reader/writer kernels
+        single_tile_size * Nt * Kt * (bcast_batch ? 1 : B);  // num_tiles of FP16_B, hard-coded in the reader/writer kernels
     uint32_t dram_buffer_C_size =
-        single_tile_size * Mt * Nt;  // num_tiles of FP16_B, hard-coded in the reader/writer kernels
+        single_tile_size * Mt * Nt * B;  // num_tiles of FP16_B, hard-coded in the reader/writer kernels
 
     distributed::DeviceLocalBufferConfig dram_config{
         .page_size = single_tile_size, .buffer_type = tt_metal::BufferType::DRAM};
@@ -203,142 +118,110 @@ void matmul_multicore_reuse(
     auto src1_dram_buffer = distributed::MeshBuffer::create(buffer_config_B, dram_config, mesh_device.get());
     auto dst_dram_buffer = distributed::MeshBuffer::create(buffer_config_C, dram_config, mesh_device.get());
 
-    /*
-     * Config of Circular Buffer in the device L1
-     * input tiles count is = 2 because it's single tile process, and double-buffer
-     */
-    uint32_t src0_cb_index = CBIndex::c_0;  // 0
-    CircularBufferConfig cb_src0_config = CircularBufferConfig(in0_CB_size, {{src0_cb_index, cb_data_format}})
-                                              .set_page_size(src0_cb_index, single_tile_size);
-    tt_metal::CreateCircularBuffer(program, all_cores, cb_src0_config);
-
-    uint32_t src1_cb_index = CBIndex::c_1;  // 1
-    CircularBufferConfig cb_src1_config = CircularBufferConfig(in1_CB_size, {{src1_cb_index, cb_data_format}})
-                                              .set_page_size(src1_cb_index, single_tile_size);
-    tt_metal::CreateCircularBuffer(program, all_cores, cb_src1_config);
-
-    uint32_t output_cb_index = tt::CBIndex::c_16;
-    uint32_t interm0_cb_index = 24;
-    std::map<uint8_t, tt::DataFormat> output_cb_data_format_spec{
-        {output_cb_index, cb_data_format}, {interm0_cb_index, cb_data_format}};
-    CircularBufferConfig cb_output_config = CircularBufferConfig(out_CB_size, output_cb_data_format_spec)
-                                                .set_page_size(output_cb_index, single_tile_size)
-                                                .set_page_size(interm0_cb_index, single_tile_size);
-    tt_metal::CreateCircularBuffer(program, all_cores, cb_output_config);
+    uint32_t in0_block_w = Kt % 2 == 0 ? 2 : 1;  // in0_block_w := K-block 마다 tile 몇 개 들어있나를 나타내는 변수
 
     /*
-     * Compile time arguments
-     */
-    std::vector<uint32_t> reader_compile_time_args;
-    TensorAccessorArgs(*src0_dram_buffer).append_to(reader_compile_time_args);
-    TensorAccessorArgs(*src1_dram_buffer).append_to(reader_compile_time_args);
+        c_16과 c_24가 같은 L1을 쓰면 compute는 다음 batch의 첫 K block에서 c_24에 partial을 쓰기 전에
+        writer가 이전 output block을 다 쓸 때까지 기다려야 한다. (bmm_large_block_zm의 cb_reserve_back(c_16, ...))
+        B > 1 이면 output을 double buffer로 잡고 c_24를 따로 만드는 L1 budget으로 block을 고른다. 그래서 writer가
+        이전 block을 내보내는 동안 compute가 다음 batch를 계산한다. 그 budget으로는 분할이 없으면
+        (block이 작아져도 grid에 나누어 떨어지지 않으면) c_16 / c_24를 같이 쓰는 single buffer budget으로 다시 고른다.
+    */
+    auto single_buffer_budget =
+        get_matmul_l1_budget(mesh_device.get(), cb_data_format, cb_data_format, cb_data_format, cb_data_format);
+    auto double_buffer_budget = get_matmul_l1_budget(
+        mesh_device.get(), cb_data_format, cb_data_format, cb_data_format, cb_data_format, false, 2);
 
-    std::vector<uint32_t> writer_compile_time_args;
-    TensorAccessorArgs(*dst_dram_buffer).append_to(writer_compile_time_args);
+    // Get large matmul params
+    std::tuple<uint32_t, uint32_t, uint32_t, uint32_t> matmul_params = {0, 0, 0, 0};
+    bool double_buffer_output = false;
+    if (B > 1) {
+        matmul_params = bmm_op_utils::get_large_matmul_params(
+            Mt, Nt, num_cores_y, num_cores_x, in0_block_w, 8, double_buffer_budget);
+        double_buffer_output = std::get<0>(matmul_params) != 0;
+    }
+    if (!double_buffer_output) {
+        matmul_params = bmm_op_utils::get_large_matmul_params(
+            Mt, Nt, num_cores_y, num_cores_x, in0_block_w, 8, single_buffer_budget);
+    }
+    bmm_op_utils::MatmulBlockConfig config{
+        std::get<0>(matmul_params),  // how many output tiles in M (rows) a single core is responsible for.
+        std::get<1>(matmul_params),  // how many output tiles in N (cols) a single core is responsible for.
+        in0_block_w,
+        std::get<2>(matmul_params),  // the sub-block height (in tiles) inside a core’s output block
+        std::get<3>(matmul_params)   // the sub-block width (in tiles) inside a core’s output block
+    };
 
-    /*
-     * Create Kernels (Reader, Writer, Compute)
-     */
-    // Create reader and writer kernels per core
-    auto reader_id = tt_metal::CreateKernel(
-        program,
-        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/matmul_common/kernels/reader_bmm_tile_layout.cpp",
-        all_cores,
-        tt_metal::DataMovementConfig{
-            .processor = DataMovementProcessor::RISCV_1,
-            .noc = NOC::RISCV_1_default,
-            .compile_args = reader_compile_time_args});
-
-    auto writer_id = tt_metal::CreateKernel(
-        program,
-        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/matmul_common/kernels/writer_bmm_tile_layout.cpp",
-        all_cores,
-        tt_metal::DataMovementConfig{
-            .processor = DataMovementProcessor::RISCV_0,
-            .noc = NOC::RISCV_0_default,
-            .compile_args = writer_compile_time_args});
-
-    // Create compute kernel
-    tt_metal::CreateKernel(
-        program,
-        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/matmul_common/kernels/bmm_large_block_zm.cpp",
-        all_cores,
-        tt_metal::ComputeConfig{.math_fidelity = math_fidelity, .compile_args = compute_kernel_args});
+    distributed::EnqueueWriteMeshBuffer(cq, src0_dram_buffer, a, false);
+    distributed::EnqueueWriteMeshBuffer(cq, src1_dram_buffer, b, false);
 
     /*
-     * Kernels - Runtime arguments
-     */
-    uint32_t num_blocks_read = 0;
-    // num_blocks_x = 10, num_blocks_y = 1
-    // 즉 10개 num_blocks_x * num_blocks_y의 개수만큼 RuntimeArgs를 만든다. (10개의 코어가 돌아감)
-    for (int output_idx_y = 0; output_idx_y < num_blocks_y; output_idx_y++) {
-        for (int output_idx_x = 0; output_idx_x < num_blocks_x; output_idx_x++) {
-            int core_idx_x = num_blocks_read % num_cores_x;
-            int core_idx_y = num_blocks_read / num_cores_x;
-            CoreCoord core = {(std::size_t)core_idx_x, (std::size_t)core_idx_y};
-
-            // Write runtime args to device
-            std::vector<uint32_t> mm_reader_args = {
-                (std::uint32_t)src0_dram_buffer->address(),     // in0_tensor_addr
-                (std::uint32_t)Kt * per_core_M * output_idx_y,  // in0_tensor_start_tile_id
-                (std::uint32_t)1,                               // in0_tensor_stride_w
-                (std::uint32_t)Kt,                              // in0_tensor_stride_h
-                (std::uint32_t)in0_block_w,                     // in0_tensor_next_block_stride
-
-                (std::uint32_t)in0_block_w,               // in0_block_w
-                (std::uint32_t)per_core_M,                // in0_block_h
-                (std::uint32_t)in0_block_w * per_core_M,  // in0_block_num_tiles
-
-                (std::uint32_t)src1_dram_buffer->address(),  // in1_tensor_addr
-                (std::uint32_t)per_core_N * output_idx_x,    // in1_tensor_start_tile_id
-                (std::uint32_t)1,                            // in1_tensor_stride_w
-                (std::uint32_t)Nt,                           // in1_tensor_stride_h
-                (std::uint32_t)in0_block_w * Nt,             // in1_tensor_next_block_stride
-
-                (std::uint32_t)per_core_N,                // in1_block_w
-                (std::uint32_t)in0_block_w,               // in1_block_h
-                (std::uint32_t)per_core_N * in0_block_w,  // in1_block_num_tiles
-
-                (std::uint32_t)Kt / in0_block_w,  // num_blocks
-
-                (std::uint32_t)Mt * Kt,     // MtKt
-                (std::uint32_t)Kt * Nt,     // KtNt
-                (std::uint32_t)B,           // batch
-                (std::uint32_t)bcast_batch  // bcast_B
-            };
-
-            std::vector<uint32_t> writer_args = {
-                (std::uint32_t)dst_dram_buffer->address(),  // out_buffer_addr
-                ((std::uint32_t)output_idx_x * per_core_N) +
-                    (output_idx_y * per_core_M * Nt),  // out_tensor_start_tile_id
-                (std::uint32_t)1,                      // out_tensor_stride_w
-                (std::uint32_t)Nt,                     // out_tensor_stride_h
-                (std::uint32_t)out_subblock_w,         // out_tensor_next_subblock_stride_w
-                (std::uint32_t)out_subblock_h * Nt,    // out_tensor_next_subblock_stride_h
-
-                (std::uint32_t)out_subblock_w,                     // out_subblock_w
-                (std::uint32_t)out_subblock_h,                     // out_subblock_h
-                (std::uint32_t)(out_subblock_w * out_subblock_h),  // out_subblocks_w * out_subblocks_h
-                (std::uint32_t)(per_core_N / out_subblock_w),      // out_num_subblocks_w
-                (std::uint32_t)(per_core_M / out_subblock_h),      // out_num_subblocks_h
-
-                (std::uint32_t)Mt * Nt,  // MtNt
-                (std::uint32_t)B         // batch
-            };
-
-            tt_metal::SetRuntimeArgs(program, reader_id, core, mm_reader_args);
-            tt_metal::SetRuntimeArgs(program, writer_id, core, writer_args);
-
-            num_blocks_read++;
-        }
+        Mt, Nt를 grid에 나누어 떨어지게 나누지 못하면 ({0, 0, 0, 0}) 마지막 row / column block이 행렬 밖으로 나가는
+        padded program으로 돌린다. (bmm_padded_program.hpp)
+    */
+    if (config.per_core_M == 0) {
+        auto padded_budget = get_matmul_l1_budget(
+            mesh_device.get(), cb_data_format, cb_data_format, cb_data_format, cb_data_format, false);
+        auto padded_params = bmm_op_utils::get_padded_matmul_params(
+            Mt, Nt, num_cores_y, num_cores_x, in0_block_w, 8, padded_budget);
+        config = {
+            std::get<0>(padded_params),
+            std::get<1>(padded_params),
+            in0_block_w,
+            std::get<2>(padded_params),
+            std::get<3>(padded_params)};
+        TT_FATAL(config.per_core_M != 0, "No block of Mt = {}, Nt = {} fits in L1", Mt, Nt);
+        fmt::print(
+            " -- padded blocks: per_core_M= {} -- per_core_N= {} -- out_subblock_h= {} -- out_subblock_w= {} --\n",
+            config.per_core_M,
+            config.per_core_N,
+            config.out_subblock_h,
+            config.out_subblock_w);
+        workload.add_program(
+            device_range,
+            bmm_op_utils::create_matmul_padded_program(
+                src0_dram_buffer,
+                src1_dram_buffer,
+                dst_dram_buffer,
+                Mt,
+                Nt,
+                Kt,
+                B,
+                bcast_batch,
+                config,
+                cb_data_format,
+                math_fidelity,
+                compute_with_storage_grid_size));
+    } else {
+        fmt::print(" -- Metalium Core Sizing --\n");
+        fmt::print(
+            " -- per_core_M= {} -- per_core_N= {} -- out_subblock_h= {} -- out_subblock_w= {} --\n",
+            config.per_core_M,
+            config.per_core_N,
+            config.out_subblock_h,
+            config.out_subblock_w);
+        fmt::print(" -- double buffered output: {} --\n", double_buffer_output);
+
+        // output block (Mt / per_core_M) * (Nt / per_core_N) 개를 core 하나씩에 두고 각 core가 B 전체를 돈다.
+        workload.add_program(
+            device_range,
+            bmm_op_utils::create_matmul_multicore_reuse_program(
+                src0_dram_buffer,
+                src1_dram_buffer,
+                dst_dram_buffer,
+                Mt,
+                Nt,
+                Kt,
+                B,
+                bcast_batch,
+                config,
+                cb_data_format,
+                math_fidelity,
+                compute_with_storage_grid_size,
+                {.double_buffer_output = double_buffer_output}));
     }
 
     /* Launch program & read back results */
-
-    // Non-blocking uploads allow overlapping host setup with device transfers
-    distributed::EnqueueWriteMeshBuffer(cq, src0_dram_buffer, a, false);
-    distributed::EnqueueWriteMeshBuffer(cq, src1_dram_buffer, b, false);
-    workload.add_program(device_range, std::move(program));
     distributed::EnqueueMeshWorkload(cq, workload, false);
     // Blocking read from shard {0,0} waits for completion and populates 'output'
     distributed::EnqueueReadMeshBuffer(cq, output, dst_dram_buffer, true);
@@ -363,33 +246,34 @@ int main() {
     constexpr uint32_t M = 640;  // user-defined
     constexpr uint32_t N = 640;  // user-defined
     constexpr uint32_t K = 640;  // user-defined
-    constexpr uint32_t B = 1;    // user-defined
+    constexpr uint32_t B = 2;    // user-defined
 
     uint32_t Mt = M / TILE_HEIGHT;
     uint32_t Kt = K / TILE_WIDTH;
     uint32_t Nt = N / TILE_WIDTH;
 
     constexpr uint32_t single_tile_size = 2 * 1024;     // TILE_HEIGHT = 32, TILE_WIDTH = 32
-    uint32_t dram_buffer_A_size = single_tile_size * Mt * Kt;  // num_tiles of FP16_B
-    uint32_t dram_buffer_B_size = single_tile_size * Nt * Kt;  // num_tiles of FP16_B
-    uint32_t dram_buffer_C_size = single_tile_size * Mt * Nt;  // num_tiles of FP16_B
+    uint32_t dram_buffer_A_size = single_tile_size * Mt * Kt * B;  // num_tiles of FP16_B
+    uint32_t dram_buffer_B_size = single_tile_size * Nt * Kt * B;  // num_tiles of FP16_B
+    uint32_t dram_buffer_C_size = single_tile_size * Mt * Nt * B;  // num_tiles of FP16_B
 
     /* input vectors */
     std::vector<bfloat16> src0_vec = create_random_vector_of_bfloat16_native(dram_buffer_A_size, 1, 123, -0.4);
     std::vector<bfloat16> src1_vec = create_random_vector_of_bfloat16_native(dram_buffer_B_size, 1, 12522, -0.3);
 
     /* Golden Matmul running on CPU (Float)*/
-    std::vector<bfloat16> golden_vec(M * N, 0);
+    std::vector<bfloat16> golden_vec(B * M * N, 0);
     golden_matmul(src0_vec, src1_vec, golden_vec, M, N, K, B);
 
     /* Input vector tilizing */
-    src0_vec = tilize_nfaces(src0_vec, M, K);
-    src1_vec = tilize_nfaces(src1_vec, K, N);
+    // batch가 row 방향으로 쌓여 있으므로 (B * M) x K 로 tilize 해도 batch 마다 tilize 한 것과 같다.
+    src0_vec = tilize_nfaces(src0_vec, B * M, K);
+    src1_vec = tilize_nfaces(src1_vec, B * K, N);
 
     /* Calling the MatMul host program. Read in result into a host vector */
     std::vector<bfloat16> result_vec(dram_buffer_C_size / sizeof(bfloat16));
     matmul_multicore_reuse(src0_vec, src1_vec, result_vec, false, M, N, K, B, mesh_device);
-    result_vec = untilize_nfaces(result_vec, M, N);
+    result_vec = untilize_nfaces(result_vec, B * M, N);
 
     fmt::print("Output vector of size {}\n", result_vec.size());
 
@@ -0,0 +1,460 @@
+#include <tt-metalium/host_api.hpp>
+#include <tt-metalium/constants.hpp>
+#include <tt-metalium/bfloat16.hpp>
+#include <tt-metalium/tilize_utils.hpp>
+#include <tt-metalium/device.hpp>
+#include <tt-metalium/tt_metal.hpp>
+#include <tt-metalium/tensor_accessor_args.hpp>
+#include <tt-metalium/distributed.hpp>
+#include <bmm_op.hpp>
+#include <fmt/core.h>
+#include <iostream>
+
+using namespace tt::constants;
+using namespace std;
+using namespace tt;
+using namespace tt::tt_metal;
+
+#ifndef OVERRIDE_KERNEL_PREFIX
+#define OVERRIDE_KERNEL_PREFIX ""
+#endif
+
+void golden_matmul(
+    std::vector<bfloat16>& a,
+    std::vector<bfloat16>& b,
+    std::vector<bfloat16>& output,
+    uint32_t M,
+    uint32_t N,
+    uint32_t K,
+    uint32_t /*B*/) {
+    std::uint32_t idx_c = 0;
+    std::uint32_t idx_a = 0;
+    std::uint32_t idx_b = 0;
+
+    float c_f;
+    float float_tmp;
+    std::vector<bfloat16> c_bf(M * N, 0);
+
+    for (int i = 0; i < M; i++) {
+        for (int j = 0; j < N; j++) {
+            idx_c = j + (i * N);
+            idx_a = i * K;
+            idx_b = j;
+            c_f = 0;
+            for (int k_m = 0; k_m < K; k_m++) {
+                float_tmp = static_cast<float>(a[idx_a]) * static_cast<float>(b[idx_b]);
+                c_f += float_tmp;
+                idx_a += 1;
+                idx_b += N;
+            }
+            output.at(idx_c) = bfloat16(c_f);
+        }
+    }
+}
+
+    /*
+        본 예제에서는 행렬을 타일들의 묶음인 block으로 나누고 다시 block을 tensix core에서 sub-block 단위로 처리한다.
+        데이터를 읽어올 때는 block 단위로 읽어서 L1의 cb에 저장하고
+        compute kernel에서는 읽어온 block을 다시 sub-block 단위로 나누어서 sub-block 단위로 계산한다.
+
+        matmul_multicore_reuse 와 달리 output block (by, bx)를 core (x = bx, y = by)에 그대로 배치한다.
+        같은 row의 core들은 같은 in0 block을, 같은 column의 core들은 같은 in1 block을 쓰므로
+        x = 0 core가 in0를, y = 0 core가 in1을 DRAM에서 한 번만 읽어서 나머지 core들에게 multicast 한다.
+        (reader_bmm_tile_layout_mcast.cpp 참고)
+    */
+
+void matmul_multicore_reuse_mcast(
+    std::vector<bfloat16>& a,
+    std::vector<bfloat16>& b,
+    std::vector<bfloat16>& output,
+    bool bcast_batch,
+    uint32_t M,
+    uint32_t N,
+    uint32_t K,
+    uint32_t B,
+    const std::shared_ptr<distributed::MeshDevice>& mesh_device) {
+    /*
+     * Set up Mesh API constructs: command queue, workload, device range, and program.
+     * We'll distribute work across multiple cores using the device's compute grid.
+     */
+    distributed::MeshCommandQueue& cq = mesh_device->mesh_command_queue();
+    distributed::MeshWorkload workload;
+    distributed::MeshCoordinateRange device_range = distributed::MeshCoordinateRange(mesh_device->shape());
+    Program program{};
+
+    tt::DataFormat cb_data_format = tt::DataFormat::Float16_b;
+    MathFidelity math_fidelity = MathFidelity::HiFi4;
+    uint32_t single_tile_size = tt::tile_size(cb_data_format);
+    // uint32_t single_tile_size = 2 * 1024;
+
+    auto compute_with_storage_grid_size = mesh_device->compute_with_storage_grid_size();
+    uint32_t num_cores_x = compute_with_storage_grid_size.x;
+    uint32_t num_cores_y = compute_with_storage_grid_size.y;
+
+    /*
+     * EXtracting Matrix dimensions from input/output vectors
+     */
+    // C = A*B
+    // MN = MK*KN
+    uint32_t Mt = M / TILE_HEIGHT;
+    uint32_t Kt = K / TILE_WIDTH;
+    uint32_t Nt = N / TILE_WIDTH;
+
+    // NOTE: Only supports matmuls where output is blocks of 16 x 16 tiles (ie. multiples of 16*32 x 16*32)
+    // NOTE: Maximum number of tiles in output is 120 * 16^2 = 30,720 (eg. [1, 1, 5120, 6144])2
+    uint32_t in0_block_w = 2;       // in0_block_w := K-block 마다 tile 몇 개 들어있나를 나타내는 변수
+    // uint32_t out_subblock_h = 4;
+    // uint32_t out_subblock_w = 2;
+    // uint32_t per_core_M = 16;
+    // uint32_t per_core_N = 16;
+
+    // Get large matmul params
+    auto matmul_params = bmm_op_utils::get_large_matmul_params(Mt, Nt, num_cores_y, num_cores_x, in0_block_w);
+    uint32_t per_core_M = std::get<0>(matmul_params);           // how many output tiles in M (rows) a single core is responsible for.
+    uint32_t per_core_N = std::get<1>(matmul_params);           // how many output tiles in N (cols) a single core is responsible for.
+    uint32_t out_subblock_h = std::get<2>(matmul_params);       // the sub-block height (in tiles) inside a core’s output block
+    uint32_t out_subblock_w = std::get<3>(matmul_params);       // the sub-block width (in tiles) inside a core’s output block
+
+    fmt::print(" -- Metalium Core Sizing --\n");
+    fmt::print(
+        " -- per_core_M= {} -- per_core_N= {} -- out_subblock_h= {} -- out_subblock_w= {} --\n",
+        per_core_M,
+        per_core_N,
+        out_subblock_h,
+        out_subblock_w);
+
+    TT_ASSERT(Mt % per_core_M == 0);
+    TT_ASSERT(Nt % per_core_N == 0);
+    TT_ASSERT(Kt % in0_block_w == 0);
+
+    uint32_t in0_block_tiles = per_core_M * in0_block_w;    // in0 circular buffer에 들어갈 block의 tile의 수
+    uint32_t in0_CB_tiles = in0_block_tiles * 2;  // double buffer
+    uint32_t in0_CB_size = in0_CB_tiles * single_tile_size;
+    uint32_t in1_block_tiles = per_core_N * in0_block_w;
+    uint32_t in1_CB_tiles = in1_block_tiles * 2;  // double buffer
+    uint32_t in1_CB_size = in1_CB_tiles * single_tile_size;
+    uint32_t out_block_tiles = per_core_M * per_core_N;
+    uint32_t out_CB_tiles = out_block_tiles;  // No double buffer
+    uint32_t out_CB_size = out_CB_tiles * single_tile_size;
+
+    // Compute kernel compile time args
+    uint32_t num_blocks = (Kt / in0_block_w);   // 입력 행렬 A(MxK)에서 K축의 block의 갯수
+
+    uint32_t in0_num_subblocks = (per_core_M / out_subblock_h);
+    uint32_t in0_block_num_tiles = out_subblock_h * in0_block_w * in0_num_subblocks;    // A에서 하나의 block에 포함된 타일의 갯수
+    uint32_t in0_subblock_num_tiles = out_subblock_h * in0_block_w;
+
+    uint32_t in1_num_subblocks = (per_core_N / out_subblock_w);
+    uint32_t in1_block_num_tiles = out_subblock_w * in0_block_w * in1_num_subblocks;
+    uint32_t in1_per_core_w = out_subblock_w * in1_num_subblocks;  
+
+    uint32_t out_subblock_num_tiles = out_subblock_h * out_subblock_w;
+
+    std::vector<uint32_t> compute_kernel_args = {
+        in0_block_w,             // in0_block_w
+        in0_num_subblocks,       // in0_num_subblocks
+        in0_block_num_tiles,     // in0_block_num_tiles
+        in0_subblock_num_tiles,  // in0_subblock_num_tiles
+
+        in1_num_subblocks,    // in1_num_subblocks
+        in1_block_num_tiles,  // in1_block_num_tiles
+        in1_per_core_w,       // in1_per_core_w
+
+        num_blocks,  // num_blocks
+
+        out_subblock_h,          // out_subblock_h
+        out_subblock_w,          // out_subblock_w
+        out_subblock_num_tiles,  // out_subblock_num_tiles
+        B                        // batch
+    };
+
+    /*
+     * Multi-Core prep
+     */
+    // auto compute_with_storage_grid_size = device->compute_with_storage_grid_size();
+    // uint32_t num_cores_x = compute_with_storage_grid_size.x;
+    // uint32_t num_cores_y = compute_with_storage_grid_size.y;
+
+    uint32_t num_blocks_y = Mt / per_core_M;        // 1
+    uint32_t num_blocks_x = Nt / per_core_N;        // 10
+    // multicast는 사각형 영역으로 보내므로 block grid를 core grid에 그대로 올린다.
+    TT_FATAL(
+        num_blocks_x <= num_cores_x && num_blocks_y <= num_cores_y,
+        "Block grid {}x{} does not fit the core grid {}x{}",
+        num_blocks_x,
+        num_blocks_y,
+        num_cores_x,
+        num_cores_y);
+    CoreRange all_cores({0, 0}, {num_blocks_x - 1, num_blocks_y - 1});
+
+    //////////////////////////////////////////////////
+    /*
+     * Create DRAM buffers for input and output matrices (replicated per device across the mesh).
+     * We'll upload input vectors into these mesh buffers prior to launching the program.
+     */
+
+    uint32_t dram_buffer_A_size =
+        single_tile_size * Mt * Kt;  // num_tiles of FP16_B, hard-coded in the reader/writer kernels
+    uint32_t dram_buffer_B_size =
+        single_tile_size * Nt * Kt;  // num_tiles of FP16_B, hard-coded in the reader/writer kernels
+    uint32_t dram_buffer_C_size =
+        single_tile_size * Mt * Nt;  // num_tiles of FP16_B, hard-coded in the reader/writer kernels
+
+    distributed::DeviceLocalBufferConfig dram_config{
+        .page_size = single_tile_size, .buffer_type = tt_metal::BufferType::DRAM};
+
+    distributed::ReplicatedBufferConfig buffer_config_A{.size = dram_buffer_A_size};
+
+    distributed::ReplicatedBufferConfig buffer_config_B{.size = dram_buffer_B_size};
+
+    distributed::ReplicatedBufferConfig buffer_config_C{.size = dram_buffer_C_size};
+
+    auto src0_dram_buffer = distributed::MeshBuffer::create(buffer_config_A, dram_config, mesh_device.get());
+    auto src1_dram_buffer = distributed::MeshBuffer::create(buffer_config_B, dram_config, mesh_device.get());
+    auto dst_dram_buffer = distributed::MeshBuffer::create(buffer_config_C, dram_config, mesh_device.get());
+
+    /*
+     * Config of Circular Buffer in the device L1
+     * input tiles count is = 2 because it's single tile process, and double-buffer
+     */
+    uint32_t src0_cb_index = CBIndex::c_0;  // 0
+    CircularBufferConfig cb_src0_config = CircularBufferConfig(in0_CB_size, {{src0_cb_index, cb_data_format}})
+                                              .set_page_size(src0_cb_index, single_tile_size);
+    tt_metal::CreateCircularBuffer(program, all_cores, cb_src0_config);
+
+    uint32_t src1_cb_index = CBIndex::c_1;  // 1
+    CircularBufferConfig cb_src1_config = CircularBufferConfig(in1_CB_size, {{src1_cb_index, cb_data_format}})
+                                              .set_page_size(src1_cb_index, single_tile_size);
+    tt_metal::CreateCircularBuffer(program, all_cores, cb_src1_config);
+
+    uint32_t output_cb_index = tt::CBIndex::c_16;
+    uint32_t interm0_cb_index = 24;
+    std::map<uint8_t, tt::DataFormat> output_cb_data_format_spec{
+        {output_cb_index, cb_data_format}, {interm0_cb_index, cb_data_format}};
+    CircularBufferConfig cb_output_config = CircularBufferConfig(out_CB_size, output_cb_data_format_spec)
+                                                .set_page_size(output_cb_index, single_tile_size)
+                                                .set_page_size(interm0_cb_index, single_tile_size);
+    tt_metal::CreateCircularBuffer(program, all_cores, cb_output_config);
+
+    /*
+     * Compile time arguments
+     */
+    std::vector<uint32_t> reader_compile_time_args;
+    TensorAccessorArgs(*src0_dram_buffer).append_to(reader_compile_time_args);
+    TensorAccessorArgs(*src1_dram_buffer).append_to(reader_compile_time_args);
+
+    std::vector<uint32_t> writer_compile_time_args;
+    TensorAccessorArgs(*dst_dram_buffer).append_to(writer_compile_time_args);
+
+    /*
+     * Create Kernels (Reader, Writer, Compute)
+     */
+    // Create reader and writer kernels per core
+    auto reader_id = tt_metal::CreateKernel(
+        program,
+        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/matmul_common/kernels/reader_bmm_tile_layout_mcast.cpp",
+        all_cores,
+        tt_metal::DataMovementConfig{
+            .processor = DataMovementProcessor::RISCV_1,
+            .noc = NOC::RISCV_1_default,
+            .compile_args = reader_compile_time_args});
+
+    auto writer_id = tt_metal::CreateKernel(
+        program,
+        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/matmul_common/kernels/writer_bmm_tile_layout.cpp",
+        all_cores,
+        tt_metal::DataMovementConfig{
+            .processor = DataMovementProcessor::RISCV_0,
+            .noc = NOC::RISCV_0_default,
+            .compile_args = writer_compile_time_args});
+
+    // Create compute kernel
+    tt_metal::CreateKernel(
+        program,
+        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/matmul_common/kernels/bmm_large_block_zm.cpp",
+        all_cores,
+        tt_metal::ComputeConfig{.math_fidelity = math_fidelity, .compile_args = compute_kernel_args});
+
+    /*
+     * Multicast semaphores (sender: 준비된 receiver 수, receiver: VALID / INVALID)
+     */
+    uint32_t in0_mcast_sender_sem_id = tt_metal::CreateSemaphore(program, all_cores, 0);
+    uint32_t in0_mcast_receiver_sem_id = tt_metal::CreateSemaphore(program, all_cores, 0);
+    uint32_t in1_mcast_sender_sem_id = tt_metal::CreateSemaphore(program, all_cores, 0);
+    uint32_t in1_mcast_receiver_sem_id = tt_metal::CreateSemaphore(program, all_cores, 0);
+
+    /*
+     * Kernels - Runtime arguments
+     */
+    for (int output_idx_y = 0; output_idx_y < num_blocks_y; output_idx_y++) {
+        for (int output_idx_x = 0; output_idx_x < num_blocks_x; output_idx_x++) {
+            CoreCoord core = {(std::size_t)output_idx_x, (std::size_t)output_idx_y};
+
+            // in0: row의 x = 0 core가 sender, x = 1 .. num_blocks_x - 1 이 receiver
+            // in1: column의 y = 0 core가 sender, y = 1 .. num_blocks_y - 1 이 receiver
+            // kernel 안의 NoC 주소는 physical 좌표를 써야 한다.
+            // receiver가 없으면 (grid 폭 / 높이가 1) dest 좌표는 쓰이지 않는다.
+            std::size_t x = output_idx_x;
+            std::size_t y = output_idx_y;
+            std::size_t x_first = std::min<std::size_t>(1, num_blocks_x - 1);
+            std::size_t y_first = std::min<std::size_t>(1, num_blocks_y - 1);
+            CoreCoord in0_sender = mesh_device->worker_core_from_logical_core({0, y});
+            CoreCoord in0_dest_start = mesh_device->worker_core_from_logical_core({x_first, y});
+            CoreCoord in0_dest_end = mesh_device->worker_core_from_logical_core({num_blocks_x - 1, y});
+            CoreCoord in1_sender = mesh_device->worker_core_from_logical_core({x, 0});
+            CoreCoord in1_dest_start = mesh_device->worker_core_from_logical_core({x, y_first});
+            CoreCoord in1_dest_end = mesh_device->worker_core_from_logical_core({x, num_blocks_y - 1});
+
+            // Write runtime args to device
+            std::vector<uint32_t> mm_reader_args = {
+                (std::uint32_t)src0_dram_buffer->address(),     // in0_tensor_addr
+                (std::uint32_t)Kt * per_core_M * output_idx_y,  // in0_tensor_start_tile_id
+                (std::uint32_t)1,                               // in0_tensor_stride_w
+                (std::uint32_t)Kt,                              // in0_tensor_stride_h
+                (std::uint32_t)in0_block_w,                     // in0_tensor_next_block_stride
+
+                (std::uint32_t)in0_block_w,               // in0_block_w
+                (std::uint32_t)per_core_M,                // in0_block_h
+                (std::uint32_t)in0_block_w * per_core_M,  // in0_block_num_tiles
+
+                (std::uint32_t)src1_dram_buffer->address(),  // in1_tensor_addr
+                (std::uint32_t)per_core_N * output_idx_x,    // in1_tensor_start_tile_id
+                (std::uint32_t)1,                            // in1_tensor_stride_w
+                (std::uint32_t)Nt,                           // in1_tensor_stride_h
+                (std::uint32_t)in0_block_w * Nt,             // in1_tensor_next_block_stride
+
+                (std::uint32_t)per_core_N,                // in1_block_w
+                (std::uint32_t)in0_block_w,               // in1_block_h
+                (std::uint32_t)per_core_N * in0_block_w,  // in1_block_num_tiles
+
+                (std::uint32_t)Kt / in0_block_w,  // num_blocks
+
+                (std::uint32_t)Mt * Kt,     // MtKt
+                (std::uint32_t)Kt * Nt,     // KtNt
+                (std::uint32_t)B,            // batch
+                (std::uint32_t)bcast_batch,  // bcast_B
+
+                (std::uint32_t)(output_idx_x == 0),  // in0_is_sender
+                (std::uint32_t)in0_sender.x,         // in0_sender_noc_x
+                (std::uint32_t)in0_sender.y,         // in0_sender_noc_y
+                (std::uint32_t)in0_dest_start.x,     // in0_mcast_dest_noc_start_x
+                (std::uint32_t)in0_dest_start.y,     // in0_mcast_dest_noc_start_y
+                (std::uint32_t)in0_dest_end.x,       // in0_mcast_dest_noc_end_x
+                (std::uint32_t)in0_dest_end.y,       // in0_mcast_dest_noc_end_y
+                (std::uint32_t)num_blocks_x - 1,     // in0_mcast_num_dests
+
+                (std::uint32_t)(output_idx_y == 0),  // in1_is_sender
+                (std::uint32_t)in1_sender.x,         // in1_sender_noc_x
+                (std::uint32_t)in1_sender.y,         // in1_sender_noc_y
+                (std::uint32_t)in1_dest_start.x,     // in1_mcast_dest_noc_start_x
+                (std::uint32_t)in1_dest_start.y,     // in1_mcast_dest_noc_start_y
+                (std::uint32_t)in1_dest_end.x,       // in1_mcast_dest_noc_end_x
+                (std::uint32_t)in1_dest_end.y,       // in1_mcast_dest_noc_end_y
+                (std::uint32_t)num_blocks_y - 1,     // in1_mcast_num_dests
+
+                in0_mcast_sender_sem_id,
+                in0_mcast_receiver_sem_id,
+                in1_mcast_sender_sem_id,
+                in1_mcast_receiver_sem_id};
+
+            std::vector<uint32_t> writer_args = {
+                (std::uint32_t)dst_dram_buffer->address(),  // out_buffer_addr
+                ((std::uint32_t)output_idx_x * per_core_N) +
+                    (output_idx_y * per_core_M * Nt),  // out_tensor_start_tile_id
+                (std::uint32_t)1,                      // out_tensor_stride_w
+                (std::uint32_t)Nt,                     // out_tensor_stride_h
+                (std::uint32_t)out_subblock_w,         // out_tensor_next_subblock_stride_w
+                (std::uint32_t)out_subblock_h * Nt,    // out_tensor_next_subblock_stride_h
+
+                (std::uint32_t)out_subblock_w,                     // out_subblock_w
+                (std::uint32_t)out_subblock_h,                     // out_subblock_h
+                (std::uint32_t)(out_subblock_w * out_subblock_h),  // out_subblocks_w * out_subblocks_h
+                (std::uint32_t)(per_core_N / out_subblock_w),      // out_num_subblocks_w
+                (std::uint32_t)(per_core_M / out_subblock_h),      // out_num_subblocks_h
+
+                (std::uint32_t)Mt * Nt,  // MtNt
+                (std::uint32_t)B         // batch
+            };
+
+            tt_metal::SetRuntimeArgs(program, reader_id, core, mm_reader_args);
+            tt_metal::SetRuntimeArgs(program, writer_id, core, writer_args);
+        }
+    }
+
+    /* Launch program & read back results */
+
+    // Non-blocking uploads allow overlapping host setup with device transfers
+    distributed::EnqueueWriteMeshBuffer(cq, src0_dram_buffer, a, false);
+    distributed::EnqueueWriteMeshBuffer(cq, src1_dram_buffer, b, false);
+    workload.add_program(device_range, std::move(program));
+    distributed::EnqueueMeshWorkload(cq, workload, false);
+    // Blocking read from shard {0,0} waits for completion and populates 'output'
+    distributed::EnqueueReadMeshBuffer(cq, output, dst_dram_buffer, true);
+}
+
+///////////////////////////////////////
+
+int main() {
+    bool pass = true;
+
+    /* Silicon accelerator setup */
+    constexpr int device_id = 0;
+    std::shared_ptr<distributed::MeshDevice> mesh_device = distributed::MeshDevice::create_unit_mesh(device_id);
+
+    ////////////////////////////////////////////////////////////////////////////
+    //                      Matmul Parameters Setup
+    ////////////////////////////////////////////////////////////////////////////
+    // NOTE: Only supports matmuls where output is blocks of 16 x 16 tiles (ie. multiples of 16*32 x 16*32)
+    // NOTE: Maximum number of tiles in output is 120 * 16^2 = 30,720 (eg. [1, 1, 5120, 6144])
+
+    /* Create source data */
+    constexpr uint32_t M = 640;  // user-defined
+    constexpr uint32_t N = 640;  // user-defined
+    constexpr uint32_t K = 640;  // user-defined
+    constexpr uint32_t B = 1;    // user-defined
+
+    uint32_t Mt = M / TILE_HEIGHT;
+    uint32_t Kt = K / TILE_WIDTH;
+    uint32_t Nt = N / TILE_WIDTH;
+
+    constexpr uint32_t single_tile_size = 2 * 1024;     // TILE_HEIGHT = 32, TILE_WIDTH = 32
+    uint32_t dram_buffer_A_size = single_tile_size * Mt * Kt;  // num_tiles of FP16_B
+    uint32_t dram_buffer_B_size = single_tile_size * Nt * Kt;  // num_tiles of FP16_B
+    uint32_t dram_buffer_C_size = single_tile_size * Mt * Nt;  // num_tiles of FP16_B
+
+    /* input vectors */
+    std::vector<bfloat16> src0_vec = create_random_vector_of_bfloat16_native(dram_buffer_A_size, 1, 123, -0.4);
+    std::vector<bfloat16> src1_vec = create_random_vector_of_bfloat16_native(dram_buffer_B_size, 1, 12522, -0.3);
+
+    /* Golden Matmul running on CPU (Float)*/
+    std::vector<bfloat16> golden_vec(M * N, 0);
+    golden_matmul(src0_vec, src1_vec, golden_vec, M, N, K, B);
+
+    /* Input vector tilizing */
+    src0_vec = tilize_nfaces(src0_vec, M, K);
+    src1_vec = tilize_nfaces(src1_vec, K, N);
+
+    /* Calling the MatMul host program. Read in result into a host vector */
+    std::vector<bfloat16> result_vec(dram_buffer_C_size / sizeof(bfloat16));
+    matmul_multicore_reuse_mcast(src0_vec, src1_vec, result_vec, false, M, N, K, B, mesh_device);
+    result_vec = untilize_nfaces(result_vec, M, N);
+
+    fmt::print("Output vector of size {}\n", result_vec.size());
+
+    float pearson = check_bfloat16_vector_pcc(golden_vec, result_vec);
+    fmt::print("Metalium vs Golden -- PCC = {}\n", pearson);
+    TT_FATAL(pearson > 0.99, "PCC not high enough. Result PCC: {}, Expected PCC: 0.99", pearson);
+
+    pass &= mesh_device->close();
+
+
+    if (pass) {
+        fmt::print("Test Passed!!! - matmul multicore reuse mcast\n");
+    } else {
+        TT_THROW("Test Failed");
+    }
+
+    TT_ASSERT(pass);
+
+    return 0;
+}
\ No newline at end of file
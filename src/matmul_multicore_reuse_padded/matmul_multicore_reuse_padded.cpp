@@ -0,0 +1,188 @@
+#include <tt-metalium/host_api.hpp>
+#include <tt-metalium/constants.hpp>
+#include <tt-metalium/bfloat16.hpp>
+#include <tt-metalium/tilize_utils.hpp>
+#include <tt-metalium/device.hpp>
+#include <tt-metalium/tt_metal.hpp>
+#include <tt-metalium/distributed.hpp>
+#include <bmm_op.hpp>
+#include <bmm_padded_program.hpp>
+#include <fmt/core.h>
+
+using namespace tt::constants;
+using namespace std;
+using namespace tt;
+using namespace tt::tt_metal;
+
+void golden_matmul(
+    std::vector<bfloat16>& a, std::vector<bfloat16>& b, std::vector<bfloat16>& output, uint32_t M, uint32_t N, uint32_t K) {
+    for (uint32_t i = 0; i < M; i++) {
+        for (uint32_t j = 0; j < N; j++) {
+            float c_f = 0;
+            for (uint32_t k = 0; k < K; k++) {
+                c_f += static_cast<float>(a[i * K + k]) * static_cast<float>(b[k * N + j]);
+            }
+            output.at(i * N + j) = bfloat16(c_f);
+        }
+    }
+}
+
+// rows x cols 행렬을 32의 배수 크기로 0-padding 한다. (tile 안쪽의 padding은 host에서 tilize 할 때 같이 처리)
+std::vector<bfloat16> pad_to_tiles(const std::vector<bfloat16>& vec, uint32_t rows, uint32_t cols) {
+    uint32_t padded_rows = (rows + TILE_HEIGHT - 1) / TILE_HEIGHT * TILE_HEIGHT;
+    uint32_t padded_cols = (cols + TILE_WIDTH - 1) / TILE_WIDTH * TILE_WIDTH;
+    std::vector<bfloat16> padded(padded_rows * padded_cols, bfloat16(0.0f));
+    for (uint32_t r = 0; r < rows; r++) {
+        std::copy(vec.begin() + r * cols, vec.begin() + (r + 1) * cols, padded.begin() + r * padded_cols);
+    }
+    return padded;
+}
+
+/*
+    matmul_multicore_reuse 의 임의 크기 버전. (create_matmul_padded_program 참고)
+
+    - Mt, Nt, Kt가 block 크기의 배수일 필요가 없다. 마지막 row / column block은 유효한 tile을 덮는 sub-block만
+      계산하고, 모자란 tile은 reader가 0으로 채우고 writer는 행렬 밖의 output tile을 쓰지 않는다.
+      (DRAM에는 tile 단위로 올림한 크기만 있고 block 단위 padding은 device에서 만든다.)
+    - output block 수가 core 수보다 많으면 core 하나가 block 여러 개를 처리한다.
+*/
+void matmul_multicore_reuse_padded(
+    std::vector<bfloat16>& a,
+    std::vector<bfloat16>& b,
+    std::vector<bfloat16>& output,
+    uint32_t M,
+    uint32_t N,
+    uint32_t K,
+    const std::shared_ptr<distributed::MeshDevice>& mesh_device) {
+    distributed::MeshCommandQueue& cq = mesh_device->mesh_command_queue();
+    distributed::MeshWorkload workload;
+    distributed::MeshCoordinateRange device_range = distributed::MeshCoordinateRange(mesh_device->shape());
+
+    tt::DataFormat cb_data_format = tt::DataFormat::Float16_b;
+    MathFidelity math_fidelity = MathFidelity::HiFi4;
+    uint32_t single_tile_size = tt::tile_size(cb_data_format);
+
+    auto compute_with_storage_grid_size = mesh_device->compute_with_storage_grid_size();
+    uint32_t num_cores_x = compute_with_storage_grid_size.x;
+    uint32_t num_cores_y = compute_with_storage_grid_size.y;
+
+    // tile 단위로 올림한 크기
+    uint32_t Mt = (M + TILE_HEIGHT - 1) / TILE_HEIGHT;
+    uint32_t Kt = (K + TILE_WIDTH - 1) / TILE_WIDTH;
+    uint32_t Nt = (N + TILE_WIDTH - 1) / TILE_WIDTH;
+
+    uint32_t in0_block_w = std::min<uint32_t>(2, Kt);
+
+    // c_24를 c_16과 따로 만든다. (create_matmul_padded_program 참고)
+    auto l1_budget = get_matmul_l1_budget(
+        mesh_device.get(), cb_data_format, cb_data_format, cb_data_format, cb_data_format, false);
+    auto matmul_params =
+        bmm_op_utils::get_padded_matmul_params(Mt, Nt, num_cores_y, num_cores_x, in0_block_w, 8, l1_budget);
+    bmm_op_utils::MatmulBlockConfig config{
+        std::get<0>(matmul_params),
+        std::get<1>(matmul_params),
+        in0_block_w,
+        std::get<2>(matmul_params),
+        std::get<3>(matmul_params)};
+    TT_FATAL(config.per_core_M != 0, "No block of Mt = {}, Nt = {} fits in L1", Mt, Nt);
+
+    uint32_t num_blocks_y = (Mt + config.per_core_M - 1) / config.per_core_M;
+    uint32_t num_blocks_x = (Nt + config.per_core_N - 1) / config.per_core_N;
+    uint32_t num_k_blocks = (Kt + in0_block_w - 1) / in0_block_w;
+
+    fmt::print(" -- Metalium Core Sizing --\n");
+    fmt::print(
+        " -- per_core_M= {} -- per_core_N= {} -- out_subblock_h= {} -- out_subblock_w= {} --\n",
+        config.per_core_M,
+        config.per_core_N,
+        config.out_subblock_h,
+        config.out_subblock_w);
+    fmt::print(
+        " -- output blocks= {}x{} -- padded tiles M= {} N= {} K= {} --\n",
+        num_blocks_y,
+        num_blocks_x,
+        num_blocks_y * config.per_core_M - Mt,
+        num_blocks_x * config.per_core_N - Nt,
+        num_k_blocks * in0_block_w - Kt);
+
+    distributed::DeviceLocalBufferConfig dram_config{
+        .page_size = single_tile_size, .buffer_type = tt_metal::BufferType::DRAM};
+
+    distributed::ReplicatedBufferConfig buffer_config_A{.size = single_tile_size * Mt * Kt};
+    distributed::ReplicatedBufferConfig buffer_config_B{.size = single_tile_size * Nt * Kt};
+    distributed::ReplicatedBufferConfig buffer_config_C{.size = single_tile_size * Mt * Nt};
+
+    auto src0_dram_buffer = distributed::MeshBuffer::create(buffer_config_A, dram_config, mesh_device.get());
+    auto src1_dram_buffer = distributed::MeshBuffer::create(buffer_config_B, dram_config, mesh_device.get());
+    auto dst_dram_buffer = distributed::MeshBuffer::create(buffer_config_C, dram_config, mesh_device.get());
+
+    distributed::EnqueueWriteMeshBuffer(cq, src0_dram_buffer, a, false);
+    distributed::EnqueueWriteMeshBuffer(cq, src1_dram_buffer, b, false);
+    workload.add_program(
+        device_range,
+        bmm_op_utils::create_matmul_padded_program(
+            src0_dram_buffer,
+            src1_dram_buffer,
+            dst_dram_buffer,
+            Mt,
+            Nt,
+            Kt,
+            1,
+            false,
+            config,
+            cb_data_format,
+            math_fidelity,
+            compute_with_storage_grid_size));
+    distributed::EnqueueMeshWorkload(cq, workload, false);
+    distributed::EnqueueReadMeshBuffer(cq, output, dst_dram_buffer, true);
+}
+
+int main() {
+    bool pass = true;
+
+    constexpr int device_id = 0;
+    std::shared_ptr<distributed::MeshDevice> mesh_device = distributed::MeshDevice::create_unit_mesh(device_id);
+
+    // 32의 배수도, block의 배수도 아닌 크기 (user-defined)
+    constexpr uint32_t M = 300;
+    constexpr uint32_t N = 1000;
+    constexpr uint32_t K = 200;
+
+    uint32_t M_pad = (M + TILE_HEIGHT - 1) / TILE_HEIGHT * TILE_HEIGHT;
+    uint32_t N_pad = (N + TILE_WIDTH - 1) / TILE_WIDTH * TILE_WIDTH;
+    uint32_t K_pad = (K + TILE_WIDTH - 1) / TILE_WIDTH * TILE_WIDTH;
+
+    std::vector<bfloat16> src0_vec = create_random_vector_of_bfloat16_native(M * K * sizeof(bfloat16), 1, 123, -0.4);
+    std::vector<bfloat16> src1_vec = create_random_vector_of_bfloat16_native(K * N * sizeof(bfloat16), 1, 12522, -0.3);
+
+    std::vector<bfloat16> golden_vec(M * N, 0);
+    golden_matmul(src0_vec, src1_vec, golden_vec, M, N, K);
+
+    std::vector<bfloat16> src0_tilized = tilize_nfaces(pad_to_tiles(src0_vec, M, K), M_pad, K_pad);
+    std::vector<bfloat16> src1_tilized = tilize_nfaces(pad_to_tiles(src1_vec, K, N), K_pad, N_pad);
+
+    std::vector<bfloat16> result_vec(M_pad * N_pad);
+    matmul_multicore_reuse_padded(src0_tilized, src1_tilized, result_vec, M, N, K, mesh_device);
+    result_vec = untilize_nfaces(result_vec, M_pad, N_pad);
+
+    // padding을 잘라낸다.
+    std::vector<bfloat16> result_cropped(M * N);
+    for (uint32_t r = 0; r < M; r++) {
+        std::copy(
+            result_vec.begin() + r * N_pad, result_vec.begin() + r * N_pad + N, result_cropped.begin() + r * N);
+    }
+
+    float pearson = check_bfloat16_vector_pcc(golden_vec, result_cropped);
+    fmt::print("Metalium vs Golden -- PCC = {}\n", pearson);
+    TT_FATAL(pearson > 0.99, "PCC not high enough. Result PCC: {}, Expected PCC: 0.99", pearson);
+
+    pass &= mesh_device->close();
+
+    if (pass) {
+        fmt::print("Test Passed!!! - matmul multicore reuse padded\n");
+    } else {
+        TT_THROW("Test Failed");
+    }
+
+    return 0;
+}
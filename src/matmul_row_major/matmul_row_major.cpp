@@ -0,0 +1,175 @@
+#include <chrono>
+#include <tt-metalium/host_api.hpp>
+#include <tt-metalium/constants.hpp>
+#include <tt-metalium/bfloat16.hpp>
+#include <tt-metalium/tilize_utils.hpp>
+#include <tt-metalium/device.hpp>
+#include <tt-metalium/tt_metal.hpp>
+#include <tt-metalium/distributed.hpp>
+#include <bmm_op.hpp>
+#include <bmm_reuse_program.hpp>
+#include <fmt/core.h>
+
+using namespace tt::constants;
+using namespace std;
+using namespace tt;
+using namespace tt::tt_metal;
+
+void golden_matmul(
+    std::vector<bfloat16>& a, std::vector<bfloat16>& b, std::vector<bfloat16>& output, uint32_t M, uint32_t N, uint32_t K) {
+    for (uint32_t i = 0; i < M; i++) {
+        for (uint32_t j = 0; j < N; j++) {
+            float c_f = 0;
+            for (uint32_t k = 0; k < K; k++) {
+                c_f += static_cast<float>(a[i * K + k]) * static_cast<float>(b[k * N + j]);
+            }
+            output.at(i * N + j) = bfloat16(c_f);
+        }
+    }
+}
+
+/*
+    row-major I/O matmul 예제.
+
+    다른 예제는 upload 전에 tilize_nfaces, readback 후에 untilize_nfaces 를 host에서 (single thread) 돌린다.
+    row_major_io 로 만든 program은 row-major DRAM buffer를 그대로 받고 reader / writer는 행렬 row 단위로 옮기며
+    compute kernel이 L1에서 tilize / untilize 하므로 host는 행렬을 그대로 올리고 내려받는다.
+    두 방식의 host layout 변환 시간과 전체 시간을 비교한다.
+*/
+int main() {
+    bool pass = true;
+
+    constexpr int device_id = 0;
+    std::shared_ptr<distributed::MeshDevice> mesh_device = distributed::MeshDevice::create_unit_mesh(device_id);
+    distributed::MeshCommandQueue& cq = mesh_device->mesh_command_queue();
+
+    constexpr uint32_t M = 640;  // user-defined
+    constexpr uint32_t N = 640;  // user-defined
+    constexpr uint32_t K = 640;  // user-defined
+
+    uint32_t Mt = M / TILE_HEIGHT;
+    uint32_t Kt = K / TILE_WIDTH;
+    uint32_t Nt = N / TILE_WIDTH;
+
+    tt::DataFormat cb_data_format = tt::DataFormat::Float16_b;
+    uint32_t single_tile_size = tt::tile_size(cb_data_format);
+    auto grid = mesh_device->compute_with_storage_grid_size();
+
+    uint32_t in0_block_w = 2;
+    auto matmul_params = bmm_op_utils::get_large_matmul_params(Mt, Nt, grid.y, grid.x, in0_block_w);
+    bmm_op_utils::MatmulBlockConfig config{
+        std::get<0>(matmul_params),
+        std::get<1>(matmul_params),
+        in0_block_w,
+        std::get<2>(matmul_params),
+        std::get<3>(matmul_params)};
+    TT_FATAL(config.per_core_M != 0, "No valid core sizing for Mt = {}, Nt = {}", Mt, Nt);
+
+    // tile layout buffer (page = tile)
+    distributed::DeviceLocalBufferConfig dram_config{
+        .page_size = single_tile_size, .buffer_type = tt_metal::BufferType::DRAM};
+    distributed::ReplicatedBufferConfig buffer_config_A{.size = single_tile_size * Mt * Kt};
+    distributed::ReplicatedBufferConfig buffer_config_B{.size = single_tile_size * Nt * Kt};
+    distributed::ReplicatedBufferConfig buffer_config_C{.size = single_tile_size * Mt * Nt};
+    auto src0_tile_buffer = distributed::MeshBuffer::create(buffer_config_A, dram_config, mesh_device.get());
+    auto src1_tile_buffer = distributed::MeshBuffer::create(buffer_config_B, dram_config, mesh_device.get());
+    auto dst_tile_buffer = distributed::MeshBuffer::create(buffer_config_C, dram_config, mesh_device.get());
+
+    // row-major buffer (page = 행렬 row)
+    auto src0_row_major_buffer = bmm_op_utils::create_matmul_row_major_buffer(mesh_device.get(), M, K);
+    auto src1_row_major_buffer = bmm_op_utils::create_matmul_row_major_buffer(mesh_device.get(), K, N);
+    auto dst_row_major_buffer = bmm_op_utils::create_matmul_row_major_buffer(mesh_device.get(), M, N);
+
+    std::vector<bfloat16> src0_vec = create_random_vector_of_bfloat16_native(M * K * sizeof(bfloat16), 1, 123, -0.5);
+    std::vector<bfloat16> src1_vec = create_random_vector_of_bfloat16_native(K * N * sizeof(bfloat16), 1, 12522, -0.5);
+    std::vector<bfloat16> golden_vec(M * N, 0);
+    golden_matmul(src0_vec, src1_vec, golden_vec, M, N, K);
+
+    distributed::MeshCoordinateRange device_range = distributed::MeshCoordinateRange(mesh_device->shape());
+    auto make_workload = [&](const std::shared_ptr<distributed::MeshBuffer>& src0,
+                             const std::shared_ptr<distributed::MeshBuffer>& src1,
+                             const std::shared_ptr<distributed::MeshBuffer>& dst,
+                             bool row_major_io) {
+        distributed::MeshWorkload workload;
+        workload.add_program(
+            device_range,
+            bmm_op_utils::create_matmul_multicore_reuse_program(
+                src0,
+                src1,
+                dst,
+                Mt,
+                Nt,
+                Kt,
+                1,
+                false,
+                config,
+                cb_data_format,
+                MathFidelity::HiFi4,
+                grid,
+                {.row_major_io = row_major_io}));
+        return workload;
+    };
+    auto tile_workload = make_workload(src0_tile_buffer, src1_tile_buffer, dst_tile_buffer, false);
+    auto row_major_workload = make_workload(src0_row_major_buffer, src1_row_major_buffer, dst_row_major_buffer, true);
+
+    // 첫 launch는 kernel compile 시간이 들어가므로 한 번씩 먼저 돌린다.
+    distributed::EnqueueMeshWorkload(cq, tile_workload, false);
+    distributed::EnqueueMeshWorkload(cq, row_major_workload, false);
+    distributed::Finish(cq);
+
+    using clock = std::chrono::high_resolution_clock;
+    auto us = [](clock::time_point start, clock::time_point end) {
+        return std::chrono::duration<double, std::micro>(end - start).count();
+    };
+
+    // tile layout: host tilize -> upload -> matmul -> download -> host untilize
+    auto start = clock::now();
+    auto src0_tiles = tilize_nfaces(src0_vec, M, K);
+    auto src1_tiles = tilize_nfaces(src1_vec, K, N);
+    double tile_layout_us = us(start, clock::now());
+    distributed::EnqueueWriteMeshBuffer(cq, src0_tile_buffer, src0_tiles, false);
+    distributed::EnqueueWriteMeshBuffer(cq, src1_tile_buffer, src1_tiles, false);
+    distributed::EnqueueMeshWorkload(cq, tile_workload, false);
+    std::vector<bfloat16> tile_result(M * N);
+    distributed::EnqueueReadMeshBuffer(cq, tile_result, dst_tile_buffer, true);
+    auto untilize_start = clock::now();
+    tile_result = untilize_nfaces(tile_result, M, N);
+    auto end = clock::now();
+    tile_layout_us += us(untilize_start, end);
+    double tile_total_us = us(start, end);
+
+    // row-major: upload -> matmul -> download
+    start = clock::now();
+    distributed::EnqueueWriteMeshBuffer(cq, src0_row_major_buffer, src0_vec, false);
+    distributed::EnqueueWriteMeshBuffer(cq, src1_row_major_buffer, src1_vec, false);
+    distributed::EnqueueMeshWorkload(cq, row_major_workload, false);
+    std::vector<bfloat16> row_major_result(M * N);
+    distributed::EnqueueReadMeshBuffer(cq, row_major_result, dst_row_major_buffer, true);
+    double row_major_total_us = us(start, clock::now());
+
+    fmt::print(
+        " -- tile layout: {:.1f} us total ({:.1f} us host tilize / untilize), row-major I/O: {:.1f} us total --\n",
+        tile_total_us,
+        tile_layout_us,
+        row_major_total_us);
+
+    for (auto& [result_vec, name] :
+         {std::pair{&tile_result, "tile layout"}, std::pair{&row_major_result, "row-major I/O"}}) {
+        float pearson = check_bfloat16_vector_pcc(golden_vec, *result_vec);
+        fmt::print("{} Metalium vs Golden -- PCC = {}\n", name, pearson);
+        if (pearson < 0.99f) {
+            fmt::print("PCC not high enough for {}. Result PCC: {}, Expected PCC: 0.99\n", name, pearson);
+            pass = false;
+        }
+    }
+
+    pass &= mesh_device->close();
+
+    if (pass) {
+        fmt::print("Test Passed!!! - matmul row major\n");
+    } else {
+        TT_THROW("Test Failed");
+    }
+
+    return 0;
+}
@@ -0,0 +1,215 @@
+#include <chrono>
+#include <tt-metalium/host_api.hpp>
+#include <tt-metalium/constants.hpp>
+#include <tt-metalium/bfloat16.hpp>
+#include <tt-metalium/tilize_utils.hpp>
+#include <tt-metalium/device.hpp>
+#include <tt-metalium/tt_metal.hpp>
+#include <tt-metalium/distributed.hpp>
+#include <bmm_op.hpp>
+#include <bmm_reuse_program.hpp>
+#include <fmt/core.h>
+
+using namespace tt::constants;
+using namespace std;
+using namespace tt;
+using namespace tt::tt_metal;
+
+void golden_matmul(
+    std::vector<bfloat16>& a, std::vector<bfloat16>& b, std::vector<bfloat16>& output, uint32_t M, uint32_t N, uint32_t K) {
+    for (uint32_t i = 0; i < M; i++) {
+        for (uint32_t j = 0; j < N; j++) {
+            float c_f = 0;
+            for (uint32_t k = 0; k < K; k++) {
+                c_f += static_cast<float>(a[i * K + k]) * static_cast<float>(b[k * N + j]);
+            }
+            output.at(i * N + j) = bfloat16(c_f);
+        }
+    }
+}
+
+/*
+    L1 sharded operand matmul 예제.
+
+    1. 256 x 256 x 256 을 HEIGHT / WIDTH / BLOCK sharded operand로 돌려 golden과 비교한다.
+       - HEIGHT : core 8개가 output row block을 하나씩 맡는다. A shard가 core의 row block 전체이므로 c_0이 shard를
+                  그대로 쓴다. (IN0_SHARDED)
+       - WIDTH  : core 8개가 output column block을 하나씩 맡는다. B shard가 core의 column block 전체이므로
+                  weight-stationary (IN1_L1_RESIDENT) 로 돌린다.
+       - BLOCK  : 4 x 4 core가 2 x 2 tile output block을 맡는다. A / B는 같은 row / column의 다른 core shard에서 읽는다.
+       output은 모두 core 자신의 shard에 쓴다.
+    2. 두 layer (X * W1 -> Y1, Y1 * W2 -> Y2) 를 이어서 돌릴 때 activation을 DRAM에 두는 경우와 L1 height-sharded
+       로 두는 경우의 시간을 비교한다. sharded 쪽은 Y1이 core 밖으로 나가지 않는다.
+*/
+int main() {
+    bool pass = true;
+
+    constexpr int device_id = 0;
+    std::shared_ptr<distributed::MeshDevice> mesh_device = distributed::MeshDevice::create_unit_mesh(device_id);
+    distributed::MeshCommandQueue& cq = mesh_device->mesh_command_queue();
+    distributed::MeshCoordinateRange device_range = distributed::MeshCoordinateRange(mesh_device->shape());
+
+    tt::DataFormat cb_data_format = tt::DataFormat::Float16_b;
+    uint32_t single_tile_size = tt::tile_size(cb_data_format);
+    auto grid = mesh_device->compute_with_storage_grid_size();
+
+    distributed::DeviceLocalBufferConfig dram_config{
+        .page_size = single_tile_size, .buffer_type = tt_metal::BufferType::DRAM};
+    auto create_dram_buffer = [&](uint32_t rows_tiles, uint32_t cols_tiles) {
+        distributed::ReplicatedBufferConfig buffer_config{.size = single_tile_size * rows_tiles * cols_tiles};
+        return distributed::MeshBuffer::create(buffer_config, dram_config, mesh_device.get());
+    };
+    auto create_program = [&](const std::shared_ptr<distributed::MeshBuffer>& src0,
+                              const std::shared_ptr<distributed::MeshBuffer>& src1,
+                              const std::shared_ptr<distributed::MeshBuffer>& dst,
+                              uint32_t Mt,
+                              uint32_t Nt,
+                              uint32_t Kt,
+                              const bmm_op_utils::MatmulBlockConfig& config) {
+        return bmm_op_utils::create_matmul_multicore_reuse_program(
+            src0, src1, dst, Mt, Nt, Kt, 1, false, config, cb_data_format, MathFidelity::HiFi4, grid);
+    };
+    auto check_pcc = [&](std::vector<bfloat16>& golden_vec, std::vector<bfloat16>& result_vec, const char* name) {
+        float pearson = check_bfloat16_vector_pcc(golden_vec, result_vec);
+        fmt::print("{} Metalium vs Golden -- PCC = {}\n", name, pearson);
+        if (pearson < 0.99f) {
+            fmt::print("PCC not high enough for {}. Result PCC: {}, Expected PCC: 0.99\n", name, pearson);
+            pass = false;
+        }
+    };
+
+    // 1. layout별 single matmul
+    {
+        constexpr uint32_t M = 256;  // user-defined
+        constexpr uint32_t N = 256;  // user-defined
+        constexpr uint32_t K = 256;  // user-defined
+        uint32_t Mt = M / TILE_HEIGHT;
+        uint32_t Kt = K / TILE_WIDTH;
+        uint32_t Nt = N / TILE_WIDTH;
+
+        std::vector<bfloat16> src0_vec =
+            create_random_vector_of_bfloat16_native(M * K * sizeof(bfloat16), 1, 123, -0.5);
+        std::vector<bfloat16> src1_vec =
+            create_random_vector_of_bfloat16_native(K * N * sizeof(bfloat16), 1, 12522, -0.5);
+        std::vector<bfloat16> golden_vec(M * N, 0);
+        golden_matmul(src0_vec, src1_vec, golden_vec, M, N, K);
+
+        struct ShardCase {
+            TensorMemoryLayout layout;
+            bmm_op_utils::MatmulBlockConfig config;
+            const char* name;
+        };
+        std::vector<ShardCase> cases = {
+            {TensorMemoryLayout::HEIGHT_SHARDED, {1, Nt, 2, 1, Nt}, "height sharded"},
+            {TensorMemoryLayout::WIDTH_SHARDED, {Mt, 1, 2, Mt, 1}, "width sharded"},
+            {TensorMemoryLayout::BLOCK_SHARDED, {2, 2, 2, 2, 2}, "block sharded"},
+        };
+        for (const auto& shard_case : cases) {
+            CoreCoord block_grid = {Nt / shard_case.config.per_core_N, Mt / shard_case.config.per_core_M};
+            auto create_sharded = [&](uint32_t rows_tiles, uint32_t cols_tiles) {
+                return bmm_op_utils::create_matmul_sharded_buffer(
+                    mesh_device.get(), shard_case.layout, rows_tiles, cols_tiles, block_grid, cb_data_format, grid);
+            };
+            auto src0_buffer = create_sharded(Mt, Kt);
+            auto src1_buffer = create_sharded(Kt, Nt);
+            auto dst_buffer = create_sharded(Mt, Nt);
+
+            distributed::EnqueueWriteMeshBuffer(cq, src0_buffer, tilize_nfaces(src0_vec, M, K), false);
+            distributed::EnqueueWriteMeshBuffer(cq, src1_buffer, tilize_nfaces(src1_vec, K, N), false);
+
+            distributed::MeshWorkload workload;
+            workload.add_program(
+                device_range, create_program(src0_buffer, src1_buffer, dst_buffer, Mt, Nt, Kt, shard_case.config));
+            distributed::EnqueueMeshWorkload(cq, workload, false);
+
+            std::vector<bfloat16> result_vec(M * N);
+            distributed::EnqueueReadMeshBuffer(cq, result_vec, dst_buffer, true);
+            result_vec = untilize_nfaces(result_vec, M, N);
+            check_pcc(golden_vec, result_vec, shard_case.name);
+        }
+    }
+
+    // 2. 두 layer chain: DRAM activation vs L1 height-sharded activation
+    {
+        constexpr uint32_t M = 1024;  // user-defined (token 수)
+        constexpr uint32_t D = 256;   // user-defined (hidden)
+        constexpr uint32_t num_iterations = 10;
+        uint32_t Mt = M / TILE_HEIGHT;
+        uint32_t Dt = D / TILE_WIDTH;
+
+        // core 하나가 output row 하나 (1 x Dt tiles) 를 맡으므로 Mt개의 core를 쓴다.
+        bmm_op_utils::MatmulBlockConfig config{1, Dt, 2, 1, Dt};
+        CoreCoord block_grid = {1, Mt};
+
+        std::vector<bfloat16> x_vec = create_random_vector_of_bfloat16_native(M * D * sizeof(bfloat16), 1, 7, -0.5);
+        std::vector<bfloat16> w1_vec = create_random_vector_of_bfloat16_native(D * D * sizeof(bfloat16), 1, 11, -0.5);
+        std::vector<bfloat16> w2_vec = create_random_vector_of_bfloat16_native(D * D * sizeof(bfloat16), 1, 13, -0.5);
+        std::vector<bfloat16> y1_golden(M * D, 0);
+        std::vector<bfloat16> y2_golden(M * D, 0);
+        golden_matmul(x_vec, w1_vec, y1_golden, M, D, D);
+        golden_matmul(y1_golden, w2_vec, y2_golden, M, D, D);
+
+        // weight는 두 경우 모두 DRAM interleaved
+        auto w1_buffer = create_dram_buffer(Dt, Dt);
+        auto w2_buffer = create_dram_buffer(Dt, Dt);
+        distributed::EnqueueWriteMeshBuffer(cq, w1_buffer, tilize_nfaces(w1_vec, D, D), false);
+        distributed::EnqueueWriteMeshBuffer(cq, w2_buffer, tilize_nfaces(w2_vec, D, D), false);
+
+        auto create_sharded = [&]() {
+            return bmm_op_utils::create_matmul_sharded_buffer(
+                mesh_device.get(), TensorMemoryLayout::HEIGHT_SHARDED, Mt, Dt, block_grid, cb_data_format, grid);
+        };
+        std::vector<std::pair<std::vector<std::shared_ptr<distributed::MeshBuffer>>, const char*>> chains = {
+            {{create_dram_buffer(Mt, Dt), create_dram_buffer(Mt, Dt), create_dram_buffer(Mt, Dt)}, "DRAM chain"},
+            {{create_sharded(), create_sharded(), create_sharded()}, "L1 sharded chain"},
+        };
+
+        std::vector<double> elapsed_us;
+        for (auto& [activations, name] : chains) {
+            distributed::EnqueueWriteMeshBuffer(cq, activations[0], tilize_nfaces(x_vec, M, D), false);
+
+            distributed::MeshWorkload layer1;
+            layer1.add_program(
+                device_range, create_program(activations[0], w1_buffer, activations[1], Mt, Dt, Dt, config));
+            distributed::MeshWorkload layer2;
+            layer2.add_program(
+                device_range, create_program(activations[1], w2_buffer, activations[2], Mt, Dt, Dt, config));
+
+            // 첫 launch는 kernel compile 시간이 들어가므로 한 번 먼저 돌린다.
+            distributed::EnqueueMeshWorkload(cq, layer1, false);
+            distributed::EnqueueMeshWorkload(cq, layer2, false);
+            distributed::Finish(cq);
+
+            auto start = std::chrono::high_resolution_clock::now();
+            for (uint32_t i = 0; i < num_iterations; i++) {
+                distributed::EnqueueMeshWorkload(cq, layer1, false);
+                distributed::EnqueueMeshWorkload(cq, layer2, false);
+            }
+            distributed::Finish(cq);
+            auto end = std::chrono::high_resolution_clock::now();
+            elapsed_us.push_back(std::chrono::duration<double, std::micro>(end - start).count() / num_iterations);
+
+            std::vector<bfloat16> result_vec(M * D);
+            distributed::EnqueueReadMeshBuffer(cq, result_vec, activations[2], true);
+            result_vec = untilize_nfaces(result_vec, M, D);
+            check_pcc(y2_golden, result_vec, name);
+        }
+        fmt::print(
+            " -- 2 layers ({}x{}x{}): DRAM {:.1f} us, L1 sharded {:.1f} us per iteration --\n",
+            M,
+            D,
+            D,
+            elapsed_us[0],
+            elapsed_us[1]);
+    }
+
+    pass &= mesh_device->close();
+
+    if (pass) {
+        fmt::print("Test Passed!!! - matmul sharded\n");
+    } else {
+        TT_THROW("Test Failed");
+    }
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include <cstdint>
+#include "compute_kernel_api/tile_move_copy.h"
+#include "compute_kernel_api/matmul.h"
+#include "compute_kernel_api/eltwise_binary.h"
+#include "compute_kernel_api/pack.h"
+#include "compute_kernel_api/reconfig_data_format.h"
+
+using std::uint32_t;
+
+namespace NAMESPACE {
+/*
+    split-K compute.
+
+    1. 맡은 output tile마다 K 구간 (k_count tiles) 의 partial sum을 fp32 dst에 누적해서 c_24 (Float32) 로 pack 한다.
+    2. tree reduction의 level 마다 child에게 받은 partial (c_2) 을 자기 partial (c_24) 에 더한다.
+       c_24를 FIFO로 쓰므로 (앞에서 꺼내 더하고 뒤에 넣음) tile 순서는 그대로 유지된다.
+    3. 마지막 결과는 root면 c_16 (bf16, writer가 DRAM에 씀), 아니면 c_17 (fp32, writer가 parent로 보냄) 으로 pack 한다.
+*/
+void MAIN {
+    uint32_t num_tiles = get_arg_val<uint32_t>(0);
+    uint32_t k_count = get_arg_val<uint32_t>(1);
+    uint32_t num_receives = get_arg_val<uint32_t>(2);
+    uint32_t is_root = get_arg_val<uint32_t>(3);
+
+    constexpr auto cb_in0 = tt::CBIndex::c_0;
+    constexpr auto cb_in1 = tt::CBIndex::c_1;
+    constexpr auto cb_partner = tt::CBIndex::c_2;
+    constexpr auto cb_out = tt::CBIndex::c_16;
+    constexpr auto cb_send = tt::CBIndex::c_17;
+    constexpr auto cb_partial = tt::CBIndex::c_24;
+
+    const auto cb_final = is_root ? cb_out : cb_send;
+
+    // 1. 이 core의 K 구간 partial sum
+    const auto cb_mm_out = num_receives == 0 ? cb_final : cb_partial;
+    mm_init(cb_in0, cb_in1, cb_mm_out);
+    for (uint32_t t = 0; t < num_tiles; t++) {
+        tile_regs_acquire();
+        for (uint32_t k = 0; k < k_count; k++) {
+            cb_wait_front(cb_in0, 1);
+            cb_wait_front(cb_in1, 1);
+            matmul_tiles(cb_in0, cb_in1, 0, 0, 0, false);
+            cb_pop_front(cb_in0, 1);
+            cb_pop_front(cb_in1, 1);
+        }
+        tile_regs_commit();
+        tile_regs_wait();
+
+        cb_reserve_back(cb_mm_out, 1);
+        pack_tile(0, cb_mm_out);
+        cb_push_back(cb_mm_out, 1);
+        tile_regs_release();
+    }
+
+    // 2. tree reduction
+    if (num_receives > 0) {
+        reconfig_data_format(cb_partial, cb_partner);
+        add_tiles_init(cb_partial, cb_partner);
+    }
+    for (uint32_t level = 0; level < num_receives; level++) {
+        const auto cb_add_out = level == num_receives - 1 ? cb_final : cb_partial;
+        pack_reconfig_data_format(cb_add_out);
+
+        for (uint32_t t = 0; t < num_tiles; t++) {
+            cb_wait_front(cb_partial, 1);
+            cb_wait_front(cb_partner, 1);
+
+            tile_regs_acquire();
+            add_tiles(cb_partial, cb_partner, 0, 0, 0);
+            // c_24 가 가득 차 있으므로 먼저 pop 해야 결과를 다시 넣을 수 있다.
+            cb_pop_front(cb_partial, 1);
+            cb_pop_front(cb_partner, 1);
+            tile_regs_commit();
+            tile_regs_wait();
+
+            cb_reserve_back(cb_add_out, 1);
+            pack_tile(0, cb_add_out);
+            cb_push_back(cb_add_out, 1);
+            tile_regs_release();
+        }
+    }
+}
+}  // namespace NAMESPACE
@@ -0,0 +1,69 @@
+#include <stdint.h>
+#include "dataflow_api.h"
+
+/*
+    split-K reader.
+
+    1. 이 core가 맡은 output tile (out_start 부터 num_tiles 개) 마다 K 구간 [k_start, k_start + k_count) 의
+       A, B tile을 c_0, c_1 으로 읽는다.
+    2. tree reduction에서 받는 쪽이면 level 마다 child core의 partial sum (fp32, num_tiles 개) 을 c_2 로 받는다.
+       noc_tile_transfer 와 같은 방식: c_2 공간을 잡은 뒤 child의 ready semaphore를 올리고,
+       child가 데이터를 쓰고 done semaphore를 올릴 때까지 기다린다.
+*/
+void kernel_main() {
+    uint32_t src0_addr = get_arg_val<uint32_t>(0);
+    uint32_t src1_addr = get_arg_val<uint32_t>(1);
+    uint32_t Mt = get_arg_val<uint32_t>(2);
+    uint32_t Kt = get_arg_val<uint32_t>(3);
+    uint32_t Nt = get_arg_val<uint32_t>(4);
+    uint32_t out_start = get_arg_val<uint32_t>(5);
+    uint32_t num_tiles = get_arg_val<uint32_t>(6);
+    uint32_t k_start = get_arg_val<uint32_t>(7);
+    uint32_t k_count = get_arg_val<uint32_t>(8);
+    uint32_t ready_semaphore = get_semaphore(get_arg_val<uint32_t>(9));
+    uint32_t done_semaphore = get_semaphore(get_arg_val<uint32_t>(10));
+    uint32_t num_receives = get_arg_val<uint32_t>(11);
+    // arg 12 + 2 * i, 13 + 2 * i: level i 에서 partial을 보내는 child core의 physical 좌표
+
+    constexpr uint32_t cb_id_in0 = tt::CBIndex::c_0;
+    constexpr uint32_t cb_id_in1 = tt::CBIndex::c_1;
+    constexpr uint32_t cb_id_partner = tt::CBIndex::c_2;
+
+    const uint32_t in0_tile_bytes = get_tile_size(cb_id_in0);
+    const uint32_t in1_tile_bytes = get_tile_size(cb_id_in1);
+
+    constexpr auto a_args = TensorAccessorArgs<0>();
+    const auto a = TensorAccessor(a_args, src0_addr, in0_tile_bytes);
+    constexpr auto b_args = TensorAccessorArgs<a_args.next_compile_time_args_offset()>();
+    const auto b = TensorAccessor(b_args, src1_addr, in1_tile_bytes);
+
+    for (uint32_t t = 0; t < num_tiles; t++) {
+        uint32_t out_row = (out_start + t) / Nt;
+        uint32_t out_col = (out_start + t) % Nt;
+
+        for (uint32_t k = k_start; k < k_start + k_count; k++) {
+            cb_reserve_back(cb_id_in0, 1);
+            cb_reserve_back(cb_id_in1, 1);
+            noc_async_read_tile(out_row * Kt + k, a, get_write_ptr(cb_id_in0));
+            noc_async_read_tile(k * Nt + out_col, b, get_write_ptr(cb_id_in1));
+            noc_async_read_barrier();
+            cb_push_back(cb_id_in0, 1);
+            cb_push_back(cb_id_in1, 1);
+        }
+    }
+
+    volatile tt_l1_ptr uint32_t* done_sem_ptr = reinterpret_cast<volatile tt_l1_ptr uint32_t*>(done_semaphore);
+    for (uint32_t level = 0; level < num_receives; level++) {
+        uint32_t child_x = get_arg_val<uint32_t>(12 + 2 * level);
+        uint32_t child_y = get_arg_val<uint32_t>(13 + 2 * level);
+
+        // compute가 이전 level의 partial을 다 쓸 때까지 기다린 뒤 child에게 준비됐다고 알린다.
+        cb_reserve_back(cb_id_partner, num_tiles);
+        noc_semaphore_inc(get_noc_addr(child_x, child_y, ready_semaphore), 1);
+        noc_async_atomic_barrier();
+
+        noc_semaphore_wait(done_sem_ptr, 1);
+        noc_semaphore_set(done_sem_ptr, 0);
+        cb_push_back(cb_id_partner, num_tiles);
+    }
+}
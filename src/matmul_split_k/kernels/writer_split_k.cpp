@@ -0,0 +1,59 @@
+#include <stdint.h>
+#include "dataflow_api.h"
+
+/*
+    split-K writer.
+
+    - root core (K 구간 0번): reduction이 끝난 bf16 output tile (c_16) 을 DRAM에 쓴다.
+    - 그 외: 최종 partial sum (fp32, c_17) 을 parent core의 c_2 로 NoC write 한다.
+      parent의 reader가 ready semaphore를 올려야 (c_2 공간 확보) 쓰기 시작하고, 다 쓰면 parent의 done semaphore를 올린다.
+
+    c_2는 모든 core에서 크기가 num_tiles 이고 level 마다 num_tiles 개씩 push / pop 되므로,
+    parent가 reserve 할 때 c_2 write pointer는 항상 CB 시작 주소이다. 같은 program의 CB는 모든 core에서
+    같은 L1 주소에 있으므로 자기 c_2 시작 주소를 parent 쪽 주소로 그대로 쓴다.
+*/
+void kernel_main() {
+    uint32_t dst_addr = get_arg_val<uint32_t>(0);
+    uint32_t out_start = get_arg_val<uint32_t>(1);
+    uint32_t num_tiles = get_arg_val<uint32_t>(2);
+    uint32_t is_root = get_arg_val<uint32_t>(3);
+    uint32_t parent_x = get_arg_val<uint32_t>(4);
+    uint32_t parent_y = get_arg_val<uint32_t>(5);
+    uint32_t ready_semaphore = get_semaphore(get_arg_val<uint32_t>(6));
+    uint32_t done_semaphore = get_semaphore(get_arg_val<uint32_t>(7));
+
+    constexpr uint32_t cb_id_out = tt::CBIndex::c_16;
+    constexpr uint32_t cb_id_partner = tt::CBIndex::c_2;
+    constexpr uint32_t cb_id_send = tt::CBIndex::c_17;
+
+    if (is_root) {
+        const uint32_t tile_bytes = get_tile_size(cb_id_out);
+        constexpr auto c_args = TensorAccessorArgs<0>();
+        const auto c = TensorAccessor(c_args, dst_addr, tile_bytes);
+
+        for (uint32_t t = 0; t < num_tiles; t++) {
+            cb_wait_front(cb_id_out, 1);
+            noc_async_write_tile(out_start + t, c, get_read_ptr(cb_id_out));
+            noc_async_write_barrier();
+            cb_pop_front(cb_id_out, 1);
+        }
+        return;
+    }
+
+    const uint32_t partial_bytes = get_tile_size(cb_id_send) * num_tiles;
+    volatile tt_l1_ptr uint32_t* ready_sem_ptr = reinterpret_cast<volatile tt_l1_ptr uint32_t*>(ready_semaphore);
+
+    cb_wait_front(cb_id_send, num_tiles);
+
+    noc_semaphore_wait(ready_sem_ptr, 1);
+    noc_semaphore_set(ready_sem_ptr, 0);
+
+    uint64_t parent_partner_addr = get_noc_addr(parent_x, parent_y, get_write_ptr(cb_id_partner));
+    noc_async_write(get_read_ptr(cb_id_send), parent_partner_addr, partial_bytes);
+    noc_async_write_barrier();
+
+    noc_semaphore_inc(get_noc_addr(parent_x, parent_y, done_semaphore), 1);
+    noc_async_atomic_barrier();
+
+    cb_pop_front(cb_id_send, num_tiles);
+}
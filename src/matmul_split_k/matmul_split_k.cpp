@@ -0,0 +1,313 @@
+#include <tt-metalium/host_api.hpp>
+#include <tt-metalium/constants.hpp>
+#include <tt-metalium/bfloat16.hpp>
+#include <tt-metalium/tilize_utils.hpp>
+#include <tt-metalium/distributed.hpp>
+#include <tt-metalium/tensor_accessor_args.hpp>
+#include <tt-metalium/device.hpp>
+#include <bmm_op.hpp>
+#include <fmt/core.h>
+
+using namespace tt::constants;
+using namespace std;
+using namespace tt;
+using namespace tt::tt_metal;
+
+#ifndef OVERRIDE_KERNEL_PREFIX
+#define OVERRIDE_KERNEL_PREFIX ""
+#endif
+
+void golden_matmul(
+    std::vector<bfloat16>& a, std::vector<bfloat16>& b, std::vector<bfloat16>& output, uint32_t M, uint32_t N, uint32_t K) {
+    for (uint32_t i = 0; i < M; i++) {
+        for (uint32_t j = 0; j < N; j++) {
+            float c_f = 0;
+            for (uint32_t k = 0; k < K; k++) {
+                c_f += static_cast<float>(a[i * K + k]) * static_cast<float>(b[k * N + j]);
+            }
+            output.at(i * N + j) = bfloat16(c_f);
+        }
+    }
+}
+
+struct SplitKConfig {
+    uint32_t tiles_per_group;  // core 하나가 맡는 output tile 수
+    uint32_t num_groups;       // output tile group 수 (= Mt * Nt / tiles_per_group)
+    uint32_t split_k;          // group 하나를 K 방향으로 나누는 core 수 (2의 거듭제곱)
+};
+
+/*
+    output tile 수가 core 수보다 적을 때 남는 core를 K 방향으로 쓴다.
+    tiles_per_group 후보 (Mt * Nt 의 약수, max_tiles_per_group 이하) 마다 split_k 를 grid에 맞게 잡고
+    core 하나의 대략적인 작업량 (matmul tile 수 + reduction add tile 수) 이 가장 작은 것을 고른다.
+*/
+SplitKConfig get_split_k_config(
+    uint32_t Mt, uint32_t Nt, uint32_t Kt, uint32_t num_cores, uint32_t max_tiles_per_group) {
+    uint32_t num_output_tiles = Mt * Nt;
+    SplitKConfig best{0, 0, 0};
+    uint64_t best_cost = UINT64_MAX;
+    for (uint32_t tiles_per_group = 1; tiles_per_group <= std::min(num_output_tiles, max_tiles_per_group);
+         tiles_per_group++) {
+        if (num_output_tiles % tiles_per_group != 0) {
+            continue;
+        }
+        uint32_t num_groups = num_output_tiles / tiles_per_group;
+        if (num_groups > num_cores) {
+            continue;
+        }
+        uint32_t split_k = 1;
+        uint32_t levels = 0;
+        while (split_k * 2 * num_groups <= num_cores && split_k * 2 <= Kt) {
+            split_k *= 2;
+            levels++;
+        }
+        uint64_t cost = (uint64_t)tiles_per_group * ((Kt + split_k - 1) / split_k + levels);
+        if (cost < best_cost) {
+            best_cost = cost;
+            best = {tiles_per_group, num_groups, split_k};
+        }
+    }
+    return best;
+}
+
+/*
+    split-K matmul. matmul_multi_core는 output tile만 나누므로 Mt * Nt 가 작고 K가 큰 (skinny output) 경우
+    grid 대부분이 논다. 여기서는 output tile group 하나를 split_k 개의 core가 K 구간을 나눠 계산하고,
+    각 core의 fp32 partial sum을 NoC로 core끼리 넘기며 tree 형태로 더한다. (noc_tile_transfer 의 semaphore 방식)
+
+        level l (step = 2^l): K 구간 번호 s 가 2 * step 의 배수인 core가 s + step core의 partial을 받아 더한다.
+
+    log2(split_k) level 뒤에 K 구간 0번 (root) core에만 결과가 남고, root만 DRAM에 한 번 쓴다.
+*/
+void matmul_split_k(
+    std::vector<bfloat16>& a,
+    std::vector<bfloat16>& b,
+    std::vector<bfloat16>& output,
+    uint32_t M,
+    uint32_t N,
+    uint32_t K,
+    const std::shared_ptr<distributed::MeshDevice>& mesh_device) {
+    distributed::MeshCommandQueue& cq = mesh_device->mesh_command_queue();
+    distributed::MeshWorkload workload;
+    distributed::MeshCoordinateRange device_range = distributed::MeshCoordinateRange(mesh_device->shape());
+    Program program{};
+
+    const uint32_t Mt = M / TILE_HEIGHT;
+    const uint32_t Kt = K / TILE_WIDTH;
+    const uint32_t Nt = N / TILE_WIDTH;
+
+    auto core_grid = mesh_device->compute_with_storage_grid_size();
+    uint32_t num_cores_x = core_grid.x;
+    uint32_t num_cores_total = core_grid.x * core_grid.y;
+
+    // partial CB 3개 (c_2, c_17, c_24) 가 fp32 tile_per_group 개씩이다.
+    constexpr uint32_t max_tiles_per_group = 16;
+    auto config = get_split_k_config(Mt, Nt, Kt, num_cores_total, max_tiles_per_group);
+    TT_FATAL(config.split_k != 0, "No split-K config for Mt = {}, Nt = {} on {} cores", Mt, Nt, num_cores_total);
+    uint32_t num_cores = config.num_groups * config.split_k;
+
+    fmt::print(
+        " -- split-K: {} groups x {} output tiles, split_k = {}, {} / {} cores --\n",
+        config.num_groups,
+        config.tiles_per_group,
+        config.split_k,
+        num_cores,
+        num_cores_total);
+
+    const auto cb_data_format = tt::DataFormat::Float16_b;
+    const auto partial_data_format = tt::DataFormat::Float32;
+    uint32_t single_tile_size = tt::tile_size(cb_data_format);
+    uint32_t partial_tile_size = tt::tile_size(partial_data_format);
+
+    distributed::DeviceLocalBufferConfig dram_config{
+        .page_size = single_tile_size, .buffer_type = tt_metal::BufferType::DRAM};
+    distributed::ReplicatedBufferConfig buffer_config_A{.size = single_tile_size * Mt * Kt};
+    distributed::ReplicatedBufferConfig buffer_config_B{.size = single_tile_size * Nt * Kt};
+    distributed::ReplicatedBufferConfig buffer_config_C{.size = single_tile_size * Mt * Nt};
+
+    auto src0_dram_buffer = distributed::MeshBuffer::create(buffer_config_A, dram_config, mesh_device.get());
+    auto src1_dram_buffer = distributed::MeshBuffer::create(buffer_config_B, dram_config, mesh_device.get());
+    auto dst_dram_buffer = distributed::MeshBuffer::create(buffer_config_C, dram_config, mesh_device.get());
+
+    CoreRangeSet all_cores(num_cores_to_corerangeset(num_cores, core_grid, true));
+    auto logical_core = [&](uint32_t idx) { return CoreCoord{idx % num_cores_x, idx / num_cores_x}; };
+
+    uint32_t num_input_tiles = 2;
+    tt_metal::CreateCircularBuffer(
+        program,
+        all_cores,
+        CircularBufferConfig(num_input_tiles * single_tile_size, {{CBIndex::c_0, cb_data_format}})
+            .set_page_size(CBIndex::c_0, single_tile_size));
+    tt_metal::CreateCircularBuffer(
+        program,
+        all_cores,
+        CircularBufferConfig(num_input_tiles * single_tile_size, {{CBIndex::c_1, cb_data_format}})
+            .set_page_size(CBIndex::c_1, single_tile_size));
+    tt_metal::CreateCircularBuffer(
+        program,
+        all_cores,
+        CircularBufferConfig(num_input_tiles * single_tile_size, {{CBIndex::c_16, cb_data_format}})
+            .set_page_size(CBIndex::c_16, single_tile_size));
+
+    // fp32 partial sum: c_2 (child에게서 받음), c_17 (parent로 보냄), c_24 (자기 partial)
+    // c_2의 크기는 정확히 tiles_per_group 이어야 한다. (writer_split_k.cpp 참고)
+    for (auto cb_index : {CBIndex::c_2, CBIndex::c_17, CBIndex::c_24}) {
+        tt_metal::CreateCircularBuffer(
+            program,
+            all_cores,
+            CircularBufferConfig(config.tiles_per_group * partial_tile_size, {{cb_index, partial_data_format}})
+                .set_page_size(cb_index, partial_tile_size));
+    }
+
+    // ready: parent reader -> child writer (c_2 공간 확보), done: child writer -> parent reader (partial 전송 완료)
+    uint32_t ready_semaphore_id = CreateSemaphore(program, all_cores, 0);
+    uint32_t done_semaphore_id = CreateSemaphore(program, all_cores, 0);
+
+    std::vector<uint32_t> reader_compile_time_args;
+    TensorAccessorArgs(*src0_dram_buffer).append_to(reader_compile_time_args);
+    TensorAccessorArgs(*src1_dram_buffer).append_to(reader_compile_time_args);
+    auto reader_id = tt_metal::CreateKernel(
+        program,
+        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/matmul_split_k/kernels/reader_split_k.cpp",
+        all_cores,
+        tt_metal::DataMovementConfig{
+            .processor = DataMovementProcessor::RISCV_1,
+            .noc = NOC::RISCV_1_default,
+            .compile_args = reader_compile_time_args});
+
+    std::vector<uint32_t> writer_compile_time_args;
+    TensorAccessorArgs(*dst_dram_buffer).append_to(writer_compile_time_args);
+    auto writer_id = tt_metal::CreateKernel(
+        program,
+        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/matmul_split_k/kernels/writer_split_k.cpp",
+        all_cores,
+        tt_metal::DataMovementConfig{
+            .processor = DataMovementProcessor::RISCV_0,
+            .noc = NOC::RISCV_0_default,
+            .compile_args = writer_compile_time_args});
+
+    // partial을 fp32로 누적하기 위해 fp32 dst를 쓴다.
+    auto compute_id = tt_metal::CreateKernel(
+        program,
+        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/matmul_split_k/kernels/mm_split_k.cpp",
+        all_cores,
+        tt_metal::ComputeConfig{.math_fidelity = MathFidelity::HiFi4, .fp32_dest_acc_en = true});
+
+    uint32_t k_per_split = Kt / config.split_k;
+    uint32_t k_remainder = Kt % config.split_k;
+
+    for (uint32_t group = 0; group < config.num_groups; group++) {
+        uint32_t out_start = group * config.tiles_per_group;
+        uint32_t group_core_base = group * config.split_k;
+        uint32_t k_start = 0;
+
+        for (uint32_t s = 0; s < config.split_k; s++) {
+            CoreCoord core = logical_core(group_core_base + s);
+            uint32_t k_count = k_per_split + (s < k_remainder ? 1 : 0);
+
+            // tree reduction에서 이 core의 역할
+            std::vector<uint32_t> children;
+            uint32_t parent = s;
+            for (uint32_t step = 1; step < config.split_k; step *= 2) {
+                if (s % (2 * step) == 0) {
+                    children.push_back(s + step);
+                } else {
+                    parent = s - step;
+                    break;
+                }
+            }
+            bool is_root = s == 0;
+
+            std::vector<uint32_t> reader_args = {
+                src0_dram_buffer->address(),
+                src1_dram_buffer->address(),
+                Mt,
+                Kt,
+                Nt,
+                out_start,
+                config.tiles_per_group,
+                k_start,
+                k_count,
+                ready_semaphore_id,
+                done_semaphore_id,
+                (uint32_t)children.size()};
+            for (uint32_t child : children) {
+                auto child_physical = mesh_device->worker_core_from_logical_core(logical_core(group_core_base + child));
+                reader_args.push_back(child_physical.x);
+                reader_args.push_back(child_physical.y);
+            }
+
+            auto parent_physical = mesh_device->worker_core_from_logical_core(logical_core(group_core_base + parent));
+
+            tt_metal::SetRuntimeArgs(program, reader_id, core, reader_args);
+            tt_metal::SetRuntimeArgs(
+                program,
+                writer_id,
+                core,
+                {dst_dram_buffer->address(),
+                 out_start,
+                 config.tiles_per_group,
+                 (uint32_t)is_root,
+                 (uint32_t)parent_physical.x,
+                 (uint32_t)parent_physical.y,
+                 ready_semaphore_id,
+                 done_semaphore_id});
+            tt_metal::SetRuntimeArgs(
+                program,
+                compute_id,
+                core,
+                {config.tiles_per_group, k_count, (uint32_t)children.size(), (uint32_t)is_root});
+
+            k_start += k_count;
+        }
+    }
+
+    distributed::EnqueueWriteMeshBuffer(cq, src0_dram_buffer, a, false);
+    distributed::EnqueueWriteMeshBuffer(cq, src1_dram_buffer, b, false);
+    workload.add_program(device_range, std::move(program));
+    distributed::EnqueueMeshWorkload(cq, workload, false);
+    distributed::EnqueueReadMeshBuffer(cq, output, dst_dram_buffer, true);
+}
+
+int main() {
+    bool pass = true;
+
+    constexpr int device_id = 0;
+    std::shared_ptr<distributed::MeshDevice> mesh_device = distributed::MeshDevice::create_unit_mesh(device_id);
+
+    // output은 작고 K가 큰 projection 형태 (user-defined)
+    constexpr uint32_t M = 64;
+    constexpr uint32_t N = 128;
+    constexpr uint32_t K = 8192;
+
+    static_assert(M % TILE_HEIGHT == 0, "M must be divisible by TILE_HEIGHT");
+    static_assert(N % TILE_WIDTH == 0, "N must be divisible by TILE_WIDTH");
+    static_assert(K % TILE_WIDTH == 0, "K must be divisible by TILE_WIDTH");
+
+    std::vector<bfloat16> src0_vec = create_random_vector_of_bfloat16_native(M * K * sizeof(bfloat16), 1, 123, -0.5);
+    std::vector<bfloat16> src1_vec = create_random_vector_of_bfloat16_native(K * N * sizeof(bfloat16), 1, 12522, -0.5);
+
+    std::vector<bfloat16> golden_vec(M * N, 0);
+    golden_matmul(src0_vec, src1_vec, golden_vec, M, N, K);
+
+    src0_vec = tilize_nfaces(src0_vec, M, K);
+    src1_vec = tilize_nfaces(src1_vec, K, N);
+
+    std::vector<bfloat16> result_vec(M * N);
+    matmul_split_k(src0_vec, src1_vec, result_vec, M, N, K, mesh_device);
+    result_vec = untilize_nfaces(result_vec, M, N);
+
+    float pearson = check_bfloat16_vector_pcc(golden_vec, result_vec);
+    fmt::print("Metalium vs Golden -- PCC = {}\n", pearson);
+    TT_FATAL(pearson > 0.99, "PCC not high enough. Result PCC: {}, Expected PCC: 0.99", pearson);
+
+    pass &= mesh_device->close();
+
+    if (pass) {
+        fmt::print("Test Passed!!! - matmul split k\n");
+    } else {
+        TT_THROW("Test Failed");
+    }
+
+    return 0;
+}
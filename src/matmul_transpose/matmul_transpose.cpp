@@ -0,0 +1,147 @@
+#include <tt-metalium/host_api.hpp>
+#include <tt-metalium/constants.hpp>
+#include <tt-metalium/bfloat16.hpp>
+#include <tt-metalium/tilize_utils.hpp>
+#include <tt-metalium/device.hpp>
+#include <tt-metalium/tt_metal.hpp>
+#include <tt-metalium/distributed.hpp>
+#include <bmm_op.hpp>
+#include <bmm_reuse_program.hpp>
+#include <fmt/core.h>
+
+using namespace tt::constants;
+using namespace std;
+using namespace tt;
+using namespace tt::tt_metal;
+
+/*
+    C (M x N) = op(a) * op(b).
+    transpose_a 이면 a 는 K x M 으로 저장되어 있고 op(a) = a^T, transpose_b 이면 b 는 N x K 로 저장되어 있고
+    op(b) = b^T 이다.
+*/
+void golden_matmul_transposed(
+    std::vector<bfloat16>& a,
+    std::vector<bfloat16>& b,
+    std::vector<bfloat16>& output,
+    uint32_t M,
+    uint32_t N,
+    uint32_t K,
+    bool transpose_a,
+    bool transpose_b) {
+    for (uint32_t i = 0; i < M; i++) {
+        for (uint32_t j = 0; j < N; j++) {
+            float c_f = 0;
+            for (uint32_t k = 0; k < K; k++) {
+                float a_ik = static_cast<float>(transpose_a ? a[k * M + i] : a[i * K + k]);
+                float b_kj = static_cast<float>(transpose_b ? b[j * K + k] : b[k * N + j]);
+                c_f += a_ik * b_kj;
+            }
+            output.at(i * N + j) = bfloat16(c_f);
+        }
+    }
+}
+
+/*
+    전치 operand matmul 예제.
+
+    attention의 Q * K^T 는 K가 (seq x head_dim) 으로 저장되어 있고, backward의 dW = X^T * dY 는 X가 (tokens x in)
+    으로 저장되어 있다. host에서 전치하고 다시 tilize 하지 않고, 저장된 그대로 create_matmul_multicore_reuse_program
+    의 transpose_in0 / transpose_in1 로 계산한다.
+*/
+int main() {
+    bool pass = true;
+
+    constexpr int device_id = 0;
+    std::shared_ptr<distributed::MeshDevice> mesh_device = distributed::MeshDevice::create_unit_mesh(device_id);
+    distributed::MeshCommandQueue& cq = mesh_device->mesh_command_queue();
+
+    constexpr uint32_t M = 256;  // user-defined
+    constexpr uint32_t N = 384;  // user-defined
+    constexpr uint32_t K = 512;  // user-defined
+
+    uint32_t Mt = M / TILE_HEIGHT;
+    uint32_t Kt = K / TILE_WIDTH;
+    uint32_t Nt = N / TILE_WIDTH;
+
+    tt::DataFormat cb_data_format = tt::DataFormat::Float16_b;
+    uint32_t single_tile_size = tt::tile_size(cb_data_format);
+    auto grid = mesh_device->compute_with_storage_grid_size();
+
+    uint32_t in0_block_w = 2;
+    auto matmul_params = bmm_op_utils::get_large_matmul_params(Mt, Nt, grid.y, grid.x, in0_block_w);
+    bmm_op_utils::MatmulBlockConfig config{
+        std::get<0>(matmul_params),
+        std::get<1>(matmul_params),
+        in0_block_w,
+        std::get<2>(matmul_params),
+        std::get<3>(matmul_params)};
+    TT_FATAL(config.per_core_M != 0, "No valid core sizing for Mt = {}, Nt = {}", Mt, Nt);
+
+    distributed::DeviceLocalBufferConfig dram_config{
+        .page_size = single_tile_size, .buffer_type = tt_metal::BufferType::DRAM};
+    distributed::ReplicatedBufferConfig buffer_config_A{.size = single_tile_size * Mt * Kt};
+    distributed::ReplicatedBufferConfig buffer_config_B{.size = single_tile_size * Nt * Kt};
+    distributed::ReplicatedBufferConfig buffer_config_C{.size = single_tile_size * Mt * Nt};
+
+    auto src0_dram_buffer = distributed::MeshBuffer::create(buffer_config_A, dram_config, mesh_device.get());
+    auto src1_dram_buffer = distributed::MeshBuffer::create(buffer_config_B, dram_config, mesh_device.get());
+    auto dst_dram_buffer = distributed::MeshBuffer::create(buffer_config_C, dram_config, mesh_device.get());
+
+    // 저장된 모양 그대로 생성한다. (전치 operand는 K x M, N x K)
+    std::vector<bfloat16> src0_vec = create_random_vector_of_bfloat16_native(M * K * sizeof(bfloat16), 1, 123, -0.5);
+    std::vector<bfloat16> src1_vec = create_random_vector_of_bfloat16_native(K * N * sizeof(bfloat16), 1, 12522, -0.5);
+
+    distributed::MeshCoordinateRange device_range = distributed::MeshCoordinateRange(mesh_device->shape());
+    auto run_case = [&](bool transpose_in0, bool transpose_in1, const char* name) {
+        distributed::EnqueueWriteMeshBuffer(
+            cq, src0_dram_buffer, transpose_in0 ? tilize_nfaces(src0_vec, K, M) : tilize_nfaces(src0_vec, M, K), false);
+        distributed::EnqueueWriteMeshBuffer(
+            cq, src1_dram_buffer, transpose_in1 ? tilize_nfaces(src1_vec, N, K) : tilize_nfaces(src1_vec, K, N), false);
+
+        distributed::MeshWorkload workload;
+        workload.add_program(
+            device_range,
+            bmm_op_utils::create_matmul_multicore_reuse_program(
+                src0_dram_buffer,
+                src1_dram_buffer,
+                dst_dram_buffer,
+                Mt,
+                Nt,
+                Kt,
+                1,
+                false,
+                config,
+                cb_data_format,
+                MathFidelity::HiFi4,
+                grid,
+                {.transpose_in0 = transpose_in0, .transpose_in1 = transpose_in1}));
+        distributed::EnqueueMeshWorkload(cq, workload, false);
+
+        std::vector<bfloat16> result_vec(M * N);
+        distributed::EnqueueReadMeshBuffer(cq, result_vec, dst_dram_buffer, true);
+
+        std::vector<bfloat16> golden_vec(M * N, 0);
+        golden_matmul_transposed(src0_vec, src1_vec, golden_vec, M, N, K, transpose_in0, transpose_in1);
+        float pearson = check_bfloat16_vector_pcc(golden_vec, untilize_nfaces(result_vec, M, N));
+        fmt::print("{} Metalium vs Golden -- PCC = {}\n", name, pearson);
+        if (pearson < 0.99f) {
+            fmt::print("PCC not high enough for {}. Result PCC: {}, Expected PCC: 0.99\n", name, pearson);
+            pass = false;
+        }
+    };
+
+    run_case(false, false, "A * B");
+    run_case(false, true, "A * B^T");
+    run_case(true, false, "A^T * B");
+    run_case(true, true, "A^T * B^T");
+
+    pass &= mesh_device->close();
+
+    if (pass) {
+        fmt::print("Test Passed!!! - matmul transpose\n");
+    } else {
+        TT_THROW("Test Failed");
+    }
+
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include <cstdint>
+#include "compute_kernel_api/tile_move_copy.h"
+#include "compute_kernel_api/matmul.h"
+#include "../../modular_common/kernels/mod_sfpu.h"
+
+using std::uint32_t;
+
+namespace NAMESPACE {
+/*
+    matmul_multi_core/kernels/mm.cpp 와 같은 output tile 단위 matmul에 modular epilogue를 붙인 버전.
+
+    Kt 개의 tile 곱을 dst register 0에 누적한 뒤, pack 하기 전에 같은 acquire window 안에서
+    Barrett reduction (SFPU)을 해서 C mod q 만 CB로 내보낸다.
+    따라서 reduce 되지 않은 32-bit 부분합은 DRAM에 쓰이지 않는다.
+*/
+void MAIN {
+    constexpr uint32_t q_bits = get_compile_time_arg_val(0);
+
+    uint32_t num_output_tiles = get_arg_val<uint32_t>(0);  // number of output tiles to produce
+    uint32_t Kt = get_arg_val<uint32_t>(1);                // number of tiles in K dimension for dot product
+    uint32_t q = get_arg_val<uint32_t>(2);
+    uint32_t mu = get_arg_val<uint32_t>(3);
+
+    constexpr tt::CBIndex cb_in0 = tt::CBIndex::c_0;
+    constexpr tt::CBIndex cb_in1 = tt::CBIndex::c_1;
+    constexpr tt::CBIndex cb_out = tt::CBIndex::c_16;
+
+    mm_init(cb_in0, cb_in1, cb_out);
+
+    for (uint32_t i = 0; i < num_output_tiles; ++i) {
+        tile_regs_acquire();
+
+        // epilogue에서 SFPU 설정으로 바뀐 math 설정을 matmul로 되돌린다.
+        mm_init_short(cb_in0, cb_in1);
+        for (uint32_t kt = 0; kt < Kt; kt++) {
+            cb_wait_front(cb_in0, 1);
+            cb_wait_front(cb_in1, 1);
+
+            matmul_tiles(cb_in0, cb_in1, 0, 0, 0, false);
+
+            cb_pop_front(cb_in0, 1);
+            cb_pop_front(cb_in1, 1);
+        }
+
+        // epilogue: dst register 0: 누적된 uint32 dot product, 1 ~ 6: scratch
+        barrett_reduce32_tile<q_bits>(0, 1, 2, 3, 4, 5, 6, q, mu);
+
+        tile_regs_commit();
+        tile_regs_wait();
+
+        cb_reserve_back(cb_out, 1);
+        pack_tile(0, cb_out);
+        cb_push_back(cb_out, 1);
+
+        tile_regs_release();
+    }
+}
+}  // namespace NAMESPACE
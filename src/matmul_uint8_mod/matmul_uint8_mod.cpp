@@ -0,0 +1,244 @@
+#include <algorithm>
+#include <random>
+#include <tt-metalium/host_api.hpp>
+#include <tt-metalium/constants.hpp>
+#include <tt-metalium/tilize_utils.hpp>
+#include <tt-metalium/distributed.hpp>
+#include <tt-metalium/work_split.hpp>
+#include <tt-metalium/tensor_accessor_args.hpp>
+#include <tt-metalium/device.hpp>
+#include <mod_op.hpp>
+#include <fmt/core.h>
+
+using namespace tt::constants;
+using namespace std;
+using namespace tt;
+using namespace tt::tt_metal;
+
+#ifndef OVERRIDE_KERNEL_PREFIX
+#define OVERRIDE_KERNEL_PREFIX ""
+#endif
+
+// C = A * B mod q, A: M x K (uint8), B: K x N (uint8)
+void golden_matmul_mod(
+    std::vector<uint8_t>& a,
+    std::vector<uint8_t>& b,
+    std::vector<uint32_t>& output,
+    uint32_t M,
+    uint32_t N,
+    uint32_t K,
+    uint32_t q) {
+    for (uint32_t i = 0; i < M; i++) {
+        for (uint32_t j = 0; j < N; j++) {
+            uint64_t acc = 0;
+            for (uint32_t k = 0; k < K; k++) {
+                acc += static_cast<uint64_t>(a.at(i * K + k)) * b.at(k * N + j);
+            }
+            output.at(i * N + j) = static_cast<uint32_t>(acc % q);
+        }
+    }
+}
+
+/**
+ * @brief Multi-core uint8 matmul with a fused modular epilogue: C = A * B mod q.
+ *
+ * Work is split per output tile (same reader / writer as matmul_multi_core). The compute kernel accumulates the
+ * Kt tile products in dst and reduces the uint32 dot products mod q with SFPU Barrett reduction before
+ * pack_tile, so no separate reduction pass over the output is needed.
+ *
+ * @param q Modulus, 2^15 <= q < 2^29
+ */
+void matmul_uint8_mod(
+    std::vector<uint8_t>& a,
+    std::vector<uint8_t>& b,
+    std::vector<uint32_t>& output,
+    uint32_t M,
+    uint32_t N,
+    uint32_t K,
+    uint32_t q,
+    const std::shared_ptr<distributed::MeshDevice>& mesh_device) {
+    // dst에서는 reduce 전까지 32-bit로 누적되므로 K * 255^2 < 2^32 이어야 한다.
+    TT_FATAL(static_cast<uint64_t>(K) * 255 * 255 <= UINT32_MAX, "K = {} overflows the uint32 accumulator", K);
+
+    distributed::MeshCommandQueue& cq = mesh_device->mesh_command_queue();
+    distributed::MeshWorkload workload;
+    distributed::MeshCoordinateRange device_range = distributed::MeshCoordinateRange(mesh_device->shape());
+    Program program{};
+
+    auto barrett = mod_op_utils::get_barrett_params(q);
+
+    auto core_grid = mesh_device->compute_with_storage_grid_size();
+    auto num_output_tiles_total = (M * N) / TILE_HW;
+    auto [num_cores, all_cores, core_group_1, core_group_2, work_per_core1, work_per_core2] =
+        split_work_to_cores(core_grid, num_output_tiles_total);
+
+    const uint32_t Mt = M / TILE_HEIGHT;
+    const uint32_t Kt = K / TILE_WIDTH;
+    const uint32_t Nt = N / TILE_WIDTH;
+
+    constexpr uint32_t in_tile_size = sizeof(uint8_t) * TILE_HW;
+    constexpr uint32_t out_tile_size = sizeof(uint32_t) * TILE_HW;
+
+    distributed::DeviceLocalBufferConfig in_dram_config{
+        .page_size = in_tile_size, .buffer_type = tt_metal::BufferType::DRAM};
+    distributed::DeviceLocalBufferConfig out_dram_config{
+        .page_size = out_tile_size, .buffer_type = tt_metal::BufferType::DRAM};
+
+    distributed::ReplicatedBufferConfig buffer_config_A{.size = in_tile_size * Mt * Kt};
+    distributed::ReplicatedBufferConfig buffer_config_B{.size = in_tile_size * Kt * Nt};
+    distributed::ReplicatedBufferConfig buffer_config_C{.size = out_tile_size * Mt * Nt};
+
+    auto src0_dram_buffer = distributed::MeshBuffer::create(buffer_config_A, in_dram_config, mesh_device.get());
+    auto src1_dram_buffer = distributed::MeshBuffer::create(buffer_config_B, in_dram_config, mesh_device.get());
+    auto dst_dram_buffer = distributed::MeshBuffer::create(buffer_config_C, out_dram_config, mesh_device.get());
+
+    // reader_mm_output_tiles_partitioned 는 K tile을 k_block 개씩 읽고 barrier를 한 번 기다린다.
+    // (matmul_multi_core 와 같이 Kt의 약수 중 8 이하의 가장 큰 값) input CB는 k_block 두 묶음을 담는다.
+    // mm_mod 는 tile 하나씩 pop 하므로 k_block과 무관하다.
+    constexpr uint32_t max_k_block = 8;
+    uint32_t k_block = 1;
+    for (uint32_t kb = std::min(max_k_block, Kt); kb > 0; kb--) {
+        if (Kt % kb == 0) {
+            k_block = kb;
+            break;
+        }
+    }
+    uint32_t num_input_tiles = 2 * k_block;
+    uint32_t num_output_tiles = 2;
+    tt_metal::CreateCircularBuffer(
+        program,
+        all_cores,
+        CircularBufferConfig(num_input_tiles * in_tile_size, {{CBIndex::c_0, tt::DataFormat::UInt8}})
+            .set_page_size(CBIndex::c_0, in_tile_size));
+    tt_metal::CreateCircularBuffer(
+        program,
+        all_cores,
+        CircularBufferConfig(num_input_tiles * in_tile_size, {{CBIndex::c_1, tt::DataFormat::UInt8}})
+            .set_page_size(CBIndex::c_1, in_tile_size));
+    tt_metal::CreateCircularBuffer(
+        program,
+        all_cores,
+        CircularBufferConfig(num_output_tiles * out_tile_size, {{CBIndex::c_16, tt::DataFormat::UInt32}})
+            .set_page_size(CBIndex::c_16, out_tile_size));
+
+    std::vector<uint32_t> reader_compile_time_args;
+    TensorAccessorArgs(*src0_dram_buffer).append_to(reader_compile_time_args);
+    TensorAccessorArgs(*src1_dram_buffer).append_to(reader_compile_time_args);
+    auto reader_id = tt_metal::CreateKernel(
+        program,
+        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/matmul_multi_core/kernels/reader_mm_output_tiles_partitioned.cpp",
+        all_cores,
+        tt_metal::DataMovementConfig{
+            .processor = DataMovementProcessor::RISCV_1,
+            .noc = NOC::RISCV_1_default,
+            .compile_args = reader_compile_time_args});
+
+    std::vector<uint32_t> writer_compile_time_args;
+    TensorAccessorArgs(*dst_dram_buffer).append_to(writer_compile_time_args);
+    auto writer_id = tt_metal::CreateKernel(
+        program,
+        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/matmul_multi_core/kernels/writer_unary_interleaved_start_id.cpp",
+        all_cores,
+        tt_metal::DataMovementConfig{
+            .processor = DataMovementProcessor::RISCV_0,
+            .noc = NOC::RISCV_0_default,
+            .compile_args = writer_compile_time_args});
+
+    // Barrett epilogue는 32-bit dst tile 7개를 쓰므로 fp32 dest + full sync 가 필요하다.
+    auto compute_kernel_id = tt_metal::CreateKernel(
+        program,
+        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/matmul_uint8_mod/kernels/mm_mod.cpp",
+        all_cores,
+        tt_metal::ComputeConfig{
+            .math_fidelity = MathFidelity::HiFi4,
+            .fp32_dest_acc_en = true,
+            .dst_full_sync_en = true,
+            .math_approx_mode = false,
+            .compile_args = {barrett.q_bits}});
+
+    uint32_t work_offset = 0;
+    auto work_groups = {std::make_pair(core_group_1, work_per_core1), std::make_pair(core_group_2, work_per_core2)};
+    for (const auto& [ranges, work_per_core] : work_groups) {
+        for (const auto& range : ranges.ranges()) {
+            for (const auto& core : range) {
+                tt_metal::SetRuntimeArgs(
+                    program,
+                    reader_id,
+                    core,
+                    {src0_dram_buffer->address(),
+                     src1_dram_buffer->address(),
+                     Mt,
+                     Kt,
+                     Nt,
+                     work_offset,
+                     work_per_core,
+                     k_block});
+                tt_metal::SetRuntimeArgs(
+                    program, writer_id, core, {dst_dram_buffer->address(), work_per_core, work_offset});
+                tt_metal::SetRuntimeArgs(
+                    program, compute_kernel_id, core, {work_per_core, Kt, barrett.q, barrett.mu});
+                work_offset += work_per_core;
+            }
+        }
+    }
+
+    distributed::EnqueueWriteMeshBuffer(cq, src0_dram_buffer, a, false);
+    distributed::EnqueueWriteMeshBuffer(cq, src1_dram_buffer, b, false);
+    workload.add_program(device_range, std::move(program));
+    distributed::EnqueueMeshWorkload(cq, workload, false);
+    distributed::EnqueueReadMeshBuffer(cq, output, dst_dram_buffer, true);
+}
+
+int main() {
+    bool pass = true;
+
+    constexpr int device_id = 0;
+    std::shared_ptr<distributed::MeshDevice> mesh_device = distributed::MeshDevice::create_unit_mesh(device_id);
+
+    constexpr uint32_t M = 320;  // user-defined
+    constexpr uint32_t N = 320;  // user-defined
+    constexpr uint32_t K = 640;  // user-defined
+    constexpr uint32_t q = 65537;
+
+    std::random_device rd;
+    std::mt19937 engine(rd());
+    std::uniform_int_distribution<uint32_t> dist(0, 255);
+
+    std::vector<uint8_t> src0_vec(M * K);
+    std::vector<uint8_t> src1_vec(K * N);
+    for (uint8_t& v : src0_vec) {
+        v = dist(engine);
+    }
+    for (uint8_t& v : src1_vec) {
+        v = dist(engine);
+    }
+
+    std::vector<uint32_t> golden(M * N);
+    golden_matmul_mod(src0_vec, src1_vec, golden, M, N, K, q);
+
+    src0_vec = tilize_nfaces(src0_vec, M, K);
+    src1_vec = tilize_nfaces(src1_vec, K, N);
+
+    std::vector<uint32_t> result_vec(M * N);
+    matmul_uint8_mod(src0_vec, src1_vec, result_vec, M, N, K, q, mesh_device);
+    result_vec = untilize_nfaces(result_vec, M, N);
+
+    // 검증
+    for (uint32_t i = 0; i < M * N; i++) {
+        if (golden.at(i) != result_vec.at(i)) {
+            fmt::print("golden and result unmatch at {}, golden = {}, result = {}\n", i, golden.at(i), result_vec.at(i));
+            pass = false;
+            break;
+        }
+    }
+
+    pass &= mesh_device->close();
+
+    if (pass) {
+        fmt::print("Test Passed!! ---- matmul_uint8_mod\n");
+    } else {
+        TT_THROW("Test Failed!!");
+    }
+
+    return 0;
+}
@@ -0,0 +1,252 @@
+#include <random>
+#include <tt-metalium/host_api.hpp>
+#include <tt-metalium/constants.hpp>
+#include <tt-metalium/tilize_utils.hpp>
+#include <tt-metalium/device.hpp>
+#include <tt-metalium/tt_metal.hpp>
+#include <tt-metalium/tensor_accessor_args.hpp>
+#include <tt-metalium/distributed.hpp>
+#include <bmm_op.hpp>
+#include <bmm_reuse_program.hpp>
+#include <mod_op.hpp>
+#include <fmt/core.h>
+
+using namespace tt::constants;
+using namespace std;
+using namespace tt;
+using namespace tt::tt_metal;
+
+// C = A * B (q = 0) 또는 C = A * B mod q. is_signed 이면 입력은 int8 (2의 보수), 출력은 int32의 bit pattern 이다.
+void golden_matmul_int(
+    std::vector<uint8_t>& a,
+    std::vector<uint8_t>& b,
+    std::vector<uint32_t>& output,
+    uint32_t M,
+    uint32_t N,
+    uint32_t K,
+    bool is_signed,
+    uint32_t q) {
+    for (uint32_t i = 0; i < M; i++) {
+        for (uint32_t j = 0; j < N; j++) {
+            int64_t acc = 0;
+            for (uint32_t k = 0; k < K; k++) {
+                int64_t x = is_signed ? static_cast<int8_t>(a.at(i * K + k)) : a.at(i * K + k);
+                int64_t y = is_signed ? static_cast<int8_t>(b.at(k * N + j)) : b.at(k * N + j);
+                acc += x * y;
+            }
+            if (q != 0) {
+                acc %= q;
+            }
+            output.at(i * N + j) = static_cast<uint32_t>(acc);
+        }
+    }
+}
+
+/*
+    Tenstorrent의 Int8 형식은 2의 보수가 아니라 sign-magnitude (bit 7 = sign, bit 0..6 = |v|) 이다.
+    host의 int8 (2의 보수) 를 device에 올리기 전에 바꾼다. -128은 표현할 수 없으므로 입력은 [-127, 127] 이어야 한다.
+*/
+inline std::vector<uint8_t> encode_int8_sign_magnitude(const std::vector<uint8_t>& twos_complement) {
+    std::vector<uint8_t> encoded(twos_complement.size());
+    for (size_t i = 0; i < twos_complement.size(); i++) {
+        int8_t v = static_cast<int8_t>(twos_complement[i]);
+        TT_FATAL(v != INT8_MIN, "-128 has no Int8 (sign-magnitude) encoding");
+        encoded[i] = v < 0 ? static_cast<uint8_t>(0x80 | -v) : static_cast<uint8_t>(v);
+    }
+    return encoded;
+}
+
+/*
+    matmul_multicore_reuse 와 같은 block / sub-block 방식의 integer matmul.
+    입력은 UInt8 (또는 Int8, encode_int8_sign_magnitude 로 바꾼 tile), 출력과 partial (c_24)은 UInt32 (또는 Int32) 이다.
+    M, N, K는 32의 배수여야 한다.
+
+    program은 create_matmul_multicore_reuse_program 으로 만든다. interm 이 32-bit integer 이므로 builder가
+    fp32_dest_acc_en 으로 돌리고 c_24 partial을 dst로 바로 unpack (UnpackToDestFp32) 한다. 그래서 K block 사이에서
+    누적값이 srcA (19-bit) 를 거치며 잘리지 않는다. dst에 올릴 수 있는 tile이 절반(4개)이 되므로
+    get_large_matmul_params에 max_subblock_num_tiles = 4 를 넘긴다.
+    q != 0 이면 bmm_large_block_zm의 MOD_EPILOGUE로 pack 직전에 Barrett reduction을 한다.
+    (epilogue가 dst tile 7개를 쓰므로 sub-block은 1 tile, dst_full_sync_en = true)
+*/
+void matmul_uint8_multicore_reuse(
+    std::vector<uint8_t>& a,
+    std::vector<uint8_t>& b,
+    std::vector<uint32_t>& output,
+    uint32_t M,
+    uint32_t N,
+    uint32_t K,
+    bool is_signed,
+    uint32_t q,
+    const std::shared_ptr<distributed::MeshDevice>& mesh_device) {
+    TT_FATAL(!(is_signed && q != 0), "The modular epilogue only supports unsigned inputs");
+    // dst에서 32-bit로 누적되므로 K * 255^2 < 2^32 이어야 한다.
+    TT_FATAL(static_cast<uint64_t>(K) * 255 * 255 <= UINT32_MAX, "K = {} overflows the 32-bit accumulator", K);
+
+    distributed::MeshCommandQueue& cq = mesh_device->mesh_command_queue();
+    distributed::MeshWorkload workload;
+    distributed::MeshCoordinateRange device_range = distributed::MeshCoordinateRange(mesh_device->shape());
+
+    tt::DataFormat in_data_format = is_signed ? tt::DataFormat::Int8 : tt::DataFormat::UInt8;
+    tt::DataFormat out_data_format = is_signed ? tt::DataFormat::Int32 : tt::DataFormat::UInt32;
+    bmm_op_utils::MatmulDataFormats data_formats(in_data_format, in_data_format, out_data_format);
+    uint32_t in_single_tile_size = tt::tile_size(in_data_format);
+    uint32_t out_single_tile_size = tt::tile_size(out_data_format);
+
+    auto compute_with_storage_grid_size = mesh_device->compute_with_storage_grid_size();
+
+    TT_FATAL(
+        M % TILE_HEIGHT == 0 && N % TILE_WIDTH == 0 && K % TILE_WIDTH == 0,
+        "M = {}, N = {}, K = {} must be multiples of the tile size",
+        M,
+        N,
+        K);
+    uint32_t Mt = M / TILE_HEIGHT;
+    uint32_t Kt = K / TILE_WIDTH;
+    uint32_t Nt = N / TILE_WIDTH;
+
+    uint32_t in0_block_w = Kt % 2 == 0 ? 2 : 1;
+    uint32_t max_subblock_num_tiles = q != 0 ? 1 : data_formats.max_subblock_num_tiles();
+
+    // uint8 입력 tile은 1KB, 32-bit 출력 tile은 4KB 이므로 bf16 기준 tile 개수로는 L1을 맞출 수 없다.
+    auto l1_budget = get_matmul_l1_budget(
+        mesh_device.get(), in_data_format, in_data_format, out_data_format, out_data_format);
+    auto matmul_params = bmm_op_utils::get_large_matmul_params(
+        Mt,
+        Nt,
+        compute_with_storage_grid_size.y,
+        compute_with_storage_grid_size.x,
+        in0_block_w,
+        max_subblock_num_tiles,
+        l1_budget);
+    bmm_op_utils::MatmulBlockConfig config{
+        std::get<0>(matmul_params),
+        std::get<1>(matmul_params),
+        in0_block_w,
+        std::get<2>(matmul_params),
+        std::get<3>(matmul_params)};
+
+    fmt::print(" -- Metalium Core Sizing --\n");
+    fmt::print(
+        " -- per_core_M= {} -- per_core_N= {} -- out_subblock_h= {} -- out_subblock_w= {} --\n",
+        config.per_core_M,
+        config.per_core_N,
+        config.out_subblock_h,
+        config.out_subblock_w);
+
+    TT_FATAL(config.per_core_M != 0 && config.per_core_N != 0, "No valid core sizing for Mt = {}, Nt = {}", Mt, Nt);
+
+    bmm_op_utils::MatmulEpilogue epilogue{};
+    if (q != 0) {
+        auto barrett = mod_op_utils::get_barrett_params(q);
+        epilogue.mod = {barrett.q, barrett.q_bits, barrett.mu};
+    }
+
+    distributed::DeviceLocalBufferConfig in_dram_config{
+        .page_size = in_single_tile_size, .buffer_type = tt_metal::BufferType::DRAM};
+    distributed::DeviceLocalBufferConfig out_dram_config{
+        .page_size = out_single_tile_size, .buffer_type = tt_metal::BufferType::DRAM};
+
+    distributed::ReplicatedBufferConfig buffer_config_A{.size = in_single_tile_size * Mt * Kt};
+    distributed::ReplicatedBufferConfig buffer_config_B{.size = in_single_tile_size * Nt * Kt};
+    distributed::ReplicatedBufferConfig buffer_config_C{.size = out_single_tile_size * Mt * Nt};
+
+    auto src0_dram_buffer = distributed::MeshBuffer::create(buffer_config_A, in_dram_config, mesh_device.get());
+    auto src1_dram_buffer = distributed::MeshBuffer::create(buffer_config_B, in_dram_config, mesh_device.get());
+    auto dst_dram_buffer = distributed::MeshBuffer::create(buffer_config_C, out_dram_config, mesh_device.get());
+
+    distributed::EnqueueWriteMeshBuffer(cq, src0_dram_buffer, a, false);
+    distributed::EnqueueWriteMeshBuffer(cq, src1_dram_buffer, b, false);
+    workload.add_program(
+        device_range,
+        bmm_op_utils::create_matmul_multicore_reuse_program(
+            src0_dram_buffer,
+            src1_dram_buffer,
+            dst_dram_buffer,
+            Mt,
+            Nt,
+            Kt,
+            1,
+            false,
+            config,
+            data_formats,
+            MathFidelity::HiFi4,
+            compute_with_storage_grid_size,
+            {.epilogue = epilogue}));
+    distributed::EnqueueMeshWorkload(cq, workload, false);
+    distributed::EnqueueReadMeshBuffer(cq, output, dst_dram_buffer, true);
+}
+
+int main() {
+    bool pass = true;
+
+    constexpr int device_id = 0;
+    std::shared_ptr<distributed::MeshDevice> mesh_device = distributed::MeshDevice::create_unit_mesh(device_id);
+
+    constexpr uint32_t M = 640;  // user-defined
+    constexpr uint32_t N = 640;  // user-defined
+    constexpr uint32_t K = 640;  // user-defined
+
+    std::random_device rd;
+    std::mt19937 engine(rd());
+    std::uniform_int_distribution<uint32_t> unsigned_dist(0, 255);
+    std::uniform_int_distribution<int32_t> signed_dist(-127, 127);  // -128은 Int8로 표현할 수 없다.
+
+    // uint8 입력과 int8 입력 (2의 보수 byte)
+    std::vector<uint8_t> src0_u8(M * K);
+    std::vector<uint8_t> src1_u8(K * N);
+    std::vector<uint8_t> src0_i8(M * K);
+    std::vector<uint8_t> src1_i8(K * N);
+    for (uint8_t& v : src0_u8) {
+        v = unsigned_dist(engine);
+    }
+    for (uint8_t& v : src1_u8) {
+        v = unsigned_dist(engine);
+    }
+    for (uint8_t& v : src0_i8) {
+        v = static_cast<uint8_t>(signed_dist(engine));
+    }
+    for (uint8_t& v : src1_i8) {
+        v = static_cast<uint8_t>(signed_dist(engine));
+    }
+
+    // (is_signed, q): uint8 -> uint32, int8 -> int32, uint8 -> uint32 mod q
+    const std::vector<std::pair<bool, uint32_t>> cases = {{false, 0}, {true, 0}, {false, 65537}};
+
+    for (const auto& [is_signed, q] : cases) {
+        auto& src0_vec = is_signed ? src0_i8 : src0_u8;
+        auto& src1_vec = is_signed ? src1_i8 : src1_u8;
+        std::vector<uint32_t> golden(M * N);
+        golden_matmul_int(src0_vec, src1_vec, golden, M, N, K, is_signed, q);
+
+        auto src0_tilized = tilize_nfaces(is_signed ? encode_int8_sign_magnitude(src0_vec) : src0_vec, M, K);
+        auto src1_tilized = tilize_nfaces(is_signed ? encode_int8_sign_magnitude(src1_vec) : src1_vec, K, N);
+        std::vector<uint32_t> result_vec(M * N);
+        matmul_uint8_multicore_reuse(src0_tilized, src1_tilized, result_vec, M, N, K, is_signed, q, mesh_device);
+        result_vec = untilize_nfaces(result_vec, M, N);
+
+        // 검증
+        for (uint32_t i = 0; i < M * N; i++) {
+            if (golden.at(i) != result_vec.at(i)) {
+                fmt::print(
+                    "(signed = {}, q = {}) golden and result unmatch at {}, golden = {}, result = {}\n",
+                    is_signed,
+                    q,
+                    i,
+                    golden.at(i),
+                    result_vec.at(i));
+                pass = false;
+                break;
+            }
+        }
+    }
+
+    pass &= mesh_device->close();
+
+    if (pass) {
+        fmt::print("Test Passed!! ---- matmul_uint8_multicore_reuse\n");
+    } else {
+        TT_THROW("Test Failed!!");
+    }
+
+    return 0;
+}
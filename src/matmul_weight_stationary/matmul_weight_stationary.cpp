@@ -0,0 +1,201 @@
+#include <chrono>
+#include <tt-metalium/host_api.hpp>
+#include <tt-metalium/constants.hpp>
+#include <tt-metalium/bfloat16.hpp>
+#include <tt-metalium/tilize_utils.hpp>
+#include <tt-metalium/device.hpp>
+#include <tt-metalium/tt_metal.hpp>
+#include <tt-metalium/distributed.hpp>
+#include <bmm_op.hpp>
+#include <bmm_reuse_program.hpp>
+#include <fmt/core.h>
+
+using namespace tt::constants;
+using namespace std;
+using namespace tt;
+using namespace tt::tt_metal;
+
+void golden_matmul(
+    std::vector<bfloat16>& a, std::vector<bfloat16>& b, std::vector<bfloat16>& output, uint32_t M, uint32_t N, uint32_t K) {
+    for (uint32_t i = 0; i < M; i++) {
+        for (uint32_t j = 0; j < N; j++) {
+            float c_f = 0;
+            for (uint32_t k = 0; k < K; k++) {
+                c_f += static_cast<float>(a[i * K + k]) * static_cast<float>(b[k * N + j]);
+            }
+            output.at(i * N + j) = bfloat16(c_f);
+        }
+    }
+}
+
+/*
+    decode 처럼 per_core_M = Mt 로 두고 N 방향으로 core를 나눈다. output block 수가 core 수 이하가 되는
+    가장 작은 per_core_N 을 고르므로 core 하나가 들고 있는 B slice (Kt x per_core_N) 도 가장 작다.
+*/
+bmm_op_utils::MatmulBlockConfig get_weight_stationary_config(
+    uint32_t Mt, uint32_t Nt, uint32_t in0_block_w, CoreCoord grid) {
+    uint32_t num_cores = grid.x * grid.y;
+    uint32_t per_core_N = 1;
+    while (Nt % per_core_N != 0 || Nt / per_core_N > num_cores) {
+        per_core_N++;
+    }
+    for (auto& subblock_hw : bmm_op_utils::SUBBLOCK_HW_CHOICES) {
+        auto subblock_h = std::get<0>(subblock_hw);
+        auto subblock_w = std::get<1>(subblock_hw);
+        if (Mt % subblock_h == 0 && per_core_N % subblock_w == 0) {
+            return {Mt, per_core_N, in0_block_w, subblock_h, subblock_w};
+        }
+    }
+    return {};
+}
+
+/*
+    weight-stationary matmul 예제. (decode loop)
+
+    추론에서 B (weight) 는 고정이고 A (activation) 만 매번 바뀐다. 각 core가 쓰는 B slice를 L1 sharded buffer에
+    한 번만 올려 두고, 같은 program을 token 마다 다시 launch 하면서 A만 DRAM에 새로 쓴다.
+    B를 매번 DRAM에서 읽는 matmul_multicore_reuse 방식과 token 당 시간을 비교한다.
+*/
+int main() {
+    bool pass = true;
+
+    constexpr int device_id = 0;
+    std::shared_ptr<distributed::MeshDevice> mesh_device = distributed::MeshDevice::create_unit_mesh(device_id);
+    distributed::MeshCommandQueue& cq = mesh_device->mesh_command_queue();
+
+    constexpr uint32_t M = 64;    // user-defined (batch of tokens)
+    constexpr uint32_t N = 1024;  // user-defined
+    constexpr uint32_t K = 2048;  // user-defined
+    constexpr uint32_t num_tokens = 16;
+
+    uint32_t Mt = M / TILE_HEIGHT;
+    uint32_t Kt = K / TILE_WIDTH;
+    uint32_t Nt = N / TILE_WIDTH;
+
+    tt::DataFormat cb_data_format = tt::DataFormat::Float16_b;
+    uint32_t single_tile_size = tt::tile_size(cb_data_format);
+    auto grid = mesh_device->compute_with_storage_grid_size();
+
+    uint32_t in0_block_w = 4;
+    auto config = get_weight_stationary_config(Mt, Nt, in0_block_w, grid);
+    TT_FATAL(config.per_core_M != 0, "No valid core sizing for Mt = {}, Nt = {}", Mt, Nt);
+
+    // c_1 이 double buffer 대신 B slice 전체를 잡으므로 그만큼 L1을 더 쓴다.
+    auto l1_budget =
+        get_matmul_l1_budget(mesh_device.get(), cb_data_format, cb_data_format, cb_data_format, cb_data_format);
+    uint64_t resident_bytes = l1_budget.block_bytes(config.per_core_M, config.per_core_N, in0_block_w) -
+                              (uint64_t)l1_budget.in_buffering * in0_block_w * config.per_core_N * single_tile_size +
+                              (uint64_t)Kt * config.per_core_N * single_tile_size;
+    TT_FATAL(
+        resident_bytes <= l1_budget.l1_size_bytes,
+        "B slice ({} x {} tiles) does not fit in L1 next to the matmul CBs",
+        Kt,
+        config.per_core_N);
+    fmt::print(
+        " -- per_core_M = {}, per_core_N = {}, resident B slice = {} KB per core --\n",
+        config.per_core_M,
+        config.per_core_N,
+        Kt * config.per_core_N * single_tile_size / 1024);
+
+    distributed::DeviceLocalBufferConfig dram_config{
+        .page_size = single_tile_size, .buffer_type = tt_metal::BufferType::DRAM};
+    distributed::ReplicatedBufferConfig buffer_config_A{.size = single_tile_size * Mt * Kt};
+    distributed::ReplicatedBufferConfig buffer_config_B{.size = single_tile_size * Nt * Kt};
+    distributed::ReplicatedBufferConfig buffer_config_C{.size = single_tile_size * Mt * Nt};
+
+    auto src0_dram_buffer = distributed::MeshBuffer::create(buffer_config_A, dram_config, mesh_device.get());
+    auto src1_dram_buffer = distributed::MeshBuffer::create(buffer_config_B, dram_config, mesh_device.get());
+    auto dst_dram_buffer = distributed::MeshBuffer::create(buffer_config_C, dram_config, mesh_device.get());
+    auto resident_in1_buffer = bmm_op_utils::create_matmul_resident_in1_buffer(
+        mesh_device.get(), Mt, Nt, Kt, config, cb_data_format, grid);
+
+    // weight는 한 번만 올린다. (DRAM 비교용 + L1 resident)
+    std::vector<bfloat16> src1_vec = create_random_vector_of_bfloat16_native(K * N * sizeof(bfloat16), 1, 12522, -0.5);
+    std::vector<bfloat16> src1_tiles = tilize_nfaces(src1_vec, K, N);
+    distributed::EnqueueWriteMeshBuffer(cq, src1_dram_buffer, src1_tiles, false);
+    distributed::EnqueueWriteMeshBuffer(
+        cq,
+        resident_in1_buffer,
+        bmm_op_utils::make_matmul_resident_in1_tiles(src1_tiles, Mt, Nt, Kt, config),
+        false);
+
+    distributed::MeshCoordinateRange device_range = distributed::MeshCoordinateRange(mesh_device->shape());
+    distributed::MeshWorkload dram_workload;
+    dram_workload.add_program(
+        device_range,
+        bmm_op_utils::create_matmul_multicore_reuse_program(
+            src0_dram_buffer,
+            src1_dram_buffer,
+            dst_dram_buffer,
+            Mt,
+            Nt,
+            Kt,
+            1,
+            false,
+            config,
+            cb_data_format,
+            MathFidelity::HiFi4,
+            grid));
+    distributed::MeshWorkload resident_workload;
+    resident_workload.add_program(
+        device_range,
+        bmm_op_utils::create_matmul_multicore_reuse_program(
+            src0_dram_buffer,
+            nullptr,
+            dst_dram_buffer,
+            Mt,
+            Nt,
+            Kt,
+            1,
+            false,
+            config,
+            cb_data_format,
+            MathFidelity::HiFi4,
+            grid,
+            {.resident_in1_buffer = resident_in1_buffer}));
+
+    // decode loop: token 마다 A만 새로 쓰고 같은 workload를 다시 launch 한다.
+    auto run_decode_loop = [&](distributed::MeshWorkload& workload, const char* name) {
+        std::vector<bfloat16> src0_vec;
+        std::vector<bfloat16> golden_vec(M * N, 0);
+        std::vector<bfloat16> result_vec(M * N);
+        // 첫 launch는 kernel compile 시간이 들어가므로 warmup으로 뺀다.
+        distributed::EnqueueMeshWorkload(cq, workload, false);
+        distributed::Finish(cq);
+
+        double total_us = 0.0;
+        float min_pcc = 1.0f;
+        for (uint32_t token = 0; token < num_tokens; token++) {
+            src0_vec = create_random_vector_of_bfloat16_native(M * K * sizeof(bfloat16), 1, 123 + token, -0.5);
+            distributed::EnqueueWriteMeshBuffer(cq, src0_dram_buffer, tilize_nfaces(src0_vec, M, K), true);
+
+            auto start = std::chrono::high_resolution_clock::now();
+            distributed::EnqueueMeshWorkload(cq, workload, false);
+            distributed::Finish(cq);
+            auto end = std::chrono::high_resolution_clock::now();
+            total_us += std::chrono::duration<double, std::micro>(end - start).count();
+
+            distributed::EnqueueReadMeshBuffer(cq, result_vec, dst_dram_buffer, true);
+            golden_matmul(src0_vec, src1_vec, golden_vec, M, N, K);
+            min_pcc = std::min(min_pcc, check_bfloat16_vector_pcc(golden_vec, untilize_nfaces(result_vec, M, N)));
+        }
+        fmt::print(" -- {}: {:.1f} us per token, min PCC = {} --\n", name, total_us / num_tokens, min_pcc);
+        if (min_pcc < 0.99f) {
+            fmt::print("PCC not high enough for {}. Result PCC: {}, Expected PCC: 0.99\n", name, min_pcc);
+            pass = false;
+        }
+    };
+
+    run_decode_loop(dram_workload, "B from DRAM");
+    run_decode_loop(resident_workload, "B resident in L1");
+
+    pass &= mesh_device->close();
+
+    if (pass) {
+        fmt::print("Test Passed!!! - matmul weight stationary\n");
+    } else {
+        TT_THROW("Test Failed");
+    }
+
+    return 0;
+}
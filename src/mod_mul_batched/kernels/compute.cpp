@@ -0,0 +1,42 @@
+#include <cstdint>
+#include "compute_kernel_api/tile_move_copy.h"
+#include "../../modular_common/kernels/mod_sfpu.h"
+
+namespace NAMESPACE {
+void MAIN {
+    constexpr uint32_t q_bits = get_compile_time_arg_val(0);
+
+    uint32_t n_tiles = get_arg_val<uint32_t>(0);
+    uint32_t q = get_arg_val<uint32_t>(1);
+    uint32_t mu = get_arg_val<uint32_t>(2);
+
+    tt::CBIndex cb_in0 = tt::CBIndex::c_0;
+    tt::CBIndex cb_in1 = tt::CBIndex::c_1;
+    tt::CBIndex cb_out = tt::CBIndex::c_16;
+
+    init_sfpu(cb_in0, cb_out);
+
+    for (uint32_t i = 0; i < n_tiles; i++) {
+        tile_regs_acquire();
+        cb_wait_front(cb_in0, 1);
+        cb_wait_front(cb_in1, 1);
+
+        // dst register 0: a, 1: b, 2 ~ 6: scratch
+        copy_tile_init(cb_in0);
+        copy_tile(cb_in0, 0, 0);
+        copy_tile_init(cb_in1);
+        copy_tile(cb_in1, 0, 1);
+
+        barrett_mul_mod_tile<q_bits>(0, 1, 2, 3, 4, 5, 6, q, mu);  // 0번 레지스터에 a * b mod q
+
+        tile_regs_commit();
+        tile_regs_wait();
+        cb_reserve_back(cb_out, 1);
+        pack_tile(0, cb_out);
+        cb_pop_front(cb_in0, 1);
+        cb_pop_front(cb_in1, 1);
+        cb_push_back(cb_out, 1);
+        tile_regs_release();
+    }
+}
+}  // namespace NAMESPACE
@@ -0,0 +1,29 @@
+#include <stdint.h>
+#include "dataflow_api.h"
+
+void kernel_main() {
+    uint32_t src0_addr = get_arg_val<uint32_t>(0);
+    uint32_t src1_addr = get_arg_val<uint32_t>(1);
+    uint32_t start_tile_id = get_arg_val<uint32_t>(2);  // 이 코어가 맡은 coefficient chunk의 첫 tile
+    uint32_t n_tiles = get_arg_val<uint32_t>(3);
+
+    constexpr uint32_t cb_id_in0 = tt::CBIndex::c_0;
+    constexpr uint32_t cb_id_in1 = tt::CBIndex::c_1;
+
+    constexpr auto s0_args = TensorAccessorArgs<0>();
+    const auto s0 = TensorAccessor(s0_args, src0_addr, get_tile_size(cb_id_in0));
+    constexpr auto s1_args = TensorAccessorArgs<s0_args.next_compile_time_args_offset()>();
+    const auto s1 = TensorAccessor(s1_args, src1_addr, get_tile_size(cb_id_in1));
+
+    for (uint32_t i = start_tile_id; i < start_tile_id + n_tiles; i++) {
+        cb_reserve_back(cb_id_in0, 1);
+        cb_reserve_back(cb_id_in1, 1);
+
+        noc_async_read_tile(i, s0, get_write_ptr(cb_id_in0));
+        noc_async_read_tile(i, s1, get_write_ptr(cb_id_in1));
+        noc_async_read_barrier();
+
+        cb_push_back(cb_id_in0, 1);
+        cb_push_back(cb_id_in1, 1);
+    }
+}
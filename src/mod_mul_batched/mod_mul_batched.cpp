@@ -0,0 +1,231 @@
+#include <chrono>
+#include <random>
+#include <tt-metalium/host_api.hpp>
+#include <tt-metalium/constants.hpp>
+#include <tt-metalium/tilize_utils.hpp>
+#include <tt-metalium/distributed.hpp>
+#include <tt-metalium/device.hpp>
+#include <tt-metalium/tensor_accessor_args.hpp>
+#include <mod_op.hpp>
+#include <fmt/core.h>
+
+using namespace tt::constants;
+using namespace tt;
+using namespace std;
+using namespace tt::tt_metal;
+
+#ifndef OVERRIDE_KERNEL_PREFIX
+#define OVERRIDE_KERNEL_PREFIX ""
+#endif
+
+/**
+ * @brief Batched element-wise modular multiplication c_i = a_i * b_i mod q for B independent polynomials.
+ *
+ * The polynomials are laid out back to back in one DRAM buffer per operand (polynomial p owns tiles
+ * [p * tiles_per_poly, (p + 1) * tiles_per_poly)). They are placed on the compute grid as a
+ * 2D decomposition (see mod_op_utils::get_batched_grid):
+ * - x: coefficient chunks of one polynomial (several polynomials side by side if the grid is wider)
+ * - y: batch
+ *
+ * CBs and kernels are created once. If B does not fit into one launch, the same compiled Program is
+ * re-enqueued and only the runtime args (start tile / tile count) are rewritten for the next wave.
+ *
+ * @param a, b Input polynomials, tilized, B * n coefficients each (uint32, < q)
+ * @param output Output polynomials, tilized, B * n coefficients
+ * @param B Number of polynomials
+ * @param n Coefficients per polynomial (multiple of 1024)
+ * @param q Modulus, 2^15 <= q < 2^29
+ */
+void mod_mul_batched(
+    std::vector<uint32_t>& a,
+    std::vector<uint32_t>& b,
+    std::vector<uint32_t>& output,
+    uint32_t B,
+    uint32_t n,
+    uint32_t q,
+    const std::shared_ptr<distributed::MeshDevice>& mesh_device) {
+    TT_FATAL(n % TILE_HW == 0, "n = {} must be a multiple of TILE_HW = {}", n, TILE_HW);
+
+    distributed::MeshCommandQueue& cq = mesh_device->mesh_command_queue();
+    distributed::MeshWorkload workload;
+    distributed::MeshCoordinateRange device_range = distributed::MeshCoordinateRange(mesh_device->shape());
+    Program program = CreateProgram();
+
+    auto barrett = mod_op_utils::get_barrett_params(q);
+
+    auto grid_size = mesh_device->compute_with_storage_grid_size();
+    CoreRange all_cores({0, 0}, {grid_size.x - 1, grid_size.y - 1});
+
+    uint32_t tiles_per_poly = n / TILE_HW;
+    auto grid = mod_op_utils::get_batched_grid(B, tiles_per_poly, grid_size);
+
+    fmt::print(" -- Batched Grid --\n");
+    fmt::print(
+        " -- chunks_per_poly= {} -- tiles_per_chunk= {} -- polys_per_row= {} -- batch_per_wave= {} -- num_waves= {} --\n",
+        grid.chunks_per_poly,
+        grid.tiles_per_chunk,
+        grid.polys_per_row,
+        grid.batch_per_wave,
+        grid.num_waves);
+
+    constexpr uint32_t tile_size_bytes = sizeof(uint32_t) * TILE_HW;
+    uint32_t total_tiles = B * tiles_per_poly;
+
+    distributed::DeviceLocalBufferConfig dram_config{
+        .page_size = tile_size_bytes, .buffer_type = tt_metal::BufferType::DRAM};
+    distributed::ReplicatedBufferConfig buffer_config{.size = tile_size_bytes * total_tiles};
+
+    auto src0_dram_buffer = distributed::MeshBuffer::create(buffer_config, dram_config, mesh_device.get());
+    auto src1_dram_buffer = distributed::MeshBuffer::create(buffer_config, dram_config, mesh_device.get());
+    auto dst_dram_buffer = distributed::MeshBuffer::create(buffer_config, dram_config, mesh_device.get());
+
+    // CB는 wave와 상관없이 한 번만 만든다. (double buffer)
+    constexpr uint32_t num_input_tiles = 2;
+    for (uint32_t cb_index : {(uint32_t)CBIndex::c_0, (uint32_t)CBIndex::c_1, (uint32_t)CBIndex::c_16}) {
+        tt_metal::CreateCircularBuffer(
+            program,
+            all_cores,
+            CircularBufferConfig(num_input_tiles * tile_size_bytes, {{cb_index, tt::DataFormat::UInt32}})
+                .set_page_size(cb_index, tile_size_bytes));
+    }
+
+    std::vector<uint32_t> reader_compile_time_args;
+    TensorAccessorArgs(*src0_dram_buffer).append_to(reader_compile_time_args);
+    TensorAccessorArgs(*src1_dram_buffer).append_to(reader_compile_time_args);
+    KernelHandle reader_id = CreateKernel(
+        program,
+        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/mod_mul_batched/kernels/reader.cpp",
+        all_cores,
+        DataMovementConfig{
+            .processor = DataMovementProcessor::RISCV_1,
+            .noc = NOC::RISCV_1_default,
+            .compile_args = reader_compile_time_args});
+
+    std::vector<uint32_t> writer_compile_time_args;
+    TensorAccessorArgs(*dst_dram_buffer).append_to(writer_compile_time_args);
+    KernelHandle writer_id = CreateKernel(
+        program,
+        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/mod_mul_batched/kernels/writer.cpp",
+        all_cores,
+        DataMovementConfig{
+            .processor = DataMovementProcessor::RISCV_0,
+            .noc = NOC::RISCV_0_default,
+            .compile_args = writer_compile_time_args});
+
+    // Barrett mul은 32-bit dst tile 7개를 쓰므로 fp32 dest + full sync (8 tiles) 가 필요하다.
+    KernelHandle compute_id = CreateKernel(
+        program,
+        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/mod_mul_batched/kernels/compute.cpp",
+        all_cores,
+        ComputeConfig{
+            .math_fidelity = MathFidelity::HiFi4,
+            .fp32_dest_acc_en = true,
+            .dst_full_sync_en = true,
+            .math_approx_mode = false,
+            .compile_args = {barrett.q_bits}});
+
+    // Runtime args의 모양(개수)은 wave마다 같고 값만 바뀐다. 먼저 빈 값으로 한 번 설정해 둔다.
+    for (const auto& core : all_cores) {
+        SetRuntimeArgs(program, reader_id, core, {src0_dram_buffer->address(), src1_dram_buffer->address(), 0, 0});
+        SetRuntimeArgs(program, writer_id, core, {dst_dram_buffer->address(), 0, 0});
+        SetRuntimeArgs(program, compute_id, core, {0, barrett.q, barrett.mu});
+    }
+
+    distributed::EnqueueWriteMeshBuffer(cq, src0_dram_buffer, a, false);
+    distributed::EnqueueWriteMeshBuffer(cq, src1_dram_buffer, b, false);
+    workload.add_program(device_range, std::move(program));
+    Program& batched_program = workload.get_programs().at(device_range);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (uint32_t wave = 0; wave < grid.num_waves; wave++) {
+        for (const auto& core : all_cores) {
+            uint32_t poly_slot = core.x / grid.chunks_per_poly;
+            uint32_t chunk = core.x % grid.chunks_per_poly;
+            uint32_t poly_in_wave = core.y * grid.polys_per_row + poly_slot;
+            uint32_t poly = wave * grid.batch_per_wave + poly_in_wave;
+
+            uint32_t start_tile_id = 0;
+            uint32_t n_tiles = 0;
+            if (poly_slot < grid.polys_per_row && poly_in_wave < grid.batch_per_wave && poly < B) {
+                uint32_t chunk_start = chunk * grid.tiles_per_chunk;
+                start_tile_id = poly * tiles_per_poly + chunk_start;
+                n_tiles = std::min(grid.tiles_per_chunk, tiles_per_poly - chunk_start);
+            }
+
+            auto& reader_args = GetRuntimeArgs(batched_program, reader_id, core);
+            reader_args[2] = start_tile_id;
+            reader_args[3] = n_tiles;
+            auto& writer_args = GetRuntimeArgs(batched_program, writer_id, core);
+            writer_args[1] = start_tile_id;
+            writer_args[2] = n_tiles;
+            auto& compute_args = GetRuntimeArgs(batched_program, compute_id, core);
+            compute_args[0] = n_tiles;
+        }
+        distributed::EnqueueMeshWorkload(cq, workload, false);
+    }
+    distributed::Finish(cq);
+    auto end = std::chrono::high_resolution_clock::now();
+    fmt::print(
+        " -- {} polynomials in {} launch(es): {} us --\n",
+        B,
+        grid.num_waves,
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+
+    distributed::EnqueueReadMeshBuffer(cq, output, dst_dram_buffer, true);
+}
+
+int main() {
+    bool pass = true;
+
+    constexpr int device_id = 0;
+    std::shared_ptr<distributed::MeshDevice> mesh_device = distributed::MeshDevice::create_unit_mesh(device_id);
+
+    constexpr uint32_t B = 64;     // number of polynomials (user-defined)
+    constexpr uint32_t n = 4096;   // coefficients per polynomial (user-defined)
+    constexpr uint32_t q = 8650753;
+
+    std::random_device rd;
+    std::mt19937 engine(rd());
+    std::uniform_int_distribution<std::uint32_t> dist(0, q - 1);
+
+    std::vector<uint32_t> src0_vec(B * n);
+    std::vector<uint32_t> src1_vec(B * n);
+    for (uint32_t& v : src0_vec) {
+        v = dist(engine);
+    }
+    for (uint32_t& v : src1_vec) {
+        v = dist(engine);
+    }
+
+    std::vector<uint32_t> golden(B * n);
+    for (uint32_t i = 0; i < B * n; i++) {
+        golden.at(i) = mod_op_utils::mul_mod(src0_vec.at(i), src1_vec.at(i), q);
+    }
+
+    // B개의 polynomial을 (B * n / 32) x 32 행렬로 보고 tilize 한다. polynomial p는 tile p * n / 1024 부터 시작한다.
+    src0_vec = tilize_nfaces(src0_vec, B * n / TILE_WIDTH, TILE_WIDTH);
+    src1_vec = tilize_nfaces(src1_vec, B * n / TILE_WIDTH, TILE_WIDTH);
+
+    std::vector<uint32_t> result_vec(B * n);
+    mod_mul_batched(src0_vec, src1_vec, result_vec, B, n, q, mesh_device);
+    result_vec = untilize_nfaces(result_vec, B * n / TILE_WIDTH, TILE_WIDTH);
+
+    // 검증
+    for (uint32_t i = 0; i < B * n; i++) {
+        if (golden.at(i) != result_vec.at(i)) {
+            fmt::print("golden and result unmatch at {}, golden = {}, result = {}\n", i, golden.at(i), result_vec.at(i));
+            pass = false;
+            break;
+        }
+    }
+
+    pass &= mesh_device->close();
+
+    if (pass) {
+        fmt::print("Test Passed!! ---- mod_mul_batched\n");
+    } else {
+        TT_THROW("Test Failed!!");
+    }
+
+    return 0;
+}
@@ -0,0 +1,279 @@
+#pragma once
+
+#include <cstdint>
+#include "compute_kernel_api/common.h"
+#include "compute_kernel_api/eltwise_binary_sfpu.h"
+#include "compute_kernel_api/eltwise_unary/eltwise_unary.h"
+#include "compute_kernel_api.h"
+#include "compute_kernel_api/mul_int32_sfpu.h"
+#include "compute_kernel_api/mul_int_sfpu.h"
+
+/*
+    dst register 위에서 uint32 modular 연산을 하기 위한 helper.
+
+    SFPU에는 32x32 곱셈의 상위 32-bit를 구하는 명령이 없기 때문에 operand를 16-bit limb로 나눈 뒤
+    mul_uint32_tile로 16x16 부분곱 4개를 구하고, 그 부분곱을 더해서 64-bit 곱 (hi, lo)를 만든다.
+    (sfpu_barrett 예제의 split_32_to_16 / mul32x32_to_64 와 같은 방식)
+
+    Barrett reduction은 HAC 14.42를 그대로 따른다. (k = q_bits, b = 2)
+        x    = t >> (k - 1)
+        qhat = (x * mu) >> (k + 1),   mu = floor(2^(2k) / q)
+        r    = t - qhat * q           (0 <= r < 3q)
+    r < 3q < 2^31 이므로 r은 하위 32-bit만으로 계산할 수 있다.
+
+    dst register 사용량: 모든 함수는 인자로 받은 index만 사용하고, 8개의 32-bit dst tile 안에서 동작하도록
+    되어 있다. (ComputeConfig에서 fp32_dest_acc_en = true, dst_full_sync_en = true 필요)
+*/
+
+#ifdef TRISC_MATH
+constexpr size_t mod_vectors_per_face = 8;
+constexpr uint32_t mod_n_vector_in_tile = 32;
+
+inline void mod_fill_face(uint32_t value) {
+    vUInt v = value;
+    for (size_t i = 0; i < mod_vectors_per_face; i++) {
+        dst_reg[i] = v;
+    }
+}
+
+inline void mod_copy_face(uint32_t src, uint32_t dst, uint32_t /*unused*/) {
+    uint32_t src_base = src * mod_n_vector_in_tile;
+    uint32_t dst_base = dst * mod_n_vector_in_tile;
+
+    for (size_t i = 0; i < mod_vectors_per_face; i++) {
+        dst_reg[dst_base + i] = dst_reg[src_base + i];
+    }
+}
+
+inline void mod_split16_face(uint32_t a, uint32_t hi, uint32_t lo) {
+    uint32_t a_base = a * mod_n_vector_in_tile;
+    uint32_t hi_base = hi * mod_n_vector_in_tile;
+    uint32_t lo_base = lo * mod_n_vector_in_tile;
+
+    uint32_t mask = 0xFFFF;
+
+    for (size_t i = 0; i < mod_vectors_per_face; i++) {
+        vUInt v = dst_reg[a_base + i];
+        dst_reg[hi_base + i] = v >> 16;
+        dst_reg[lo_base + i] = v & mask;
+    }
+}
+
+// x * y = p11 * 2^32 + (p10 + p01) * 2^16 + p00
+inline void mod_combine64_face(uint32_t p10, uint32_t p01, uint32_t p00, uint32_t p11, uint32_t hi, uint32_t lo) {
+    uint32_t p10_base = p10 * mod_n_vector_in_tile;
+    uint32_t p01_base = p01 * mod_n_vector_in_tile;
+    uint32_t p00_base = p00 * mod_n_vector_in_tile;
+    uint32_t p11_base = p11 * mod_n_vector_in_tile;
+    uint32_t hi_base = hi * mod_n_vector_in_tile;
+    uint32_t lo_base = lo * mod_n_vector_in_tile;
+
+    uint32_t mask = 0xFFFF;
+
+    for (size_t i = 0; i < mod_vectors_per_face; i++) {
+        vUInt v10 = dst_reg[p10_base + i];
+        vUInt v01 = dst_reg[p01_base + i];
+        vUInt v00 = dst_reg[p00_base + i];
+        vUInt v11 = dst_reg[p11_base + i];
+
+        // 가운데 열의 하위 16-bit 합은 최대 3 * 2^16 이므로 overflow가 나지 않는다.
+        vUInt mid = (v10 & mask) + (v01 & mask) + (v00 >> 16);
+        dst_reg[hi_base + i] = v11 + (v10 >> 16) + (v01 >> 16) + (mid >> 16);
+        dst_reg[lo_base + i] = (mid << 16) | (v00 & mask);
+    }
+}
+
+// out = (hi:lo) >> SHIFT, 0 < SHIFT < 32. 결과가 32-bit에 들어간다는 것은 호출하는 쪽이 보장한다.
+template <uint32_t SHIFT>
+inline void mod_shr64_face(uint32_t hi, uint32_t lo, uint32_t out) {
+    uint32_t hi_base = hi * mod_n_vector_in_tile;
+    uint32_t lo_base = lo * mod_n_vector_in_tile;
+    uint32_t out_base = out * mod_n_vector_in_tile;
+
+    for (size_t i = 0; i < mod_vectors_per_face; i++) {
+        vUInt h = dst_reg[hi_base + i];
+        vUInt l = dst_reg[lo_base + i];
+        dst_reg[out_base + i] = (h << (32 - SHIFT)) | (l >> SHIFT);
+    }
+}
+
+// out = (r - t) mod 2^32 를 [0, q) 로 보정한다. 호출 전 r - t < 3q 이어야 한다.
+inline void mod_sub_reduce_face(uint32_t r, uint32_t t, uint32_t out, uint32_t q_) {
+    uint32_t r_base = r * mod_n_vector_in_tile;
+    uint32_t t_base = t * mod_n_vector_in_tile;
+    uint32_t out_base = out * mod_n_vector_in_tile;
+
+    vUInt q = q_;
+
+    for (size_t i = 0; i < mod_vectors_per_face; i++) {
+        vUInt x = vUInt(dst_reg[r_base + i]) - vUInt(dst_reg[t_base + i]);
+        v_if(x >= q) { x -= q; }
+        v_endif;
+        v_if(x >= q) { x -= q; }
+        v_endif;
+        dst_reg[out_base + i] = x;
+    }
+}
+
+// e <- (e & mask) != 0 ? c : 1 (lane 별 exponent bit에 따라 곱할 값을 고른다)
+inline void mod_select_bit_face(uint32_t e, uint32_t c, uint32_t /*unused*/, uint32_t mask_) {
+    uint32_t e_base = e * mod_n_vector_in_tile;
+    uint32_t c_base = c * mod_n_vector_in_tile;
+
+    vUInt mask = mask_;
+
+    for (size_t i = 0; i < mod_vectors_per_face; i++) {
+        vUInt v = dst_reg[e_base + i];
+        vUInt out = 1;
+        v_if((v & mask) != 0) { out = dst_reg[c_base + i]; }
+        v_endif;
+        dst_reg[e_base + i] = out;
+    }
+}
+#endif
+
+inline void mod_fill_tile(uint32_t idst, uint32_t value) {
+    MATH(_llk_math_eltwise_unary_sfpu_params_<false>(mod_fill_face, idst, VectorMode::RC, value));
+}
+
+inline void mod_copy_tile(uint32_t src, uint32_t dst) {
+    MATH(_llk_math_eltwise_binary_sfpu_params_<false>(mod_copy_face, src, dst, dst, (int)ckernel::VectorMode::RC));
+}
+
+inline void mod_split16_tile(uint32_t a, uint32_t hi, uint32_t lo) {
+    MATH(_llk_math_eltwise_binary_sfpu_params_<false>(mod_split16_face, a, hi, lo, (int)ckernel::VectorMode::RC));
+}
+
+template <uint32_t SHIFT>
+inline void mod_shr64_tile(uint32_t hi, uint32_t lo, uint32_t out) {
+    MATH(_llk_math_eltwise_binary_sfpu_params_<false>(
+        mod_shr64_face<SHIFT>, hi, lo, out, (int)ckernel::VectorMode::RC));
+}
+
+inline void mod_sub_reduce_tile(uint32_t r, uint32_t t, uint32_t out, uint32_t q) {
+    MATH(_llk_math_eltwise_binary_sfpu_params_<false>(
+        mod_sub_reduce_face, r, t, out, (int)ckernel::VectorMode::RC, q));
+}
+
+inline void mod_select_bit_tile(uint32_t e, uint32_t c, uint32_t mask) {
+    MATH(_llk_math_eltwise_binary_sfpu_params_<false>(
+        mod_select_bit_face, e, c, e, (int)ckernel::VectorMode::RC, mask));
+}
+
+/*
+    64-bit product of two uint32 tiles.
+    결과: x <- hi, y <- lo. s0 ~ s3 는 scratch.
+*/
+inline void mod_mul64_tile(uint32_t x, uint32_t y, uint32_t s0, uint32_t s1, uint32_t s2, uint32_t s3) {
+    mod_split16_tile(x, s0, s1);  // s0 = x_hi, s1 = x_lo
+    mod_split16_tile(y, s2, s3);  // s2 = y_hi, s3 = y_lo
+
+    ckernel::mul_int32_tile_init();
+    ckernel::mul_uint32_tile(s0, s2, x);   // p11
+    ckernel::mul_uint32_tile(s0, s3, s0);  // p10
+    ckernel::mul_uint32_tile(s1, s2, s2);  // p01
+    ckernel::mul_uint32_tile(s1, s3, s1);  // p00
+
+    MATH(_llk_math_eltwise_binary_sfpu_params_<false>(
+        mod_combine64_face, s0, s2, s1, (int)ckernel::VectorMode::RC, x, x, y));
+}
+
+/*
+    Barrett reduction of a 64-bit value t = (hi:lo), t < 2^(2 * Q_BITS).
+    결과: hi <- t mod q. lo, s0 ~ s3, m 은 scratch.
+*/
+template <uint32_t Q_BITS>
+inline void barrett_reduce64_tile(
+    uint32_t hi, uint32_t lo, uint32_t s0, uint32_t s1, uint32_t s2, uint32_t s3, uint32_t m, uint32_t q, uint32_t mu) {
+    static_assert(Q_BITS >= 16 && Q_BITS <= 29, "Barrett SFPU path supports 2^15 <= q < 2^29");
+
+    mod_shr64_tile<Q_BITS - 1>(hi, lo, hi);  // hi = x = t >> (k - 1)
+
+    mod_fill_tile(m, mu);
+    mod_mul64_tile(hi, m, s0, s1, s2, s3);   // (hi:m) = x * mu
+    mod_shr64_tile<Q_BITS + 1>(hi, m, hi);   // hi = qhat
+
+    mod_fill_tile(s0, q);
+    ckernel::mul_int32_tile_init();
+    ckernel::mul_uint32_tile(hi, s0, hi);    // hi = low32(qhat * q)
+
+    mod_sub_reduce_tile(lo, hi, hi, q);      // hi = t - qhat * q, then r < q
+}
+
+/*
+    Barrett reduction of a 32-bit value (예: integer matmul의 누적 결과). t < 2^32 <= 2^(2 * Q_BITS).
+    결과: t <- t mod q. hi, s0 ~ s3, m 은 scratch (dst tile 7개 사용).
+*/
+template <uint32_t Q_BITS>
+inline void barrett_reduce32_tile(
+    uint32_t t, uint32_t hi, uint32_t s0, uint32_t s1, uint32_t s2, uint32_t s3, uint32_t m, uint32_t q, uint32_t mu) {
+    mod_fill_tile(hi, 0);
+    barrett_reduce64_tile<Q_BITS>(hi, t, s0, s1, s2, s3, m, q, mu);
+    mod_copy_tile(hi, t);
+}
+
+/*
+    a <- a * b mod q. b, s0 ~ s3, m 은 scratch (dst tile 7개 사용).
+*/
+template <uint32_t Q_BITS>
+inline void barrett_mul_mod_tile(
+    uint32_t a, uint32_t b, uint32_t s0, uint32_t s1, uint32_t s2, uint32_t s3, uint32_t m, uint32_t q, uint32_t mu) {
+    mod_mul64_tile(a, b, s0, s1, s2, s3);  // (a:b) = a * b
+    barrett_reduce64_tile<Q_BITS>(a, b, s0, s1, s2, s3, m, q, mu);
+}
+
+/*
+    Shoup multiplication by a precomputed constant: x <- x * w mod q.
+    wp = floor(w * 2^32 / q) (twiddle table와 함께 미리 계산해 둔 Shoup table)
+        qhat = (x * wp) >> 32,  r = x * w - qhat * q  (0 <= r < 2q)
+    wp, s0 ~ s3, t 는 scratch (dst tile 8개 사용).
+*/
+inline void shoup_mul_mod_tile(
+    uint32_t x, uint32_t w, uint32_t wp, uint32_t s0, uint32_t s1, uint32_t s2, uint32_t s3, uint32_t t, uint32_t q) {
+    mod_copy_tile(x, t);
+    mod_mul64_tile(t, wp, s0, s1, s2, s3);  // t = qhat
+
+    ckernel::mul_int32_tile_init();
+    ckernel::mul_uint32_tile(x, w, x);      // x = low32(x * w)
+
+    mod_fill_tile(s0, q);
+    ckernel::mul_int32_tile_init();
+    ckernel::mul_uint32_tile(t, s0, t);     // t = low32(qhat * q)
+
+    mod_sub_reduce_tile(x, t, x, q);
+}
+
+/*
+    r <- x^e mod q (left-to-right square-and-multiply, 모든 lane이 같은 exponent e를 쓴다).
+    e = q - 2 로 부르면 Fermat inversion x^-1 mod q 가 된다. (q prime)
+    x는 보존되고 t, s0 ~ s3, m 은 scratch (dst tile 8개 사용).
+*/
+template <uint32_t Q_BITS>
+inline void pow_mod_tile(
+    uint32_t x,
+    uint32_t r,
+    uint32_t t,
+    uint32_t s0,
+    uint32_t s1,
+    uint32_t s2,
+    uint32_t s3,
+    uint32_t m,
+    uint32_t e,
+    uint32_t q,
+    uint32_t mu) {
+    if (e == 0) {
+        mod_fill_tile(r, 1);
+        return;
+    }
+
+    // 최상위 bit는 r = x 로 시작한다.
+    mod_copy_tile(x, r);
+    for (int bit = 30 - __builtin_clz(e); bit >= 0; bit--) {
+        mod_copy_tile(r, t);
+        barrett_mul_mod_tile<Q_BITS>(r, t, s0, s1, s2, s3, m, q, mu);  // r = r^2
+        if ((e >> bit) & 1) {
+            mod_copy_tile(x, t);
+            barrett_mul_mod_tile<Q_BITS>(r, t, s0, s1, s2, s3, m, q, mu);  // r = r * x
+        }
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+#include <tt-metalium/host_api.hpp>
+#include <tt-metalium/core_coord.hpp>
+
+/*
+    modular 예제들(mod_mul_batched, ...)이 공유하는 host 쪽 helper.
+    device 쪽 SFPU helper는 kernels/mod_sfpu.h 에 있다.
+*/
+
+namespace mod_op_utils {
+
+// Barrett reduction parameters for a modulus q with q_bits = bit_width(q).
+//   mu = floor(2^(2 * q_bits) / q)
+// The SFPU implementation (mod_sfpu.h) keeps every intermediate in 32 bits, which requires
+// 2^15 <= q < 2^29 (conditional subtractions compare r < 3q as a signed 32-bit value).
+struct BarrettParams {
+    uint32_t q;
+    uint32_t q_bits;
+    uint32_t mu;
+};
+
+BarrettParams get_barrett_params(uint32_t q) {
+    uint32_t q_bits = std::bit_width(q);
+    TT_FATAL(q_bits >= 16 && q_bits <= 29, "Barrett SFPU path supports 2^15 <= q < 2^29, got q = {}", q);
+    TT_FATAL((q & (q - 1)) != 0, "q = {} must not be a power of two", q);
+
+    uint64_t mu = (1ULL << (2 * q_bits)) / q;
+    return {q, q_bits, static_cast<uint32_t>(mu)};
+}
+
+uint32_t mul_mod(uint32_t a, uint32_t b, uint32_t q) {
+    return static_cast<uint32_t>((static_cast<uint64_t>(a) * b) % q);
+}
+
+uint32_t pow_mod(uint32_t x, uint64_t e, uint32_t q) {
+    uint32_t r = 1 % q;
+    while (e > 0) {
+        if (e & 1) {
+            r = mul_mod(r, x, q);
+        }
+        x = mul_mod(x, x, q);
+        e >>= 1;
+    }
+    return r;
+}
+
+// Shoup companion of a constant w < q: floor(w * 2^32 / q)
+uint32_t shoup_precompute(uint32_t w, uint32_t q) {
+    return static_cast<uint32_t>((static_cast<uint64_t>(w) << 32) / q);
+}
+
+// Primitive 2n-th root of unity psi mod q (negacyclic NTT), q prime with q = 1 mod 2n, n a power of two.
+uint32_t find_primitive_root_2n(uint32_t n, uint32_t q) {
+    TT_FATAL((q - 1) % (2 * n) == 0, "q = {} is not 1 mod 2n (n = {})", q, n);
+    for (uint32_t g = 2; g < q; g++) {
+        uint32_t psi = pow_mod(g, (q - 1) / (2 * n), q);
+        // psi^n = -1 이면 psi의 order는 정확히 2n 이다.
+        if (pow_mod(psi, n, q) == q - 1) {
+            return psi;
+        }
+    }
+    TT_THROW("No primitive 2n-th root of unity for n = {}, q = {}", n, q);
+}
+
+/*
+    Batched (B x coefficient chunk) decomposition of the compute grid.
+
+    B개의 독립적인 polynomial을 grid에 2D로 배치한다.
+    - x 방향: 하나의 polynomial을 chunks_per_poly 개의 coefficient chunk로 나눔
+      (grid 폭이 남으면 한 row에 polys_per_row 개의 polynomial을 나란히 둔다)
+    - y 방향: batch
+    한 번의 launch(wave)에 batch_per_wave 개의 polynomial을 처리하고,
+    B가 더 크면 같은 Program을 runtime args만 바꿔서 num_waves 번 다시 enqueue 한다.
+*/
+struct BatchedGrid {
+    uint32_t chunks_per_poly;
+    uint32_t tiles_per_chunk;
+    uint32_t polys_per_row;
+    uint32_t batch_per_wave;
+    uint32_t num_waves;
+};
+
+BatchedGrid get_batched_grid(uint32_t B, uint32_t tiles_per_poly, CoreCoord grid) {
+    BatchedGrid g{};
+    g.chunks_per_poly = std::min<uint32_t>(grid.x, tiles_per_poly);
+    g.tiles_per_chunk = (tiles_per_poly + g.chunks_per_poly - 1) / g.chunks_per_poly;
+    // Rounding up tiles_per_chunk may leave trailing chunks empty; drop them.
+    g.chunks_per_poly = (tiles_per_poly + g.tiles_per_chunk - 1) / g.tiles_per_chunk;
+    g.polys_per_row = grid.x / g.chunks_per_poly;
+    g.batch_per_wave = std::min<uint32_t>(B, g.polys_per_row * grid.y);
+    g.num_waves = (B + g.batch_per_wave - 1) / g.batch_per_wave;
+    return g;
+}
+
+}  // namespace mod_op_utils
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <tt-metalium/host_api.hpp>
+#include <tt-metalium/constants.hpp>
+#include <tt-metalium/tilize_utils.hpp>
+#include <tt-metalium/distributed.hpp>
+
+#include "mod_op.hpp"
+
+/*
+    (n, q) 별 NTT twiddle / Shoup table을 DRAM에 올려두고 launch 사이에 재사용하는 cache.
+
+    table은 (n, q)에 대해 항상 같기 때문에 처음 한 번만 host에서 계산해서 EnqueueWriteMeshBuffer로 올리고,
+    그 뒤의 호출은 이미 DRAM에 있는 MeshBuffer를 그대로 돌려준다.
+    전체 크기가 budget_bytes를 넘으면 가장 오래 사용하지 않은 (n, q)부터 해제한다. (LRU)
+*/
+
+namespace mod_op_utils {
+
+struct TwiddleTables {
+    uint32_t n;
+    uint32_t q;
+    // psi^i mod q, i = 0 .. n-1, tilized as (n / 32) x 32
+    std::shared_ptr<tt::tt_metal::distributed::MeshBuffer> twiddle;
+    // floor(psi^i * 2^32 / q), same layout as twiddle
+    std::shared_ptr<tt::tt_metal::distributed::MeshBuffer> shoup;
+
+    uint64_t size_bytes() const { return 2ULL * n * sizeof(uint32_t); }
+};
+
+class TwiddleTableCache {
+public:
+    TwiddleTableCache(std::shared_ptr<tt::tt_metal::distributed::MeshDevice> mesh_device, uint64_t budget_bytes) :
+        mesh_device_(std::move(mesh_device)), budget_bytes_(budget_bytes) {}
+
+    // 반환값은 MeshBuffer의 shared_ptr를 들고 있으므로 eviction이 일어나도 호출한 쪽이 쓰는 동안은 유효하다.
+    TwiddleTables get(uint32_t n, uint32_t q) {
+        uint64_t key = (static_cast<uint64_t>(n) << 32) | q;
+
+        auto it = entries_.find(key);
+        if (it != entries_.end()) {
+            hits_++;
+            lru_.splice(lru_.begin(), lru_, it->second.lru_it);
+            return it->second.tables;
+        }
+
+        misses_++;
+        // DRAM에 올리기 전에 자리를 만든다. 새 table과 기존 table이 같이 있어도 budget_bytes를 넘지 않는다.
+        uint64_t size_bytes = TwiddleTables{n, q}.size_bytes();
+        TT_FATAL(
+            size_bytes <= budget_bytes_,
+            "Twiddle tables for n = {} ({} bytes) exceed the cache budget of {} bytes",
+            n,
+            size_bytes,
+            budget_bytes_);
+        while (resident_bytes_ + size_bytes > budget_bytes_) {
+            evict_lru();
+        }
+
+        TwiddleTables tables = upload(n, q);
+        lru_.push_front(key);
+        entries_.emplace(key, Entry{tables, lru_.begin()});
+        resident_bytes_ += tables.size_bytes();
+        return tables;
+    }
+
+    void clear() {
+        entries_.clear();
+        lru_.clear();
+        resident_bytes_ = 0;
+    }
+
+    uint64_t hits() const { return hits_; }
+    uint64_t misses() const { return misses_; }
+    uint64_t evictions() const { return evictions_; }
+    uint64_t resident_bytes() const { return resident_bytes_; }
+
+private:
+    struct Entry {
+        TwiddleTables tables;
+        std::list<uint64_t>::iterator lru_it;
+    };
+
+    TwiddleTables upload(uint32_t n, uint32_t q) {
+        using namespace tt::tt_metal;
+        using tt::constants::TILE_HW;
+        using tt::constants::TILE_WIDTH;
+
+        TT_FATAL(n % TILE_HW == 0, "n = {} must be a multiple of TILE_HW = {}", n, TILE_HW);
+
+        uint32_t psi = find_primitive_root_2n(n, q);
+        std::vector<uint32_t> twiddle(n);
+        std::vector<uint32_t> shoup(n);
+        uint32_t w = 1;
+        for (uint32_t i = 0; i < n; i++) {
+            twiddle[i] = w;
+            shoup[i] = shoup_precompute(w, q);
+            w = mul_mod(w, psi, q);
+        }
+        twiddle = tilize_nfaces(twiddle, n / TILE_WIDTH, TILE_WIDTH);
+        shoup = tilize_nfaces(shoup, n / TILE_WIDTH, TILE_WIDTH);
+
+        constexpr uint32_t tile_size_bytes = sizeof(uint32_t) * TILE_HW;
+        distributed::DeviceLocalBufferConfig dram_config{
+            .page_size = tile_size_bytes, .buffer_type = tt_metal::BufferType::DRAM};
+        distributed::ReplicatedBufferConfig buffer_config{.size = n * sizeof(uint32_t)};
+
+        TwiddleTables tables{
+            n,
+            q,
+            distributed::MeshBuffer::create(buffer_config, dram_config, mesh_device_.get()),
+            distributed::MeshBuffer::create(buffer_config, dram_config, mesh_device_.get())};
+
+        // host vector가 함수가 끝나면 사라지므로 blocking write를 쓴다.
+        distributed::MeshCommandQueue& cq = mesh_device_->mesh_command_queue();
+        distributed::EnqueueWriteMeshBuffer(cq, tables.twiddle, twiddle, true);
+        distributed::EnqueueWriteMeshBuffer(cq, tables.shoup, shoup, true);
+        return tables;
+    }
+
+    void evict_lru() {
+        uint64_t key = lru_.back();
+        lru_.pop_back();
+        auto it = entries_.find(key);
+        resident_bytes_ -= it->second.tables.size_bytes();
+        entries_.erase(it);
+        evictions_++;
+    }
+
+    std::shared_ptr<tt::tt_metal::distributed::MeshDevice> mesh_device_;
+    uint64_t budget_bytes_;
+    uint64_t resident_bytes_ = 0;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+    uint64_t evictions_ = 0;
+    std::list<uint64_t> lru_;
+    std::unordered_map<uint64_t, Entry> entries_;
+};
+
+}  // namespace mod_op_utils
@@ -0,0 +1,44 @@
+#include <cstdint>
+#include "compute_kernel_api/tile_move_copy.h"
+#include "../../modular_common/kernels/mod_sfpu.h"
+
+namespace NAMESPACE {
+void MAIN {
+    uint32_t n_tiles = get_arg_val<uint32_t>(0);
+    uint32_t q = get_arg_val<uint32_t>(1);
+
+    tt::CBIndex cb_in0 = tt::CBIndex::c_0;
+    tt::CBIndex cb_in1 = tt::CBIndex::c_1;
+    tt::CBIndex cb_in2 = tt::CBIndex::c_2;
+    tt::CBIndex cb_out = tt::CBIndex::c_16;
+
+    init_sfpu(cb_in0, cb_out);
+
+    for (uint32_t i = 0; i < n_tiles; i++) {
+        tile_regs_acquire();
+        cb_wait_front(cb_in0, 1);
+        cb_wait_front(cb_in1, 1);
+        cb_wait_front(cb_in2, 1);
+
+        // dst register 0: x, 1: w, 2: w', 3 ~ 7: scratch
+        copy_tile_init(cb_in0);
+        copy_tile(cb_in0, 0, 0);
+        copy_tile_init(cb_in1);
+        copy_tile(cb_in1, 0, 1);
+        copy_tile_init(cb_in2);
+        copy_tile(cb_in2, 0, 2);
+
+        shoup_mul_mod_tile(0, 1, 2, 3, 4, 5, 6, 7, q);  // 0번 레지스터에 x * w mod q
+
+        tile_regs_commit();
+        tile_regs_wait();
+        cb_reserve_back(cb_out, 1);
+        pack_tile(0, cb_out);
+        cb_pop_front(cb_in0, 1);
+        cb_pop_front(cb_in1, 1);
+        cb_pop_front(cb_in2, 1);
+        cb_push_back(cb_out, 1);
+        tile_regs_release();
+    }
+}
+}  // namespace NAMESPACE
@@ -0,0 +1,40 @@
+#include <stdint.h>
+#include "dataflow_api.h"
+
+void kernel_main() {
+    uint32_t src_addr = get_arg_val<uint32_t>(0);
+    uint32_t twiddle_addr = get_arg_val<uint32_t>(1);
+    uint32_t shoup_addr = get_arg_val<uint32_t>(2);
+    uint32_t tiles_per_poly = get_arg_val<uint32_t>(3);
+    uint32_t start_tile_id = get_arg_val<uint32_t>(4);
+    uint32_t n_tiles = get_arg_val<uint32_t>(5);
+
+    constexpr uint32_t cb_id_in0 = tt::CBIndex::c_0;  // x
+    constexpr uint32_t cb_id_in1 = tt::CBIndex::c_1;  // psi^i
+    constexpr uint32_t cb_id_in2 = tt::CBIndex::c_2;  // Shoup(psi^i)
+
+    constexpr auto s0_args = TensorAccessorArgs<0>();
+    const auto s0 = TensorAccessor(s0_args, src_addr, get_tile_size(cb_id_in0));
+    constexpr auto s1_args = TensorAccessorArgs<s0_args.next_compile_time_args_offset()>();
+    const auto s1 = TensorAccessor(s1_args, twiddle_addr, get_tile_size(cb_id_in1));
+    constexpr auto s2_args = TensorAccessorArgs<s1_args.next_compile_time_args_offset()>();
+    const auto s2 = TensorAccessor(s2_args, shoup_addr, get_tile_size(cb_id_in2));
+
+    for (uint32_t i = start_tile_id; i < start_tile_id + n_tiles; i++) {
+        // twiddle table은 polynomial 하나 크기이므로 모든 polynomial이 같은 table을 공유한다.
+        uint32_t w_tile_id = i % tiles_per_poly;
+
+        cb_reserve_back(cb_id_in0, 1);
+        cb_reserve_back(cb_id_in1, 1);
+        cb_reserve_back(cb_id_in2, 1);
+
+        noc_async_read_tile(i, s0, get_write_ptr(cb_id_in0));
+        noc_async_read_tile(w_tile_id, s1, get_write_ptr(cb_id_in1));
+        noc_async_read_tile(w_tile_id, s2, get_write_ptr(cb_id_in2));
+        noc_async_read_barrier();
+
+        cb_push_back(cb_id_in0, 1);
+        cb_push_back(cb_id_in1, 1);
+        cb_push_back(cb_id_in2, 1);
+    }
+}
@@ -0,0 +1,222 @@
+#include <random>
+#include <tt-metalium/host_api.hpp>
+#include <tt-metalium/constants.hpp>
+#include <tt-metalium/tilize_utils.hpp>
+#include <tt-metalium/distributed.hpp>
+#include <tt-metalium/device.hpp>
+#include <tt-metalium/work_split.hpp>
+#include <tt-metalium/tensor_accessor_args.hpp>
+#include <mod_op.hpp>
+#include <twiddle_cache.hpp>
+#include <fmt/core.h>
+
+using namespace tt::constants;
+using namespace tt;
+using namespace std;
+using namespace tt::tt_metal;
+
+#ifndef OVERRIDE_KERNEL_PREFIX
+#define OVERRIDE_KERNEL_PREFIX ""
+#endif
+
+/**
+ * @brief Negacyclic pre-twist y_{p,i} = x_{p,i} * psi^i mod q of B polynomials (the first step of a negacyclic NTT).
+ *
+ * psi^i and its Shoup companion come from a TwiddleTableCache: they are uploaded once per (n, q) and stay
+ * resident in DRAM across calls, so only the input polynomials cross PCIe on a cache hit.
+ *
+ * @param x Input polynomials, tilized, B * n coefficients (uint32, < q)
+ * @param output Output polynomials, tilized, B * n coefficients
+ * @param B Number of polynomials
+ * @param n Coefficients per polynomial (multiple of 1024, 2n | q - 1)
+ * @param q Prime modulus, q < 2^29 (the SFPU reduction compares values below 3q as signed 32-bit integers)
+ */
+void ntt_twist(
+    std::vector<uint32_t>& x,
+    std::vector<uint32_t>& output,
+    uint32_t B,
+    uint32_t n,
+    uint32_t q,
+    mod_op_utils::TwiddleTableCache& cache,
+    const std::shared_ptr<distributed::MeshDevice>& mesh_device) {
+    TT_FATAL(n % TILE_HW == 0, "n = {} must be a multiple of TILE_HW = {}", n, TILE_HW);
+    TT_FATAL(q < (1u << 29), "Shoup SFPU path supports q < 2^29, got q = {}", q);
+
+    distributed::MeshCommandQueue& cq = mesh_device->mesh_command_queue();
+    distributed::MeshWorkload workload;
+    distributed::MeshCoordinateRange device_range = distributed::MeshCoordinateRange(mesh_device->shape());
+    Program program = CreateProgram();
+
+    // miss일 때만 host에서 table을 계산해서 올린다.
+    mod_op_utils::TwiddleTables tables = cache.get(n, q);
+
+    uint32_t tiles_per_poly = n / TILE_HW;
+    uint32_t total_tiles = B * tiles_per_poly;
+
+    auto core_grid = mesh_device->compute_with_storage_grid_size();
+    auto [num_cores, all_cores, core_group_1, core_group_2, work_per_core1, work_per_core2] =
+        split_work_to_cores(core_grid, total_tiles);
+
+    constexpr uint32_t tile_size_bytes = sizeof(uint32_t) * TILE_HW;
+    distributed::DeviceLocalBufferConfig dram_config{
+        .page_size = tile_size_bytes, .buffer_type = tt_metal::BufferType::DRAM};
+    distributed::ReplicatedBufferConfig buffer_config{.size = tile_size_bytes * total_tiles};
+
+    auto src_dram_buffer = distributed::MeshBuffer::create(buffer_config, dram_config, mesh_device.get());
+    auto dst_dram_buffer = distributed::MeshBuffer::create(buffer_config, dram_config, mesh_device.get());
+
+    constexpr uint32_t num_input_tiles = 2;
+    for (uint32_t cb_index :
+         {(uint32_t)CBIndex::c_0, (uint32_t)CBIndex::c_1, (uint32_t)CBIndex::c_2, (uint32_t)CBIndex::c_16}) {
+        tt_metal::CreateCircularBuffer(
+            program,
+            all_cores,
+            CircularBufferConfig(num_input_tiles * tile_size_bytes, {{cb_index, tt::DataFormat::UInt32}})
+                .set_page_size(cb_index, tile_size_bytes));
+    }
+
+    std::vector<uint32_t> reader_compile_time_args;
+    TensorAccessorArgs(*src_dram_buffer).append_to(reader_compile_time_args);
+    TensorAccessorArgs(*tables.twiddle).append_to(reader_compile_time_args);
+    TensorAccessorArgs(*tables.shoup).append_to(reader_compile_time_args);
+    KernelHandle reader_id = CreateKernel(
+        program,
+        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/ntt_twiddle_cache/kernels/reader.cpp",
+        all_cores,
+        DataMovementConfig{
+            .processor = DataMovementProcessor::RISCV_1,
+            .noc = NOC::RISCV_1_default,
+            .compile_args = reader_compile_time_args});
+
+    std::vector<uint32_t> writer_compile_time_args;
+    TensorAccessorArgs(*dst_dram_buffer).append_to(writer_compile_time_args);
+    KernelHandle writer_id = CreateKernel(
+        program,
+        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/ntt_twiddle_cache/kernels/writer.cpp",
+        all_cores,
+        DataMovementConfig{
+            .processor = DataMovementProcessor::RISCV_0,
+            .noc = NOC::RISCV_0_default,
+            .compile_args = writer_compile_time_args});
+
+    // Shoup mul은 32-bit dst tile 8개를 쓰므로 fp32 dest + full sync 가 필요하다.
+    KernelHandle compute_id = CreateKernel(
+        program,
+        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/ntt_twiddle_cache/kernels/compute.cpp",
+        all_cores,
+        ComputeConfig{
+            .math_fidelity = MathFidelity::HiFi4,
+            .fp32_dest_acc_en = true,
+            .dst_full_sync_en = true,
+            .math_approx_mode = false});
+
+    uint32_t work_offset = 0;
+    auto work_groups = {std::make_pair(core_group_1, work_per_core1), std::make_pair(core_group_2, work_per_core2)};
+    for (const auto& [ranges, work_per_core] : work_groups) {
+        for (const auto& range : ranges.ranges()) {
+            for (const auto& core : range) {
+                SetRuntimeArgs(
+                    program,
+                    reader_id,
+                    core,
+                    {src_dram_buffer->address(),
+                     tables.twiddle->address(),
+                     tables.shoup->address(),
+                     tiles_per_poly,
+                     work_offset,
+                     work_per_core});
+                SetRuntimeArgs(program, writer_id, core, {dst_dram_buffer->address(), work_offset, work_per_core});
+                SetRuntimeArgs(program, compute_id, core, {work_per_core, q});
+                work_offset += work_per_core;
+            }
+        }
+    }
+
+    distributed::EnqueueWriteMeshBuffer(cq, src_dram_buffer, x, false);
+    workload.add_program(device_range, std::move(program));
+    distributed::EnqueueMeshWorkload(cq, workload, false);
+    distributed::EnqueueReadMeshBuffer(cq, output, dst_dram_buffer, true);
+}
+
+int main() {
+    bool pass = true;
+
+    constexpr int device_id = 0;
+    std::shared_ptr<distributed::MeshDevice> mesh_device = distributed::MeshDevice::create_unit_mesh(device_id);
+
+    constexpr uint32_t B = 16;           // number of polynomials per call (user-defined)
+    constexpr uint32_t iterations = 4;   // calls per parameter set (user-defined)
+
+    // 2n | q - 1 인 NTT-friendly prime 들
+    const std::vector<std::pair<uint32_t, uint32_t>> param_sets = {
+        {4096, 8650753},  // 33 * 2^18 + 1
+        {2048, 7340033},  // 7 * 2^20 + 1
+        {4096, 5767169},  // 11 * 2^19 + 1
+    };
+
+    // 일부러 세 parameter set의 table이 다 들어가지 않는 크기로 잡아서 eviction도 확인한다.
+    constexpr uint64_t budget_bytes = 64 * 1024;
+    mod_op_utils::TwiddleTableCache cache(mesh_device, budget_bytes);
+
+    std::random_device rd;
+    std::mt19937 engine(rd());
+
+    for (const auto& [n, q] : param_sets) {
+        for (uint32_t it = 0; it < iterations && pass; it++) {
+            std::uniform_int_distribution<std::uint32_t> dist(0, q - 1);
+            std::vector<uint32_t> src_vec(B * n);
+            for (uint32_t& v : src_vec) {
+                v = dist(engine);
+            }
+
+            uint32_t psi = mod_op_utils::find_primitive_root_2n(n, q);
+            std::vector<uint32_t> golden(B * n);
+            for (uint32_t p = 0; p < B; p++) {
+                uint32_t w = 1;
+                for (uint32_t i = 0; i < n; i++) {
+                    golden.at(p * n + i) = mod_op_utils::mul_mod(src_vec.at(p * n + i), w, q);
+                    w = mod_op_utils::mul_mod(w, psi, q);
+                }
+            }
+
+            src_vec = tilize_nfaces(src_vec, B * n / TILE_WIDTH, TILE_WIDTH);
+            std::vector<uint32_t> result_vec(B * n);
+            ntt_twist(src_vec, result_vec, B, n, q, cache, mesh_device);
+            result_vec = untilize_nfaces(result_vec, B * n / TILE_WIDTH, TILE_WIDTH);
+
+            for (uint32_t i = 0; i < B * n; i++) {
+                if (golden.at(i) != result_vec.at(i)) {
+                    fmt::print(
+                        "(n = {}, q = {}) golden and result unmatch at {}, golden = {}, result = {}\n",
+                        n,
+                        q,
+                        i,
+                        golden.at(i),
+                        result_vec.at(i));
+                    pass = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    fmt::print(
+        " -- twiddle cache: hits= {} -- misses= {} -- evictions= {} -- resident= {} / {} bytes --\n",
+        cache.hits(),
+        cache.misses(),
+        cache.evictions(),
+        cache.resident_bytes(),
+        budget_bytes);
+
+    // MeshBuffer들은 device를 닫기 전에 해제한다.
+    cache.clear();
+    pass &= mesh_device->close();
+
+    if (pass) {
+        fmt::print("Test Passed!! ---- ntt_twiddle_cache\n");
+    } else {
+        TT_THROW("Test Failed!!");
+    }
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include <cstdint>
+#include "compute_kernel_api/tile_move_copy.h"
+#include "../../modular_common/kernels/mod_sfpu.h"
+
+/*
+    w^i mod q, i = 1024 * t + j (t: tile, j: tile 안의 위치) 를 생성한다.
+    1. 한 번만: L = w^j (lane 별 exponent bit로 w^(2^k) 를 골라 곱함), C = w^1024
+    2. tile 마다: w^(1024 t) = pow_mod_tile(C, t), 결과 = w^(1024 t) * L
+*/
+namespace NAMESPACE {
+void MAIN {
+    constexpr uint32_t q_bits = get_compile_time_arg_val(0);
+
+    uint32_t start_tile_id = get_arg_val<uint32_t>(0);
+    uint32_t n_tiles = get_arg_val<uint32_t>(1);
+    uint32_t w = get_arg_val<uint32_t>(2);
+    uint32_t q = get_arg_val<uint32_t>(3);
+    uint32_t mu = get_arg_val<uint32_t>(4);
+
+    tt::CBIndex cb_exp = tt::CBIndex::c_1;
+    tt::CBIndex cb_lane = tt::CBIndex::c_24;  // L = w^j
+    tt::CBIndex cb_base = tt::CBIndex::c_25;  // C = w^1024
+    tt::CBIndex cb_out = tt::CBIndex::c_16;
+
+    init_sfpu(cb_exp, cb_out);
+
+    // dst register 0: L, 1: C, 2: 곱할 값, 3 ~ 6, 7: scratch
+    tile_regs_acquire();
+    cb_wait_front(cb_exp, 1);
+    mod_fill_tile(0, 1);
+    mod_fill_tile(1, w);
+    for (uint32_t k = 0; k < 10; k++) {
+        copy_tile_init(cb_exp);
+        copy_tile(cb_exp, 0, 2);
+        mod_select_bit_tile(2, 1, 1u << k);                          // 2 = bit k of j ? w^(2^k) : 1
+        barrett_mul_mod_tile<q_bits>(0, 2, 3, 4, 5, 6, 7, q, mu);  // L *= 2
+
+        mod_copy_tile(1, 2);
+        barrett_mul_mod_tile<q_bits>(1, 2, 3, 4, 5, 6, 7, q, mu);  // C = C^2
+    }
+    tile_regs_commit();
+    tile_regs_wait();
+    cb_reserve_back(cb_lane, 1);
+    cb_reserve_back(cb_base, 1);
+    pack_tile(0, cb_lane);
+    pack_tile(1, cb_base);
+    cb_push_back(cb_lane, 1);
+    cb_push_back(cb_base, 1);
+    cb_pop_front(cb_exp, 1);
+    tile_regs_release();
+
+    cb_wait_front(cb_lane, 1);
+    cb_wait_front(cb_base, 1);
+    for (uint32_t t = start_tile_id; t < start_tile_id + n_tiles; t++) {
+        tile_regs_acquire();
+
+        // dst register 0: C, 1: 결과, 2 ~ 7: scratch
+        copy_tile_init(cb_base);
+        copy_tile(cb_base, 0, 0);
+        pow_mod_tile<q_bits>(0, 1, 2, 3, 4, 5, 6, 7, t, q, mu);  // 1 = w^(1024 t)
+
+        copy_tile_init(cb_lane);
+        copy_tile(cb_lane, 0, 0);
+        barrett_mul_mod_tile<q_bits>(1, 0, 2, 3, 4, 5, 6, q, mu);  // 1 = w^(1024 t + j)
+
+        tile_regs_commit();
+        tile_regs_wait();
+        cb_reserve_back(cb_out, 1);
+        pack_tile(1, cb_out);
+        cb_push_back(cb_out, 1);
+        tile_regs_release();
+    }
+    cb_pop_front(cb_lane, 1);
+    cb_pop_front(cb_base, 1);
+}
+}  // namespace NAMESPACE
@@ -0,0 +1,24 @@
+#include <stdint.h>
+#include "dataflow_api.h"
+
+/*
+    DRAM에서 읽을 입력은 없고, tile 안의 위치 j (0 ~ 1023)를 담은 exponent tile 하나를 L1에 직접 만든다.
+    host의 tilize_nfaces 와 같은 layout: face f (16x16, row-major), f = (r / 16) * 2 + c / 16
+    (r, c) 위치의 coefficient index는 tile t 안에서 1024 * t + 32 * r + c 이다.
+*/
+void kernel_main() {
+    constexpr uint32_t cb_id_exp = tt::CBIndex::c_1;
+
+    cb_reserve_back(cb_id_exp, 1);
+    volatile tt_l1_ptr uint32_t* ptr = reinterpret_cast<volatile tt_l1_ptr uint32_t*>(get_write_ptr(cb_id_exp));
+    for (uint32_t f = 0; f < 4; f++) {
+        for (uint32_t fr = 0; fr < 16; fr++) {
+            for (uint32_t fc = 0; fc < 16; fc++) {
+                uint32_t r = (f / 2) * 16 + fr;
+                uint32_t c = (f % 2) * 16 + fc;
+                ptr[f * 256 + fr * 16 + fc] = r * 32 + c;
+            }
+        }
+    }
+    cb_push_back(cb_id_exp, 1);
+}
@@ -0,0 +1,20 @@
+#include <cstdint>
+
+void kernel_main() {
+    uint32_t c_addr = get_arg_val<uint32_t>(0);
+    uint32_t start_tile_id = get_arg_val<uint32_t>(1);
+    uint32_t n_tiles = get_arg_val<uint32_t>(2);
+
+    constexpr uint32_t cb_out0 = tt::CBIndex::c_16;
+    const uint32_t tile_size_bytes = get_tile_size(cb_out0);
+
+    constexpr auto out0_args = TensorAccessorArgs<0>();
+    const auto out0 = TensorAccessor(out0_args, c_addr, tile_size_bytes);
+
+    for (uint32_t i = start_tile_id; i < start_tile_id + n_tiles; i++) {
+        cb_wait_front(cb_out0, 1);
+        noc_async_write_tile(i, out0, get_read_ptr(cb_out0));
+        noc_async_write_barrier();
+        cb_pop_front(cb_out0, 1);
+    }
+}
@@ -0,0 +1,181 @@
+#include <chrono>
+#include <tt-metalium/host_api.hpp>
+#include <tt-metalium/constants.hpp>
+#include <tt-metalium/tilize_utils.hpp>
+#include <tt-metalium/distributed.hpp>
+#include <tt-metalium/device.hpp>
+#include <tt-metalium/work_split.hpp>
+#include <tt-metalium/tensor_accessor_args.hpp>
+#include <mod_op.hpp>
+#include <fmt/core.h>
+
+using namespace tt::constants;
+using namespace tt;
+using namespace std;
+using namespace tt::tt_metal;
+
+#ifndef OVERRIDE_KERNEL_PREFIX
+#define OVERRIDE_KERNEL_PREFIX ""
+#endif
+
+/**
+ * @brief Generates the twiddle table w^i mod q, i = 0 .. n - 1, on device.
+ *
+ * Only w, q and the Barrett constant cross PCIe; every power is computed with SFPU Barrett multiplies
+ * (see pow_mod_tile in mod_sfpu.h). Output tiles are split across cores with split_work_to_cores.
+ *
+ * @param output Twiddle table, tilized as (n / 32) x 32
+ * @param n Table length (multiple of 1024)
+ * @param w Root of unity (any value < q)
+ * @param q Modulus, 2^15 <= q < 2^29
+ */
+void ntt_twiddle_gen(
+    std::vector<uint32_t>& output,
+    uint32_t n,
+    uint32_t w,
+    uint32_t q,
+    const std::shared_ptr<distributed::MeshDevice>& mesh_device) {
+    TT_FATAL(n % TILE_HW == 0, "n = {} must be a multiple of TILE_HW = {}", n, TILE_HW);
+
+    distributed::MeshCommandQueue& cq = mesh_device->mesh_command_queue();
+    distributed::MeshWorkload workload;
+    distributed::MeshCoordinateRange device_range = distributed::MeshCoordinateRange(mesh_device->shape());
+    Program program = CreateProgram();
+
+    auto barrett = mod_op_utils::get_barrett_params(q);
+
+    uint32_t total_tiles = n / TILE_HW;
+    auto core_grid = mesh_device->compute_with_storage_grid_size();
+    auto [num_cores, all_cores, core_group_1, core_group_2, work_per_core1, work_per_core2] =
+        split_work_to_cores(core_grid, total_tiles);
+
+    constexpr uint32_t tile_size_bytes = sizeof(uint32_t) * TILE_HW;
+    distributed::DeviceLocalBufferConfig dram_config{
+        .page_size = tile_size_bytes, .buffer_type = tt_metal::BufferType::DRAM};
+    distributed::ReplicatedBufferConfig buffer_config{.size = tile_size_bytes * total_tiles};
+    auto dst_dram_buffer = distributed::MeshBuffer::create(buffer_config, dram_config, mesh_device.get());
+
+    // c_1: exponent tile, c_24 / c_25: compute kernel이 한 번 만들어 두고 계속 읽는 L, C tile
+    for (uint32_t cb_index : {(uint32_t)CBIndex::c_1, (uint32_t)CBIndex::c_24, (uint32_t)CBIndex::c_25}) {
+        tt_metal::CreateCircularBuffer(
+            program,
+            all_cores,
+            CircularBufferConfig(tile_size_bytes, {{cb_index, tt::DataFormat::UInt32}})
+                .set_page_size(cb_index, tile_size_bytes));
+    }
+    constexpr uint32_t num_output_tiles = 2;
+    tt_metal::CreateCircularBuffer(
+        program,
+        all_cores,
+        CircularBufferConfig(num_output_tiles * tile_size_bytes, {{CBIndex::c_16, tt::DataFormat::UInt32}})
+            .set_page_size(CBIndex::c_16, tile_size_bytes));
+
+    KernelHandle reader_id = CreateKernel(
+        program,
+        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/ntt_twiddle_gen/kernels/reader.cpp",
+        all_cores,
+        DataMovementConfig{.processor = DataMovementProcessor::RISCV_1, .noc = NOC::RISCV_1_default});
+
+    std::vector<uint32_t> writer_compile_time_args;
+    TensorAccessorArgs(*dst_dram_buffer).append_to(writer_compile_time_args);
+    KernelHandle writer_id = CreateKernel(
+        program,
+        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/ntt_twiddle_gen/kernels/writer.cpp",
+        all_cores,
+        DataMovementConfig{
+            .processor = DataMovementProcessor::RISCV_0,
+            .noc = NOC::RISCV_0_default,
+            .compile_args = writer_compile_time_args});
+
+    // pow_mod_tile은 32-bit dst tile 8개를 쓰므로 fp32 dest + full sync 가 필요하다.
+    KernelHandle compute_id = CreateKernel(
+        program,
+        OVERRIDE_KERNEL_PREFIX "/home/southbell/tt-example/src/ntt_twiddle_gen/kernels/compute.cpp",
+        all_cores,
+        ComputeConfig{
+            .math_fidelity = MathFidelity::HiFi4,
+            .fp32_dest_acc_en = true,
+            .dst_full_sync_en = true,
+            .math_approx_mode = false,
+            .compile_args = {barrett.q_bits}});
+
+    uint32_t work_offset = 0;
+    auto work_groups = {std::make_pair(core_group_1, work_per_core1), std::make_pair(core_group_2, work_per_core2)};
+    for (const auto& [ranges, work_per_core] : work_groups) {
+        for (const auto& range : ranges.ranges()) {
+            for (const auto& core : range) {
+                SetRuntimeArgs(program, reader_id, core, {});
+                SetRuntimeArgs(program, writer_id, core, {dst_dram_buffer->address(), work_offset, work_per_core});
+                SetRuntimeArgs(
+                    program, compute_id, core, {work_offset, work_per_core, w, barrett.q, barrett.mu});
+                work_offset += work_per_core;
+            }
+        }
+    }
+
+    workload.add_program(device_range, std::move(program));
+
+    // 첫 launch는 kernel compile 시간이 포함되므로 한 번 먼저 돌린다.
+    distributed::EnqueueMeshWorkload(cq, workload, false);
+    distributed::Finish(cq);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    distributed::EnqueueMeshWorkload(cq, workload, false);
+    distributed::Finish(cq);
+    auto end = std::chrono::high_resolution_clock::now();
+    fmt::print(
+        " -- device twiddle generation (n = {}, {} cores): {} us --\n",
+        n,
+        num_cores,
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+
+    distributed::EnqueueReadMeshBuffer(cq, output, dst_dram_buffer, true);
+}
+
+int main() {
+    bool pass = true;
+
+    constexpr int device_id = 0;
+    std::shared_ptr<distributed::MeshDevice> mesh_device = distributed::MeshDevice::create_unit_mesh(device_id);
+
+    constexpr uint32_t n = 65536;    // table length (user-defined)
+    constexpr uint32_t q = 7340033;  // 7 * 2^20 + 1, 2n | q - 1
+
+    uint32_t psi = mod_op_utils::find_primitive_root_2n(n, q);
+    fmt::print(" -- n= {} -- q= {} -- psi= {} --\n", n, q, psi);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<uint32_t> golden(n);
+    uint32_t w = 1;
+    for (uint32_t i = 0; i < n; i++) {
+        golden.at(i) = w;
+        w = mod_op_utils::mul_mod(w, psi, q);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    fmt::print(
+        " -- host twiddle generation: {} us --\n",
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+
+    std::vector<uint32_t> result_vec(n);
+    ntt_twiddle_gen(result_vec, n, psi, q, mesh_device);
+    result_vec = untilize_nfaces(result_vec, n / TILE_WIDTH, TILE_WIDTH);
+
+    // 검증
+    for (uint32_t i = 0; i < n; i++) {
+        if (golden.at(i) != result_vec.at(i)) {
+            fmt::print("golden and result unmatch at {}, golden = {}, result = {}\n", i, golden.at(i), result_vec.at(i));
+            pass = false;
+            break;
+        }
+    }
+
+    pass &= mesh_device->close();
+
+    if (pass) {
+        fmt::print("Test Passed!! ---- ntt_twiddle_gen\n");
+    } else {
+        TT_THROW("Test Failed!!");
+    }
+
+    return 0;
+}